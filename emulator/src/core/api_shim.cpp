@@ -7,6 +7,7 @@
 #include <cmath>
 
 ApiState ApiShim::state_;
+float ApiShim::sample_rate_ = 48000.0f;  // Updated to 48kHz for compatibility
 
 // NT_screen buffer as per API specification - definition (not declaration)
 uint8_t NT_screen[128 * 64];
@@ -378,7 +379,11 @@ void ApiShim::sendMIDINoteOff(struct _NT_noteOff* noteOff, enum _NT_midiDestinat
 }
 
 float ApiShim::getSampleRate() {
-    return 48000.0f;  // Updated to 48kHz for compatibility
+    return sample_rate_;
+}
+
+void ApiShim::setSampleRate(float sample_rate) {
+    sample_rate_ = sample_rate;
 }
 
 unsigned int ApiShim::getSamplesPerBlock() {
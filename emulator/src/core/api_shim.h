@@ -118,6 +118,7 @@ public:
     
     // Utility functions
     static float getSampleRate();
+    static void setSampleRate(float sample_rate);
     static unsigned int getSamplesPerBlock();
     static void log(const char* text);
     static unsigned int random(unsigned int max);
@@ -125,6 +126,7 @@ public:
     
 private:
     static ApiState state_;
+    static float sample_rate_;
     
     static void drawChar(int x, int y, char c, _NT_textSize size, int colour);
     static int getCharWidth(char c, _NT_textSize size);
@@ -253,6 +253,18 @@ int AudioEngine::audioCallback(const void* inputBuffer, void* outputBuffer,
     return paContinue;
 }
 
+void AudioEngine::requestSwap(_NT_factory* factory, _NT_algorithm* algorithm) {
+    if (!isRunning()) {
+        factory_ = factory;
+        algorithm_ = algorithm;
+        swap_pending_.store(false, std::memory_order_release);
+        return;
+    }
+    pending_factory_ = factory;
+    pending_algorithm_ = algorithm;
+    swap_pending_.store(true, std::memory_order_release);
+}
+
 void AudioEngine::processAudio(const float* input, float* output, unsigned long frames) {
     // Clear output buffer
     std::fill(output, output + frames * output_channel_count_, 0.0f);
@@ -264,6 +276,12 @@ void AudioEngine::processAudio(const float* input, float* output, unsigned long
     
     // Process audio in blocks of SAMPLES_PER_BLOCK
     for (unsigned long frame = 0; frame < frames; frame += SAMPLES_PER_BLOCK) {
+        if (swap_pending_.load(std::memory_order_acquire)) {
+            factory_ = pending_factory_;
+            algorithm_ = pending_algorithm_;
+            swap_pending_.store(false, std::memory_order_release);
+        }
+        
         unsigned long samples_to_process = std::min(static_cast<unsigned long>(SAMPLES_PER_BLOCK), frames - frame);
         
         // Clear all buses
@@ -294,6 +312,7 @@ void AudioEngine::processAudio(const float* input, float* output, unsigned long
             if (factory_ && factory_->step) {
                 // API expects numFramesBy4; our block is always 4 samples.
                 factory_->step(algorithm_, flat_bus_buffer.data(), 1);
+                block_count_.fetch_add(1, std::memory_order_relaxed);
                 
                 // Copy processed data back from flat buffer to plugin_buses
                 for (int i = 0; i < NUM_BUSES; i++) {
@@ -3,6 +3,7 @@
 #include <portaudio.h>
 #include <distingnt/api.h>
 #include <array>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <cmath>
@@ -27,11 +28,20 @@ public:
     
     bool isRunning() const { return stream_ != nullptr && !Pa_IsStreamStopped(stream_); }
     
-    void setAlgorithm(_NT_algorithm* algorithm) { algorithm_ = algorithm; }
+    void setAlgorithm(_NT_algorithm* algorithm) {
+        algorithm_ = algorithm;
+        swap_pending_.store(false, std::memory_order_release);
+    }
     void setFactory(_NT_factory* factory) { factory_ = factory; }
     _NT_algorithm* getAlgorithm() const { return algorithm_; }
     _NT_factory* getFactory() const { return factory_; }
     
+    // Hot swap: the callback switches to the new pair at its next 4-frame
+    // block boundary. Until isSwapPending() goes false the previous
+    // algorithm may still be running and must stay loaded.
+    void requestSwap(_NT_factory* factory, _NT_algorithm* algorithm);
+    bool isSwapPending() const { return swap_pending_.load(std::memory_order_acquire); }
+    
     // Device configuration
     bool configureDevices(const AudioConfiguration& config);
     AudioConfiguration getCurrentConfiguration() const { return current_config_; }
@@ -48,6 +58,8 @@ public:
     // Monitoring
     float getCpuLoad() const;
     double getStreamTime() const;
+    // Plugin step() calls so far, for lining display frames up with audio
+    uint64_t getBlockCount() const { return block_count_.load(std::memory_order_relaxed); }
     
     std::string getLastError() const { return last_error_; }
     
@@ -55,6 +67,10 @@ private:
     PaStream* stream_ = nullptr;
     _NT_algorithm* algorithm_ = nullptr;
     _NT_factory* factory_ = nullptr;
+    _NT_factory* pending_factory_ = nullptr;
+    _NT_algorithm* pending_algorithm_ = nullptr;
+    std::atomic<bool> swap_pending_{false};
+    std::atomic<uint64_t> block_count_{0};
     
     // Configuration state
     AudioConfiguration current_config_;
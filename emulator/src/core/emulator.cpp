@@ -1,4 +1,5 @@
 #include "emulator.h"
+#include <chrono>
 #include <iostream>
 
 Emulator::Emulator() {
@@ -58,6 +59,10 @@ void Emulator::shutdown() {
     
     stopAudio();
     unloadPlugin();
+    stopDisplayRecording();
+    
+    // The GL context is destroyed after us
+    display_->releaseTexture();
     
     // Save configuration before shutdown
     if (config_ && audio_engine_) {
@@ -102,6 +107,9 @@ bool Emulator::loadPlugin(const std::string& path) {
         
         std::cout << "Plugin loaded: " << path << std::endl;
         
+        plugin_changed_ = false;
+        file_watcher_.watchFile(path, [this]() { plugin_changed_ = true; });
+        
         // Restart audio if it was running
         if (was_running) {
             startAudio();
@@ -121,7 +129,10 @@ void Emulator::unloadPlugin() {
         audio_engine_->setFactory(nullptr);
         ApiShim::setAlgorithm(nullptr);
         
+        file_watcher_.stopWatching();
         plugin_loader_->unloadPlugin();
+        hot_swap_requested_ = false;
+        plugin_changed_ = false;
         
         // Clear display
         display_->clear();
@@ -166,6 +177,7 @@ void Emulator::update() {
     updateDisplayInternal();
     
     // Check for hot reload
+    file_watcher_.update();
     checkForReload();
 }
 
@@ -178,22 +190,35 @@ void Emulator::render() {
 }
 
 void Emulator::checkForReload() {
-    if (plugin_loader_ && plugin_loader_->needsReload()) {
-        std::cout << "Plugin file changed, reloading..." << std::endl;
-        
-        std::string path = plugin_loader_->getPath();
-        bool was_running = isAudioRunning();
-        
-        unloadPlugin();
-        
-        if (loadPlugin(path)) {
-            std::cout << "Plugin reloaded successfully" << std::endl;
-            if (was_running) {
-                startAudio();
-            }
-        } else {
-            std::cerr << "Failed to reload plugin" << std::endl;
-        }
+    if (!plugin_loader_) return;
+    
+    // Phase 1: build the changed plugin in the background while the old one plays
+    // A change during a swap is picked up once the swap completes
+    if (plugin_changed_ && plugin_loader_->beginBackgroundReload()) {
+        plugin_changed_ = false;
+        std::cout << "Plugin file changed, preparing hot swap..." << std::endl;
+        return;
+    }
+    
+    if (plugin_loader_->isReloadFailed()) {
+        std::cerr << "Failed to reload plugin, keeping the running build" << std::endl;
+        plugin_loader_->abandonReload();
+        return;
+    }
+    
+    // Phase 2: switch the audio callback at a block boundary
+    if (plugin_loader_->isReloadReady() && !hot_swap_requested_) {
+        const PluginInstance& staged = plugin_loader_->getStagedPlugin();
+        audio_engine_->requestSwap(staged.factory, staged.algorithm);
+        hot_swap_requested_ = true;
+    }
+    
+    // Phase 3: the old build is no longer referenced by the callback
+    if (hot_swap_requested_ && !audio_engine_->isSwapPending()) {
+        plugin_loader_->completeReload();
+        ApiShim::setAlgorithm(plugin_loader_->getAlgorithm());
+        hot_swap_requested_ = false;
+        std::cout << "Plugin hot-swapped" << std::endl;
     }
 }
 
@@ -219,6 +244,10 @@ AudioEngine* Emulator::getAudioEngine() const {
     return audio_engine_.get();
 }
 
+Display* Emulator::getDisplay() const {
+    return display_.get();
+}
+
 Config* Emulator::getConfig() const {
     return config_.get();
 }
@@ -274,7 +303,35 @@ void Emulator::updateDisplayInternal() {
         display_->updateFromApiState();
     } catch (...) {
         std::cerr << "Plugin draw error" << std::endl;
+        return;
+    }
+    
+    if (display_recorder_.isOpen()) {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        uint64_t timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+        uint64_t block = audio_engine_ ? audio_engine_->getBlockCount() : 0;
+        if (!display_recorder_.record(display_->getBuffer().pixels.data(), timestamp_us, block)) {
+            std::cerr << "Display recording failed, stopping: " << display_recorder_.getPath() << std::endl;
+            stopDisplayRecording();
+        }
+    }
+}
+
+bool Emulator::startDisplayRecording(const std::string& path, std::string& error) {
+    if (!display_recorder_.open(path, error)) {
+        return false;
     }
+    std::cout << "Recording display to " << path << std::endl;
+    return true;
+}
+
+void Emulator::stopDisplayRecording() {
+    if (!display_recorder_.isOpen()) return;
+    
+    const FrameRecorder::Stats& stats = display_recorder_.getStats();
+    std::cout << "Display recording stopped: " << stats.frames << " frames ("
+              << stats.unchanged << " unchanged skipped), " << stats.bytes << " bytes" << std::endl;
+    display_recorder_.close();
 }
 
 void Emulator::onParameterChange(int parameter, float value) {
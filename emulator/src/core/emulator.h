@@ -3,9 +3,11 @@
 #include "plugin_loader.h"
 #include "audio_engine.h"
 #include "api_shim.h"
+#include "../utils/file_watcher.h"
 #include "../hardware/display.h"
 #include "../hardware/hardware_interface.h"
 #include "../utils/config.h"
+#include "../utils/frame_recording.h"
 #include <memory>
 #include <string>
 
@@ -37,6 +39,13 @@ public:
     // Hot reload
     void checkForReload();
     
+    // Display recording: every drawn frame that differs from the last one
+    // is appended to `path` (replay with DistingNTReplay)
+    bool startDisplayRecording(const std::string& path, std::string& error);
+    void stopDisplayRecording();
+    bool isRecordingDisplay() const { return display_recorder_.isOpen(); }
+    const FrameRecorder& getDisplayRecorder() const { return display_recorder_; }
+    
     // Status information
     std::string getPluginPath() const;
     float getAudioCpuLoad() const;
@@ -44,6 +53,7 @@ public:
     // Component access
     std::shared_ptr<HardwareInterface> getHardwareInterface() const;
     AudioEngine* getAudioEngine() const;
+    Display* getDisplay() const;
     Config* getConfig() const;
     
     // Hardware event handlers (public for GUI access)
@@ -59,6 +69,13 @@ private:
     std::unique_ptr<Config> config_;
     
     bool initialized_ = false;
+    bool hot_swap_requested_ = false;
+    
+    // Watches the plugin binary; set from update() when it has been rebuilt
+    FileWatcher file_watcher_;
+    bool plugin_changed_ = false;
+    
+    FrameRecorder display_recorder_;
     
     void setupCallbacks();
     void updateDisplayInternal();
@@ -68,6 +68,9 @@ bool EmulatorConsole::loadPlugin(const std::string& path) {
         
         std::cout << "Plugin loaded: " << path << std::endl;
         
+        plugin_changed_ = false;
+        file_watcher_.watchFile(path, [this]() { plugin_changed_ = true; });
+        
         // Restart audio if it was running
         if (was_running) {
             startAudio();
@@ -87,7 +90,10 @@ void EmulatorConsole::unloadPlugin() {
         audio_engine_->setFactory(nullptr);
         ApiShim::setAlgorithm(nullptr);
         
+        file_watcher_.stopWatching();
         plugin_loader_->unloadPlugin();
+        hot_swap_requested_ = false;
+        plugin_changed_ = false;
         
         std::cout << "Plugin unloaded" << std::endl;
     }
@@ -126,26 +132,40 @@ void EmulatorConsole::update() {
     updateDisplay();
     
     // Check for hot reload
+    file_watcher_.update();
     checkForReload();
 }
 
 void EmulatorConsole::checkForReload() {
-    if (plugin_loader_ && plugin_loader_->needsReload()) {
-        std::cout << "Plugin file changed, reloading..." << std::endl;
-        
-        std::string path = plugin_loader_->getPath();
-        bool was_running = isAudioRunning();
-        
-        unloadPlugin();
-        
-        if (loadPlugin(path)) {
-            std::cout << "Plugin reloaded successfully" << std::endl;
-            if (was_running) {
-                startAudio();
-            }
-        } else {
-            std::cerr << "Failed to reload plugin" << std::endl;
-        }
+    if (!plugin_loader_) return;
+    
+    // Phase 1: build the changed plugin in the background while the old one plays
+    // A change during a swap is picked up once the swap completes
+    if (plugin_changed_ && plugin_loader_->beginBackgroundReload()) {
+        plugin_changed_ = false;
+        std::cout << "Plugin file changed, preparing hot swap..." << std::endl;
+        return;
+    }
+    
+    if (plugin_loader_->isReloadFailed()) {
+        std::cerr << "Failed to reload plugin, keeping the running build" << std::endl;
+        plugin_loader_->abandonReload();
+        return;
+    }
+    
+    // Phase 2: switch the audio callback at a block boundary
+    if (plugin_loader_->isReloadReady() && !hot_swap_requested_) {
+        const PluginInstance& staged = plugin_loader_->getStagedPlugin();
+        audio_engine_->requestSwap(staged.factory, staged.algorithm);
+        hot_swap_requested_ = true;
+    }
+    
+    // Phase 3: the old build is no longer referenced by the callback
+    if (hot_swap_requested_ && !audio_engine_->isSwapPending()) {
+        plugin_loader_->completeReload();
+        ApiShim::setAlgorithm(plugin_loader_->getAlgorithm());
+        hot_swap_requested_ = false;
+        std::cout << "Plugin hot-swapped" << std::endl;
     }
 }
 
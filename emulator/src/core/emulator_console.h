@@ -3,6 +3,7 @@
 #include "plugin_loader.h"
 #include "audio_engine.h"
 #include "api_shim.h"
+#include "../utils/file_watcher.h"
 #include <memory>
 #include <string>
 
@@ -44,6 +45,11 @@ private:
     std::unique_ptr<AudioEngine> audio_engine_;
     
     bool initialized_ = false;
+    bool hot_swap_requested_ = false;
+    
+    // Watches the plugin binary; set from update() when it has been rebuilt
+    FileWatcher file_watcher_;
+    bool plugin_changed_ = false;
     
     void updateDisplay();
     void onParameterChange(int parameter, float value);
@@ -0,0 +1,405 @@
+#include "offline_renderer.h"
+#include "api_shim.h"
+#include "../utils/wav_file.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    const int NUM_BUSES = 28;
+    const int NUM_INPUT_BUSES = 12;
+    const int MAX_BLOCK_SIZE = 512;
+    const float DEFAULT_SAMPLE_RATE = 48000.0f;
+
+    bool parseTime(const std::string& text, float sample_rate, uint64_t& frame) {
+        char* end = nullptr;
+        double value = std::strtod(text.c_str(), &end);
+        std::string suffix(end);
+        if (end == text.c_str() || value < 0.0) return false;
+
+        if (suffix.empty()) {
+            frame = (uint64_t)value;
+        } else if (suffix == "s") {
+            frame = (uint64_t)std::llround(value * sample_rate);
+        } else if (suffix == "ms") {
+            frame = (uint64_t)std::llround(value * 0.001 * sample_rate);
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    // Accepts decimal or 0x-prefixed hex
+    bool parseByte(const std::string& text, uint8_t& byte) {
+        char* end = nullptr;
+        long value = std::strtol(text.c_str(), &end, 0);
+        if (end == text.c_str() || *end != '\0' || value < 0 || value > 255) return false;
+        byte = (uint8_t)value;
+        return true;
+    }
+
+    // "13,14,15" -> 0-based bus indices
+    bool parseBusList(const std::string& text, std::vector<int>& buses) {
+        std::istringstream iss(text);
+        std::string item;
+        while (std::getline(iss, item, ',')) {
+            int bus = std::atoi(item.c_str());
+            if (bus < 1 || bus > NUM_BUSES) return false;
+            buses.push_back(bus - 1);
+        }
+        return !buses.empty();
+    }
+}
+
+OfflineRenderer::OfflineRenderer() {
+    plugin_loader_ = std::make_unique<PluginLoader>();
+}
+
+OfflineRenderer::~OfflineRenderer() {
+}
+
+bool OfflineRenderer::render(const RenderOptions& options, RenderStats& stats) {
+    stats = RenderStats();
+
+    if (options.block_size < 4 || options.block_size > MAX_BLOCK_SIZE || options.block_size % 4 != 0) {
+        last_error_ = "Block size must be a multiple of 4 between 4 and " + std::to_string(MAX_BLOCK_SIZE);
+        return false;
+    }
+    if (options.output_buses.empty() || options.output_path.empty()) {
+        last_error_ = "No output file or buses given";
+        return false;
+    }
+
+    // Inputs are read and the output written a block at a time, so memory
+    // use doesn't grow with the render length
+    std::vector<WavReader> inputs(options.inputs.size());
+    for (size_t i = 0; i < options.inputs.size(); i++) {
+        if (!inputs[i].open(options.inputs[i].path, last_error_)) {
+            return false;
+        }
+    }
+
+    float sample_rate = options.sample_rate;
+    if (sample_rate <= 0.0f) {
+        sample_rate = inputs.empty() ? DEFAULT_SAMPLE_RATE : (float)inputs[0].getSampleRate();
+    }
+    for (size_t i = 0; i < inputs.size(); i++) {
+        if ((float)inputs[i].getSampleRate() != sample_rate) {
+            std::cerr << "Warning: " << options.inputs[i].path << " is " << inputs[i].getSampleRate()
+                      << " Hz, rendering at " << sample_rate << " Hz without resampling" << std::endl;
+        }
+    }
+
+    uint64_t total_frames = 0;
+    if (options.seconds > 0.0) {
+        total_frames = (uint64_t)std::llround(options.seconds * sample_rate);
+    } else {
+        for (const WavReader& input : inputs) {
+            total_frames = std::max<uint64_t>(total_frames, input.getFrames());
+        }
+    }
+    if (total_frames == 0) {
+        last_error_ = "Nothing to render: give --seconds or at least one non-empty input";
+        return false;
+    }
+
+    std::vector<RenderEvent> events;
+    if (!options.script_path.empty() &&
+        !loadScript(options.script_path, sample_rate, events, last_error_)) {
+        return false;
+    }
+
+    ApiShim::initialize();
+    ApiShim::setSampleRate(sample_rate);
+
+    if (!plugin_loader_->loadPlugin(options.plugin_path)) {
+        last_error_ = "Failed to load plugin " + options.plugin_path;
+        return false;
+    }
+    ApiShim::setAlgorithm(plugin_loader_->getAlgorithm());
+
+    _NT_factory* factory = plugin_loader_->getFactory();
+    _NT_algorithm* algorithm = plugin_loader_->getAlgorithm();
+    if (!factory->step) {
+        last_error_ = "Plugin has no step function";
+        return false;
+    }
+    if (!setupParameters()) {
+        return false;
+    }
+
+    const int block = options.block_size;
+    const float output_gain = 1.0f / options.volts_full_scale;
+    const size_t num_outputs = options.output_buses.size();
+
+    std::vector<float> buses(NUM_BUSES * block);
+    std::vector<float> input_block;
+    std::vector<float> output_block(block * num_outputs);
+
+    WavWriter output;
+    if (!output.open(options.output_path, (int)num_outputs, (int)std::lround(sample_rate),
+                     options.output_bits, last_error_)) {
+        plugin_loader_->unloadPlugin();
+        return false;
+    }
+
+    size_t next_event = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    try {
+        for (uint64_t frame = 0; frame < total_frames; frame += block) {
+            int frames = (int)std::min<uint64_t>(block, total_frames - frame);
+
+            // Events land on the block that contains them
+            while (next_event < events.size() && events[next_event].frame < frame + block) {
+                applyEvent(events[next_event++]);
+            }
+
+            std::fill(buses.begin(), buses.end(), 0.0f);
+            for (size_t i = 0; i < inputs.size(); i++) {
+                WavReader& input = inputs[i];
+                int channels = input.getChannels();
+                input_block.resize((size_t)frames * channels);
+                size_t available = input.read(input_block.data(), frames);
+                for (int ch = 0; ch < channels; ch++) {
+                    int bus = options.inputs[i].first_bus + ch;
+                    if (bus >= NUM_INPUT_BUSES) break;
+                    const float* src = input_block.data() + ch;
+                    float* dst = buses.data() + bus * block;
+                    for (size_t f = 0; f < available; f++) {
+                        dst[f] = src[f * channels] * options.volts_full_scale;
+                    }
+                }
+            }
+
+            // A short final block is padded with silence and trimmed on output
+            factory->step(algorithm, buses.data(), block / 4);
+
+            for (size_t o = 0; o < num_outputs; o++) {
+                const float* src = buses.data() + options.output_buses[o] * block;
+                for (int f = 0; f < frames; f++) {
+                    output_block[f * num_outputs + o] = src[f] * output_gain;
+                }
+            }
+            if (!output.write(output_block.data(), frames)) {
+                last_error_ = "Failed writing " + options.output_path;
+                plugin_loader_->unloadPlugin();
+                return false;
+            }
+        }
+    } catch (...) {
+        last_error_ = "Plugin threw an exception during rendering";
+        plugin_loader_->unloadPlugin();
+        return false;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    stats.frames = total_frames;
+    stats.wall_seconds = std::chrono::duration<double>(end - start).count();
+    if (stats.wall_seconds > 0.0) {
+        stats.frames_per_second = total_frames / stats.wall_seconds;
+        stats.realtime_factor = stats.frames_per_second / sample_rate;
+    }
+
+    plugin_loader_->unloadPlugin();
+    return output.close(last_error_);
+}
+
+bool OfflineRenderer::setupParameters() {
+    _NT_factory* factory = plugin_loader_->getFactory();
+    _NT_algorithm* algorithm = plugin_loader_->getAlgorithm();
+    uint32_t count = plugin_loader_->getNumParameters();
+
+    parameter_values_.assign(count, 0);
+    if (count > 0 && !algorithm->parameters) {
+        last_error_ = "Plugin declares parameters but provides no definitions";
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        parameter_values_[i] = algorithm->parameters[i].def;
+    }
+
+    algorithm->v = parameter_values_.data();
+    algorithm->vIncludingCommon = parameter_values_.data();
+
+    if (factory->parameterChanged) {
+        for (uint32_t i = 0; i < count; i++) {
+            factory->parameterChanged(algorithm, (int)i);
+        }
+    }
+    return true;
+}
+
+void OfflineRenderer::applyEvent(const RenderEvent& event) {
+    _NT_factory* factory = plugin_loader_->getFactory();
+    _NT_algorithm* algorithm = plugin_loader_->getAlgorithm();
+
+    if (event.type == RenderEvent::Midi) {
+        if (factory->midiMessage) {
+            factory->midiMessage(algorithm, event.midi[0], event.midi[1], event.midi[2]);
+        }
+        return;
+    }
+
+    if (event.parameter < 0 || event.parameter >= (int)parameter_values_.size()) {
+        std::cerr << "Warning: script sets parameter " << event.parameter
+                  << " but the plugin has " << parameter_values_.size() << std::endl;
+        return;
+    }
+
+    const _NT_parameter& info = algorithm->parameters[event.parameter];
+    parameter_values_[event.parameter] = std::max(info.min, std::min(info.max, event.value));
+    if (factory->parameterChanged) {
+        factory->parameterChanged(algorithm, event.parameter);
+    }
+}
+
+bool OfflineRenderer::loadScript(const std::string& path, float sample_rate,
+                                 std::vector<RenderEvent>& events, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "Cannot open script " + path;
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line)) {
+        line_number++;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream iss(line);
+        std::string time, type;
+        if (!(iss >> time)) continue;  // Blank or comment
+
+        RenderEvent event;
+        bool ok = parseTime(time, sample_rate, event.frame) && (iss >> type);
+        if (ok && type == "param") {
+            int value = 0;
+            event.type = RenderEvent::Parameter;
+            ok = (bool)(iss >> event.parameter >> value) && value >= INT16_MIN && value <= INT16_MAX;
+            event.value = (int16_t)value;
+        } else if (ok && type == "midi") {
+            std::string bytes[3];
+            event.type = RenderEvent::Midi;
+            ok = (bool)(iss >> bytes[0] >> bytes[1]);
+            iss >> bytes[2];
+            for (int i = 0; ok && i < 3; i++) {
+                ok = bytes[i].empty() || parseByte(bytes[i], event.midi[i]);
+            }
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            error = path + ":" + std::to_string(line_number) + ": cannot parse \"" + line + "\"";
+            return false;
+        }
+        events.push_back(event);
+    }
+
+    // Stable so same-frame events keep script order
+    std::stable_sort(events.begin(), events.end(),
+                     [](const RenderEvent& a, const RenderEvent& b) { return a.frame < b.frame; });
+    return true;
+}
+
+void OfflineRenderer::printUsage(const char* program) {
+    std::cout << "Usage: " << program << " --plugin <plugin.so> --out <out.wav> --buses <n,n,...> [options]\n";
+    std::cout << "\nOptions:\n";
+    std::cout << "  --in <file.wav>[:bus]  Stream a WAV onto input buses starting at bus (1-12, default 1)\n";
+    std::cout << "  --script <file>        Parameter/MIDI event script\n";
+    std::cout << "  --buses <n,n,...>      Buses to write, 1-28 (outputs are 13-20)\n";
+    std::cout << "  --seconds <s>          Render length (default: longest input)\n";
+    std::cout << "  --rate <hz>            Sample rate (default: first input, else 48000)\n";
+    std::cout << "  --block <frames>       Frames per step, multiple of 4 (default 4)\n";
+    std::cout << "  --volts <v>            Bus voltage at WAV full scale (default 1)\n";
+    std::cout << "  --bits <16|24|32>      Output format; 32 writes float (default 32)\n";
+    std::cout << "\nScript lines, time in frames or with an s/ms suffix:\n";
+    std::cout << "  0.5s param 2 100\n";
+    std::cout << "  24000 midi 0x90 60 100\n";
+}
+
+int OfflineRenderer::runCommandLine(int argc, char* argv[]) {
+    const char* program = argc > 0 ? argv[0] : "render";
+    RenderOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(program);
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--plugin") {
+            options.plugin_path = value;
+        } else if (arg == "--in") {
+            RenderInput input;
+            input.path = value;
+            size_t colon = value.rfind(':');
+            if (colon != std::string::npos && colon + 1 < value.size() &&
+                value.find_first_not_of("0123456789", colon + 1) == std::string::npos) {
+                input.path = value.substr(0, colon);
+                input.first_bus = std::atoi(value.c_str() + colon + 1) - 1;
+            }
+            if (input.first_bus < 0 || input.first_bus >= NUM_INPUT_BUSES) {
+                std::cerr << "Input bus must be 1-" << NUM_INPUT_BUSES << ": " << value << "\n";
+                return 1;
+            }
+            options.inputs.push_back(input);
+        } else if (arg == "--script") {
+            options.script_path = value;
+        } else if (arg == "--out") {
+            options.output_path = value;
+        } else if (arg == "--buses") {
+            if (!parseBusList(value, options.output_buses)) {
+                std::cerr << "Invalid bus list: " << value << "\n";
+                return 1;
+            }
+        } else if (arg == "--seconds") {
+            options.seconds = std::atof(value.c_str());
+        } else if (arg == "--rate") {
+            options.sample_rate = (float)std::atof(value.c_str());
+        } else if (arg == "--block") {
+            options.block_size = std::atoi(value.c_str());
+        } else if (arg == "--volts") {
+            options.volts_full_scale = (float)std::atof(value.c_str());
+        } else if (arg == "--bits") {
+            options.output_bits = std::atoi(value.c_str());
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            printUsage(program);
+            return 1;
+        }
+    }
+
+    if (options.plugin_path.empty() || options.output_path.empty() || options.output_buses.empty()) {
+        printUsage(program);
+        return 1;
+    }
+    if (options.volts_full_scale <= 0.0f) {
+        std::cerr << "--volts must be positive\n";
+        return 1;
+    }
+
+    OfflineRenderer renderer;
+    RenderStats stats;
+    if (!renderer.render(options, stats)) {
+        std::cerr << "Render failed: " << renderer.getLastError() << "\n";
+        return 1;
+    }
+
+    std::cout << "Rendered " << stats.frames << " frames in " << stats.wall_seconds << " s\n";
+    std::cout << "Frames/s: " << (uint64_t)stats.frames_per_second << "\n";
+    std::cout << "Real-time factor: " << stats.realtime_factor << "x\n";
+    return 0;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "plugin_loader.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Buses are numbered 1-28 on the command line, as on the module:
+// 1-12 inputs, 13-20 outputs, 21-28 aux.
+struct RenderInput {
+    std::string path;
+    int first_bus = 0;          // 0-based; channels fill consecutive input buses
+};
+
+struct RenderEvent {
+    enum Type { Parameter, Midi };
+
+    uint64_t frame = 0;
+    Type type = Parameter;
+    int parameter = 0;
+    int16_t value = 0;
+    uint8_t midi[3] = {0, 0, 0};
+};
+
+struct RenderOptions {
+    std::string plugin_path;
+    std::vector<RenderInput> inputs;
+    std::string script_path;
+    std::string output_path;
+    std::vector<int> output_buses;  // 0-based
+    float sample_rate = 0.0f;       // 0 = from the first input, else 48 kHz
+    double seconds = 0.0;           // 0 = length of the longest input
+    int block_size = 4;             // Frames per step() call, multiple of 4
+    float volts_full_scale = 1.0f;  // Bus volts at WAV full scale
+    int output_bits = 32;
+};
+
+struct RenderStats {
+    uint64_t frames = 0;
+    double wall_seconds = 0.0;
+    double frames_per_second = 0.0;
+    double realtime_factor = 0.0;
+};
+
+/**
+ * Runs a plugin without an audio device, as fast as the CPU allows.
+ * Input WAVs are streamed onto input buses, a time-stamped script of
+ * parameter changes and MIDI messages is applied at block boundaries,
+ * and selected buses are written to a multichannel WAV.
+ */
+class OfflineRenderer {
+public:
+    OfflineRenderer();
+    ~OfflineRenderer();
+
+    bool render(const RenderOptions& options, RenderStats& stats);
+    const std::string& getLastError() const { return last_error_; }
+
+    // Script lines: "<time> param <index> <value>" or "<time> midi <b0> <b1> [b2]".
+    // Time is in frames, or seconds with an "s" suffix, or milliseconds with "ms".
+    static bool loadScript(const std::string& path, float sample_rate,
+                           std::vector<RenderEvent>& events, std::string& error);
+
+    // Command-line front end shared by the render target and the console's "render" mode
+    static int runCommandLine(int argc, char* argv[]);
+    static void printUsage(const char* program);
+
+private:
+    std::unique_ptr<PluginLoader> plugin_loader_;
+    std::vector<int16_t> parameter_values_;
+    std::string last_error_;
+
+    bool setupParameters();
+    void applyEvent(const RenderEvent& event);
+};
@@ -1,7 +1,9 @@
 #include "plugin_loader.h"
 #include <dlfcn.h>
 #include <iostream>
-#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <filesystem>
 
 typedef uintptr_t (*PluginEntryFunc)(_NT_selector, uint32_t);
 
@@ -15,23 +17,32 @@ PluginLoader::~PluginLoader() {
 bool PluginLoader::loadPlugin(const std::string& path) {
     unloadPlugin();
     
+    if (!loadInstance(path, path, plugin_)) {
+        return false;
+    }
+    
+    std::cout << "Plugin loaded successfully: " << path << std::endl;
+    return true;
+}
+
+bool PluginLoader::loadInstance(const std::string& path, const std::string& open_path, PluginInstance& instance) {
     // Load the dynamic library
-    plugin_.handle = dlopen(path.c_str(), RTLD_LAZY);
-    if (!plugin_.handle) {
+    instance.handle = dlopen(open_path.c_str(), RTLD_LAZY);
+    if (!instance.handle) {
         std::cerr << "Failed to load plugin: " << dlerror() << std::endl;
         return false;
     }
     
-    if (!validatePlugin(plugin_.handle)) {
-        cleanup();
+    if (!validatePlugin(instance.handle)) {
+        releaseInstance(instance);
         return false;
     }
     
     // Get the pluginEntry function
-    PluginEntryFunc pluginEntry = (PluginEntryFunc)dlsym(plugin_.handle, "pluginEntry");
+    PluginEntryFunc pluginEntry = (PluginEntryFunc)dlsym(instance.handle, "pluginEntry");
     if (!pluginEntry) {
         std::cerr << "Plugin missing pluginEntry symbol: " << dlerror() << std::endl;
-        cleanup();
+        releaseInstance(instance);
         return false;
     }
     
@@ -39,7 +50,7 @@ bool PluginLoader::loadPlugin(const std::string& path) {
     uintptr_t version = pluginEntry(kNT_selector_version, 0);
     if (version != kNT_apiVersionCurrent) {
         std::cerr << "API version mismatch: " << version << " vs " << kNT_apiVersionCurrent << std::endl;
-        cleanup();
+        releaseInstance(instance);
         return false;
     }
     
@@ -47,117 +58,117 @@ bool PluginLoader::loadPlugin(const std::string& path) {
     uintptr_t numFactories = pluginEntry(kNT_selector_numFactories, 0);
     if (numFactories < 1) {
         std::cerr << "No factories in plugin" << std::endl;
-        cleanup();
+        releaseInstance(instance);
         return false;
     }
     
     // Get factory pointer for index 0
-    plugin_.factory = (_NT_factory*)pluginEntry(kNT_selector_factoryInfo, 0);
-    if (!plugin_.factory) {
+    instance.factory = (_NT_factory*)pluginEntry(kNT_selector_factoryInfo, 0);
+    if (!instance.factory) {
         std::cerr << "Failed to get factory" << std::endl;
-        cleanup();
+        releaseInstance(instance);
         return false;
     }
     
     // API version already checked via selector
     
     // Get static requirements and allocate shared memory
-    if (!plugin_.factory->calculateStaticRequirements) {
+    if (!instance.factory->calculateStaticRequirements) {
         std::cerr << "Plugin factory missing calculateStaticRequirements function" << std::endl;
-        cleanup();
+        releaseInstance(instance);
         return false;
     }
     
     _NT_staticRequirements staticReqs = {};
-    plugin_.factory->calculateStaticRequirements(staticReqs);
+    instance.factory->calculateStaticRequirements(staticReqs);
     if (staticReqs.dram > 0) {
         // Use posix_memalign for better compatibility
-        if (posix_memalign(&plugin_.shared_memory, 16, staticReqs.dram) != 0) {
+        if (posix_memalign(&instance.shared_memory, 16, staticReqs.dram) != 0) {
             std::cerr << "Failed to allocate shared memory" << std::endl;
-            cleanup();
+            releaseInstance(instance);
             return false;
         }
         
         // Initialize the factory
-        if (!plugin_.factory->initialise) {
+        if (!instance.factory->initialise) {
             std::cerr << "Plugin factory missing initialise function" << std::endl;
-            cleanup();
+            releaseInstance(instance);
             return false;
         }
         
         _NT_staticMemoryPtrs staticPtrs = {};
-        staticPtrs.dram = (uint8_t*)plugin_.shared_memory;
-        plugin_.factory->initialise(staticPtrs, staticReqs);
+        staticPtrs.dram = (uint8_t*)instance.shared_memory;
+        instance.factory->initialise(staticPtrs, staticReqs);
     }
     
     // Get algorithm requirements and allocate instance memory
-    if (!plugin_.factory->calculateRequirements) {
+    if (!instance.factory->calculateRequirements) {
         std::cerr << "Plugin factory missing calculateRequirements function" << std::endl;
-        cleanup();
+        releaseInstance(instance);
         return false;
     }
     
     _NT_algorithmRequirements reqs = {};
-    plugin_.factory->calculateRequirements(reqs, nullptr);
+    instance.factory->calculateRequirements(reqs, nullptr);
+    instance.num_parameters = reqs.numParameters;
 
     // Allocate SRAM (algorithm struct)
     if (reqs.sram > 0) {
-        if (posix_memalign(&plugin_.sram_memory, 16, reqs.sram) != 0) {
+        if (posix_memalign(&instance.sram_memory, 16, reqs.sram) != 0) {
             std::cerr << "Failed to allocate SRAM" << std::endl;
-            cleanup();
+            releaseInstance(instance);
             return false;
         }
-        memset(plugin_.sram_memory, 0, reqs.sram);
+        memset(instance.sram_memory, 0, reqs.sram);
     }
 
     // Allocate DRAM (large buffers)
     if (reqs.dram > 0) {
-        if (posix_memalign(&plugin_.instance_memory, 16, reqs.dram) != 0) {
+        if (posix_memalign(&instance.instance_memory, 16, reqs.dram) != 0) {
             std::cerr << "Failed to allocate instance memory" << std::endl;
-            cleanup();
+            releaseInstance(instance);
             return false;
         }
     }
 
     // Allocate DTC (performance-critical data)
     if (reqs.dtc > 0) {
-        if (posix_memalign(&plugin_.dtc_memory, 16, reqs.dtc) != 0) {
+        if (posix_memalign(&instance.dtc_memory, 16, reqs.dtc) != 0) {
             std::cerr << "Failed to allocate DTC memory" << std::endl;
-            cleanup();
+            releaseInstance(instance);
             return false;
         }
-        memset(plugin_.dtc_memory, 0, reqs.dtc);
+        memset(instance.dtc_memory, 0, reqs.dtc);
     }
 
     {
         // Construct the algorithm instance
-        if (!plugin_.factory->construct) {
+        if (!instance.factory->construct) {
             std::cerr << "Plugin factory missing construct function" << std::endl;
-            cleanup();
+            releaseInstance(instance);
             return false;
         }
 
         _NT_algorithmMemoryPtrs algPtrs = {};
-        algPtrs.sram = (uint8_t*)plugin_.sram_memory;
-        algPtrs.dram = (uint8_t*)plugin_.instance_memory;
-        algPtrs.dtc = (uint8_t*)plugin_.dtc_memory;
-        plugin_.algorithm = plugin_.factory->construct(algPtrs, reqs, nullptr);
-        if (!plugin_.algorithm) {
+        algPtrs.sram = (uint8_t*)instance.sram_memory;
+        algPtrs.dram = (uint8_t*)instance.instance_memory;
+        algPtrs.dtc = (uint8_t*)instance.dtc_memory;
+        instance.algorithm = instance.factory->construct(algPtrs, reqs, nullptr);
+        if (!instance.algorithm) {
             std::cerr << "Algorithm construction failed" << std::endl;
-            cleanup();
+            releaseInstance(instance);
             return false;
         }
     }
     
-    plugin_.path = path;
-    plugin_.last_modified = getFileModTime(path);
-    plugin_.is_loaded = true;
-    
-    std::cout << "Plugin loaded successfully: " << path << std::endl;
+    instance.path = path;
+    instance.is_loaded = true;
     return true;
 }
 
 void PluginLoader::unloadPlugin() {
+    abandonReload();
+    
     if (plugin_.is_loaded && plugin_.algorithm) {
         // No explicit destruct function in new API - algorithm cleanup is automatic
         plugin_.algorithm = nullptr;
@@ -181,45 +192,44 @@ bool PluginLoader::validatePlugin(void* handle) {
 }
 
 void PluginLoader::cleanup() {
-    if (plugin_.dtc_memory) {
-        free(plugin_.dtc_memory);
-        plugin_.dtc_memory = nullptr;
+    releaseInstance(plugin_);
+}
+
+void PluginLoader::releaseInstance(PluginInstance& instance) {
+    if (instance.dtc_memory) {
+        free(instance.dtc_memory);
+        instance.dtc_memory = nullptr;
     }
 
-    if (plugin_.sram_memory) {
-        free(plugin_.sram_memory);
-        plugin_.sram_memory = nullptr;
+    if (instance.sram_memory) {
+        free(instance.sram_memory);
+        instance.sram_memory = nullptr;
     }
 
-    if (plugin_.instance_memory) {
-        free(plugin_.instance_memory);
-        plugin_.instance_memory = nullptr;
+    if (instance.instance_memory) {
+        free(instance.instance_memory);
+        instance.instance_memory = nullptr;
     }
 
-    if (plugin_.shared_memory) {
-        free(plugin_.shared_memory);
-        plugin_.shared_memory = nullptr;
+    if (instance.shared_memory) {
+        free(instance.shared_memory);
+        instance.shared_memory = nullptr;
     }
 
-    if (plugin_.handle) {
-        dlclose(plugin_.handle);
-        plugin_.handle = nullptr;
+    if (instance.handle) {
+        dlclose(instance.handle);
+        instance.handle = nullptr;
     }
-}
 
-time_t PluginLoader::getFileModTime(const std::string& path) const {
-    struct stat st;
-    if (stat(path.c_str(), &st) == 0) {
-        return st.st_mtime;
+    if (!instance.shadow_path.empty()) {
+        std::error_code ignored;
+        std::filesystem::remove(instance.shadow_path, ignored);
+        instance.shadow_path.clear();
     }
-    return 0;
-}
 
-bool PluginLoader::needsReload() const {
-    if (!plugin_.is_loaded) return false;
-    
-    time_t current_mod_time = getFileModTime(plugin_.path);
-    return current_mod_time > plugin_.last_modified;
+    instance.factory = nullptr;
+    instance.algorithm = nullptr;
+    instance.is_loaded = false;
 }
 
 bool PluginLoader::reload() {
@@ -227,4 +237,71 @@ bool PluginLoader::reload() {
     
     std::string path = plugin_.path;
     return loadPlugin(path);
+}
+
+bool PluginLoader::beginBackgroundReload() {
+    if (!plugin_.is_loaded || reload_state_.load() != ReloadState::Idle) return false;
+    joinReloadThread();
+    
+    static int shadow_counter = 0;
+    std::filesystem::path source(plugin_.path);
+    std::filesystem::path shadow = std::filesystem::temp_directory_path() /
+        ("nt_emu_hotswap_" + std::to_string(getpid()) + "_" + std::to_string(++shadow_counter) +
+         "_" + source.filename().string());
+    
+    std::string path = plugin_.path;
+    const int16_t* values = plugin_.algorithm ? plugin_.algorithm->v : nullptr;
+    reload_state_ = ReloadState::Preparing;
+    
+    reload_thread_ = std::thread([this, path, shadow, values]() {
+        std::error_code error;
+        std::filesystem::copy_file(path, shadow, std::filesystem::copy_options::overwrite_existing, error);
+        if (error) {
+            std::cerr << "Hot swap: cannot copy " << path << ": " << error.message() << std::endl;
+            reload_state_ = ReloadState::Failed;
+            return;
+        }
+        
+        staged_.shadow_path = shadow.string();
+        if (!loadInstance(path, staged_.shadow_path, staged_)) {
+            releaseInstance(staged_);
+            reload_state_ = ReloadState::Failed;
+            return;
+        }
+        
+        // Carry the running instance's parameter values over
+        if (values && staged_.algorithm) {
+            staged_.algorithm->v = values;
+            if (staged_.factory->parameterChanged) {
+                for (uint32_t i = 0; i < staged_.num_parameters; i++) {
+                    staged_.factory->parameterChanged(staged_.algorithm, (int)i);
+                }
+            }
+        }
+        reload_state_ = ReloadState::Ready;
+    });
+    return true;
+}
+
+void PluginLoader::completeReload() {
+    if (reload_state_.load() != ReloadState::Ready) return;
+    joinReloadThread();
+    
+    std::swap(plugin_, staged_);
+    releaseInstance(staged_);
+    staged_ = PluginInstance();
+    reload_state_ = ReloadState::Idle;
+}
+
+void PluginLoader::abandonReload() {
+    joinReloadThread();
+    releaseInstance(staged_);
+    staged_ = PluginInstance();
+    reload_state_ = ReloadState::Idle;
+}
+
+void PluginLoader::joinReloadThread() {
+    if (reload_thread_.joinable()) {
+        reload_thread_.join();
+    }
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <memory>
+#include <thread>
 #include <distingnt/api.h>
 
 struct PluginInstance {
@@ -12,8 +14,9 @@ struct PluginInstance {
     void* sram_memory = nullptr;
     void* instance_memory = nullptr;
     void* dtc_memory = nullptr;
+    uint32_t num_parameters = 0;
     std::string path;
-    time_t last_modified = 0;
+    std::string shadow_path;    // Private copy the library was opened from, if any
     bool is_loaded = false;
 };
 
@@ -28,16 +31,36 @@ public:
     
     _NT_algorithm* getAlgorithm() const { return plugin_.algorithm; }
     _NT_factory* getFactory() const { return plugin_.factory; }
+    uint32_t getNumParameters() const { return plugin_.num_parameters; }
     
-    bool needsReload() const;
     bool reload();
     
+    // Two-phase hot swap. The changed library is copied and opened under a
+    // new name on a background thread (so dlopen maps the new build rather
+    // than returning the loaded one) and its algorithm is constructed with
+    // the current parameter values. Once ready, the caller points the audio
+    // engine at getStagedPlugin() and, after the engine has switched,
+    // calls completeReload() to make it current and unload the old build.
+    bool beginBackgroundReload();
+    bool isReloadReady() const { return reload_state_.load() == ReloadState::Ready; }
+    bool isReloadFailed() const { return reload_state_.load() == ReloadState::Failed; }
+    const PluginInstance& getStagedPlugin() const { return staged_; }
+    void completeReload();
+    void abandonReload();
+    
     const std::string& getPath() const { return plugin_.path; }
     
 private:
+    enum class ReloadState { Idle, Preparing, Ready, Failed };
+    
     PluginInstance plugin_;
+    PluginInstance staged_;
+    std::thread reload_thread_;
+    std::atomic<ReloadState> reload_state_{ReloadState::Idle};
     
+    bool loadInstance(const std::string& path, const std::string& open_path, PluginInstance& instance);
+    void releaseInstance(PluginInstance& instance);
+    void joinReloadThread();
     bool validatePlugin(void* handle);
     void cleanup();
-    time_t getFileModTime(const std::string& path) const;
 };
\ No newline at end of file
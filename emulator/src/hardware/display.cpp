@@ -1,16 +1,26 @@
 #include "display.h"
 #include "../core/api_shim.h"
 #include <imgui.h>
+#include <algorithm>
+#include <cstdint>
 
-Display::Display() 
-    : pixel_color_on_(1.0f, 1.0f, 1.0f, 1.0f)    // White
-    , pixel_color_off_(0.1f, 0.1f, 0.1f, 1.0f)   // Dark gray
-    , background_color_(0.0f, 0.0f, 0.0f, 1.0f)   // Black
-{
+#if defined(__APPLE__)
+#include <OpenGL/gl3.h>
+#else
+#include <GL/gl3w.h>
+#endif
+
+Display::Display() {
+    // 4-bit gray to opaque RGBA (ImGui's IM_COL32 byte order), 0 is black
+    for (int level = 0; level < 16; level++) {
+        palette_[level] = IM_COL32(level * 17, level * 17, level * 17, 255);
+    }
+    rgba_.fill(palette_[0]);
     buffer_.clear();
 }
 
 Display::~Display() {
+    // The GL context may already be gone here; see releaseTexture()
 }
 
 void Display::render() {
@@ -23,36 +33,84 @@ void Display::clear() {
 
 void Display::updateFromApiState() {
     // Copy from the API state to our local buffer
-    buffer_ = ApiShim::getState().display;
+    const DisplayBuffer& state = ApiShim::getState().display;
+    if (state.pixels != buffer_.pixels) {
+        buffer_.pixels = state.pixels;
+        buffer_.dirty = true;
+    }
+}
+
+void Display::setScale(int scale) {
+    scale_ = std::max(MIN_SCALE, std::min(MAX_SCALE, scale));
+}
+
+void Display::releaseTexture() {
+    if (texture_) {
+        GLuint texture = texture_;
+        glDeleteTextures(1, &texture);
+        texture_ = 0;
+    }
+}
+
+ImTextureID Display::getTexture() {
+    if (!texture_) {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        // Nearest sampling keeps pixels square at integer scales
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, WIDTH, HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        texture_ = texture;
+        buffer_.dirty = true;
+    }
+    if (buffer_.dirty) {
+        uploadTexture();
+    }
+    return (ImTextureID)(intptr_t)texture_;
+}
+
+void Display::uploadTexture() {
+    uint32_t* out = rgba_.data();
+    for (uint8_t pair : buffer_.pixels) {
+        // Even x in the high nibble
+        *out++ = palette_[pair >> 4];
+        *out++ = palette_[pair & 0x0F];
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, rgba_.data());
+    buffer_.dirty = false;
+}
+
+void Display::drawImage(ImDrawList* draw_list, ImVec2 pos, ImVec2 size, ImU32 tint) {
+    draw_list->AddImage(getTexture(), pos, ImVec2(pos.x + size.x, pos.y + size.y),
+                        ImVec2(0, 0), ImVec2(1, 1), tint);
 }
 
 void Display::renderDisplayWindow() {
     ImGui::Begin("Disting NT Display");
-    
+
     // Display info
     ImGui::Text("Resolution: %dx%d", WIDTH, HEIGHT);
-    ImGui::Text("Scale: %.1fx", SCALE);
-    
+    int scale = scale_;
+    if (ImGui::SliderInt("Scale", &scale, MIN_SCALE, MAX_SCALE, "%dx")) {
+        setScale(scale);
+    }
+
     ImGui::Separator();
-    
+
     // Get drawing context
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
     ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
-    ImVec2 canvas_size(WIDTH * SCALE, HEIGHT * SCALE);
-    
-    // Reserve space for the display
-    ImGui::InvisibleButton("display_canvas", canvas_size);
-    
-    // Draw background
-    draw_list->AddRectFilled(
-        canvas_pos,
-        ImVec2(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y),
-        ImGui::ColorConvertFloat4ToU32(background_color_)
-    );
-    
-    // Draw pixels
-    drawPixelGrid(draw_list, canvas_pos, canvas_size);
-    
+    ImVec2 canvas_size((float)(WIDTH * scale_), (float)(HEIGHT * scale_));
+
+    // One textured quad, whatever the plugin drew
+    ImGui::Image(getTexture(), canvas_size);
+
     // Draw border
     draw_list->AddRect(
         canvas_pos,
@@ -62,39 +120,6 @@ void Display::renderDisplayWindow() {
         0,
         2.0f
     );
-    
+
     ImGui::End();
 }
-
-void Display::drawPixelGrid(ImDrawList* draw_list, ImVec2 canvas_pos, ImVec2 canvas_size) {
-    (void)canvas_size;  // Unused for now
-    
-    // Determine pixel size
-    float pixel_width = SCALE;
-    float pixel_height = SCALE;
-    
-    // Draw each pixel
-    for (int y = 0; y < HEIGHT; y++) {
-        for (int x = 0; x < WIDTH; x++) {
-            bool pixel_on = buffer_.getPixel(x, y);
-            
-            if (pixel_on) {
-                ImVec2 pixel_pos(
-                    canvas_pos.x + x * pixel_width,
-                    canvas_pos.y + y * pixel_height
-                );
-                
-                ImVec2 pixel_end(
-                    pixel_pos.x + pixel_width,
-                    pixel_pos.y + pixel_height
-                );
-                
-                draw_list->AddRectFilled(
-                    pixel_pos,
-                    pixel_end,
-                    ImGui::ColorConvertFloat4ToU32(pixel_color_on_)
-                );
-            }
-        }
-    }
-}
\ No newline at end of file
@@ -2,32 +2,51 @@
 
 #include "../core/api_shim.h"
 #include <imgui.h>
+#include <array>
+#include <cstdint>
 
 class Display {
 public:
     static constexpr int WIDTH = 256;
     static constexpr int HEIGHT = 64;
-    static constexpr float SCALE = 3.0f;  // Scale factor for visibility
-    
+    static constexpr int MIN_SCALE = 1;
+    static constexpr int MAX_SCALE = 6;
+    static constexpr int DEFAULT_SCALE = 3;
+
     Display();
     ~Display();
-    
+
     void render();
     void clear();
-    
+
     // Access to display buffer
     DisplayBuffer& getBuffer() { return buffer_; }
     const DisplayBuffer& getBuffer() const { return buffer_; }
-    
-    // Update from API state
+
+    // Update from API state; marks the buffer dirty only if a pixel changed
     void updateFromApiState();
-    
+
+    // Integer scale for the display window
+    void setScale(int scale);
+    int getScale() const { return scale_; }
+
+    // Draws the screen as one textured quad. The texture is a 16-level gray
+    // ramp, so `tint` colours the lit pixels (e.g. cyan for the panel view).
+    void drawImage(ImDrawList* draw_list, ImVec2 pos, ImVec2 size, ImU32 tint = IM_COL32_WHITE);
+
+    // Deletes the GL texture; call while the GL context is still current
+    void releaseTexture();
+
 private:
     DisplayBuffer buffer_;
-    ImVec4 pixel_color_on_;
-    ImVec4 pixel_color_off_;
-    ImVec4 background_color_;
-    
+    int scale_ = DEFAULT_SCALE;
+
+    // GL texture holding the screen, re-uploaded when buffer_.dirty is set
+    unsigned int texture_ = 0;
+    std::array<uint32_t, 16> palette_;
+    std::array<uint32_t, WIDTH * HEIGHT> rgba_;
+
     void renderDisplayWindow();
-    void drawPixelGrid(ImDrawList* draw_list, ImVec2 canvas_pos, ImVec2 canvas_size);
-};
\ No newline at end of file
+    ImTextureID getTexture();
+    void uploadTexture();
+};
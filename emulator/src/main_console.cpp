@@ -7,6 +7,7 @@
 
 // Emulator includes
 #include "core/emulator_console.h"
+#include "core/offline_renderer.h"
 
 class ConsoleUI {
 public:
@@ -166,6 +167,11 @@ private:
 };
 
 int main(int argc, char* argv[]) {
+    // "render" runs offline before any audio device is opened
+    if (argc > 1 && std::string(argv[1]) == "render") {
+        return OfflineRenderer::runCommandLine(argc - 1, argv + 1);
+    }
+    
     std::cout << "Initializing Disting NT Emulator...\n";
     
     auto emulator = std::make_shared<EmulatorConsole>();
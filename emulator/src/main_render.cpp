@@ -0,0 +1,6 @@
+// Headless offline renderer: no audio device, no UI
+#include "core/offline_renderer.h"
+
+int main(int argc, char* argv[]) {
+    return OfflineRenderer::runCommandLine(argc, argv);
+}
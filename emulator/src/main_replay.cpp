@@ -0,0 +1,194 @@
+// Display recording replayer: inspect, step through and export recordings
+// made by the emulator or the VCV module (see utils/frame_recording.h)
+#include "utils/frame_recording.h"
+#include "utils/image_writer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    // 16 gray levels as characters, dark to light
+    const char* const SHADES = " .:-=+*#%@@@@@@@";
+
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " <recording> <command>\n"
+                  << "\n"
+                  << "Commands:\n"
+                  << "  info                          Frame count, duration and audio blocks\n"
+                  << "  show <frame>                  Print a frame as text\n"
+                  << "  step [frame]                  Step through frames interactively\n"
+                  << "  png <frame> <out.png>         Export one frame\n"
+                  << "  gif <out.gif> [first] [last]  Export frames as an animated GIF\n"
+                  << "\n"
+                  << "Options: --scale <n> (default 3) for png and gif\n";
+    }
+
+    void printFrame(const FrameReplayer& replayer) {
+        const FrameReplayer::FrameInfo& info = replayer.getInfo(replayer.getIndex());
+        std::cout << "Frame " << replayer.getIndex() << "/" << replayer.getFrameCount() - 1
+                  << "  t=" << info.timestamp_us / 1000.0 << " ms  block " << info.block
+                  << (info.keyframe ? "  (key)" : "") << "\n";
+
+        // Two pixels across per character keeps a frame within 128 columns
+        const uint8_t* screen = replayer.getScreen();
+        for (int y = 0; y < FrameRecording::HEIGHT; y++) {
+            std::string line(FrameRecording::WIDTH / 2, ' ');
+            for (int x = 0; x < FrameRecording::WIDTH / 2; x++) {
+                uint8_t pair = screen[y * FrameRecording::WIDTH / 2 + x];
+                line[x] = SHADES[std::max(pair >> 4, pair & 0x0F)];
+            }
+            std::cout << '|' << line << "|\n";
+        }
+    }
+
+    // Delay until the next frame, in GIF hundredths of a second
+    int frameDelayCs(const FrameReplayer& replayer, size_t index) {
+        if (index + 1 >= replayer.getFrameCount()) return 100;
+        uint64_t us = replayer.getInfo(index + 1).timestamp_us - replayer.getInfo(index).timestamp_us;
+        // Most viewers treat delays under 2 as 10
+        return std::max(2, (int)((us + 5000) / 10000));
+    }
+
+    int runStep(FrameReplayer& replayer, size_t first, int scale) {
+        if (!replayer.seek(first)) {
+            std::cerr << "No frame " << first << "\n";
+            return 1;
+        }
+        printFrame(replayer);
+        std::cout << "[Enter] next, b back, g <n> go to, p <file.png> export, q quit\n";
+
+        std::string line;
+        while (std::cout << "> " << std::flush, std::getline(std::cin, line)) {
+            std::istringstream iss(line);
+            std::string command;
+            iss >> command;
+            if (command.empty() || command == "n") {
+                if (!replayer.next()) std::cout << "Last frame\n";
+            } else if (command == "b") {
+                if (!replayer.previous()) std::cout << "First frame\n";
+            } else if (command == "g") {
+                size_t index = 0;
+                if (!(iss >> index) || !replayer.seek(index)) {
+                    std::cout << "No such frame\n";
+                    continue;
+                }
+            } else if (command == "p") {
+                std::string path, error;
+                if (!(iss >> path)) {
+                    std::cout << "p <file.png>\n";
+                } else if (!ImageWriter::writePng(path, replayer.getScreen(), scale, error)) {
+                    std::cout << error << "\n";
+                } else {
+                    std::cout << "Wrote " << path << "\n";
+                }
+                continue;
+            } else if (command == "q") {
+                break;
+            } else {
+                std::cout << "Unknown command\n";
+                continue;
+            }
+            printFrame(replayer);
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const char* program = argc > 0 ? argv[0] : "replay";
+
+    // --scale may appear anywhere; the rest are positional
+    int scale = 3;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(program);
+            return 0;
+        } else if (arg == "--scale" && i + 1 < argc) {
+            scale = std::max(1, std::atoi(argv[++i]));
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (args.size() < 2) {
+        printUsage(program);
+        return 1;
+    }
+
+    FrameReplayer replayer;
+    std::string error;
+    if (!replayer.open(args[0], error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    const std::string& command = args[1];
+    size_t count = replayer.getFrameCount();
+    if (command == "info") {
+        const FrameReplayer::FrameInfo& last = replayer.getInfo(count - 1);
+        size_t keyframes = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (replayer.getInfo(i).keyframe) keyframes++;
+        }
+        std::cout << "Frames: " << count << " (" << keyframes << " keyframes)\n"
+                  << "Duration: " << last.timestamp_us / 1e6 << " s\n"
+                  << "Audio blocks: " << last.block << "\n";
+        return 0;
+    }
+    if (command == "show" && args.size() >= 3) {
+        if (!replayer.seek(std::strtoul(args[2].c_str(), nullptr, 10))) {
+            std::cerr << "No frame " << args[2] << "\n";
+            return 1;
+        }
+        printFrame(replayer);
+        return 0;
+    }
+    if (command == "step") {
+        return runStep(replayer, args.size() >= 3 ? std::strtoul(args[2].c_str(), nullptr, 10) : 0, scale);
+    }
+    if (command == "png" && args.size() >= 4) {
+        if (!replayer.seek(std::strtoul(args[2].c_str(), nullptr, 10))) {
+            std::cerr << "No frame " << args[2] << "\n";
+            return 1;
+        }
+        if (!ImageWriter::writePng(args[3], replayer.getScreen(), scale, error)) {
+            std::cerr << error << "\n";
+            return 1;
+        }
+        return 0;
+    }
+    if (command == "gif" && args.size() >= 3) {
+        size_t first = args.size() >= 4 ? std::strtoul(args[3].c_str(), nullptr, 10) : 0;
+        size_t last = args.size() >= 5 ? std::strtoul(args[4].c_str(), nullptr, 10) : count - 1;
+        last = std::min(last, count - 1);
+        if (first > last) {
+            std::cerr << "Empty frame range\n";
+            return 1;
+        }
+
+        GifWriter gif;
+        if (!gif.open(args[2], scale, error)) {
+            std::cerr << error << "\n";
+            return 1;
+        }
+        for (size_t i = first; i <= last; i++) {
+            if (!replayer.seek(i) || !gif.addFrame(replayer.getScreen(), frameDelayCs(replayer, i))) {
+                std::cerr << "Failed at frame " << i << "\n";
+                return 1;
+            }
+        }
+        if (!gif.close()) {
+            std::cerr << "Write failed: " << args[2] << "\n";
+            return 1;
+        }
+        std::cout << "Wrote " << (last - first + 1) << " frames to " << args[2] << "\n";
+        return 0;
+    }
+
+    printUsage(program);
+    return 1;
+}
@@ -1,10 +1,13 @@
 #include "main_window.h"
 #include <imgui.h>
 #include <iostream>
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #include "../core/emulator.h"
 #include "../core/api_shim.h"
+#include "../hardware/display.h"
 #include "../utils/file_dialog.h"
 
 #ifndef M_PI
@@ -150,8 +153,8 @@ void DistingNTMainWindow::renderDisplay() {
     if (!emulator_) return;
     
     ImVec2 content_pos = ImGui::GetCursorScreenPos();
-    // Display size matching NT hardware (256x64 scaled up)
-    const float scale = 1.75f;  // Scale factor for visibility
+    // Display size matching NT hardware (256x64 at an integer scale that fits the panel)
+    const float scale = (float)getDisplayScale();
     ImVec2 display_size(256 * scale, 64 * scale);  // Native NT display resolution
     ImVec2 display_pos(content_pos.x + (WINDOW_WIDTH - display_size.x) / 2, content_pos.y + 10);
     
@@ -165,32 +168,11 @@ void DistingNTMainWindow::renderDisplay() {
     );
     
     // Render plugin display content
-    if (emulator_->isPluginLoaded()) {
-        // Get the display buffer from API state
-        const auto& display_buffer = ApiShim::getState().display;
-        
-        // Render each pixel from the plugin's display buffer
-        for (int y = 0; y < 64; y++) {
-            for (int x = 0; x < 256; x++) {
-                if (display_buffer.getPixel(x, y)) {
-                    ImVec2 pixel_pos(
-                        display_pos.x + x * scale,
-                        display_pos.y + y * scale
-                    );
-                    
-                    ImVec2 pixel_end(
-                        pixel_pos.x + scale,
-                        pixel_pos.y + scale
-                    );
-                    
-                    draw_list->AddRectFilled(
-                        pixel_pos,
-                        pixel_end,
-                        IM_COL32(0, 255, 255, 255)  // Cyan pixels like real hardware
-                    );
-                }
-            }
-        }
+    Display* display = emulator_->getDisplay();
+    if (emulator_->isPluginLoaded() && display) {
+        // One texture for the whole screen, tinted cyan like real hardware;
+        // the 4-bit levels come through as shades
+        display->drawImage(draw_list, display_pos, display_size, IM_COL32(0, 255, 255, 255));
     } else {
         // Show default text when no plugin is loaded
         ImVec2 text_pos(display_pos.x + display_size.x/2 - 85, display_pos.y + 20);
@@ -212,7 +194,7 @@ void DistingNTMainWindow::renderDisplay() {
     );
     
     // Reserve space for display
-    ImGui::SetCursorPosY(ImGui::GetCursorPosY() + DISPLAY_HEIGHT);
+    ImGui::SetCursorPosY(ImGui::GetCursorPosY() + std::max(DISPLAY_HEIGHT, display_size.y + 10));
 }
 
 void DistingNTMainWindow::renderControlsSection() {
@@ -807,6 +789,34 @@ void DistingNTMainWindow::renderMenuBar() {
         }
         
         if (ImGui::BeginMenu("Settings")) {
+            Display* display = emulator_ ? emulator_->getDisplay() : nullptr;
+            if (display && ImGui::BeginMenu("Display Scale")) {
+                for (int scale = Display::MIN_SCALE; scale <= getMaxDisplayScale(); scale++) {
+                    char label[8];
+                    snprintf(label, sizeof(label), "%dx", scale);
+                    if (ImGui::MenuItem(label, nullptr, getDisplayScale() == scale)) {
+                        display->setScale(scale);
+                    }
+                }
+                ImGui::EndMenu();
+            }
+            
+            if (emulator_ && emulator_->isRecordingDisplay()) {
+                const FrameRecorder::Stats& stats = emulator_->getDisplayRecorder().getStats();
+                char label[64];
+                snprintf(label, sizeof(label), "Stop Recording (%llu frames)", (unsigned long long)stats.frames);
+                if (ImGui::MenuItem(label)) {
+                    emulator_->stopDisplayRecording();
+                }
+            } else if (emulator_ && ImGui::MenuItem("Record Display...")) {
+                std::string path = FileDialog::saveFile("Record Display", "display.ntfr", {"ntfr"}, "Display Recordings");
+                std::string error;
+                if (!path.empty() && !emulator_->startDisplayRecording(path, error)) {
+                    std::cerr << error << std::endl;
+                }
+            }
+            
+            ImGui::Separator();
             
             if (ImGui::MenuItem("Exit")) {
                 // Handle application exit
@@ -953,6 +963,16 @@ bool DistingNTMainWindow::shouldUpdateDisplay() {
     return (now - last_display_update_) >= DISPLAY_INTERVAL;
 }
 
+int DistingNTMainWindow::getMaxDisplayScale() const {
+    return std::max(Display::MIN_SCALE, (int)((WINDOW_WIDTH - 20) / Display::WIDTH));
+}
+
+int DistingNTMainWindow::getDisplayScale() const {
+    Display* display = emulator_ ? emulator_->getDisplay() : nullptr;
+    int scale = display ? display->getScale() : Display::DEFAULT_SCALE;
+    return std::min(scale, getMaxDisplayScale());
+}
+
 void DistingNTMainWindow::updatePluginDisplay() {
     if (!emulator_ || !emulator_->isPluginLoaded()) {
         return;
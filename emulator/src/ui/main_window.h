@@ -82,6 +82,8 @@ private:
     // Plugin display methods
     void updatePluginDisplay();
     bool shouldUpdateDisplay();
+    int getDisplayScale() const;      // Display's integer scale, limited to the panel width
+    int getMaxDisplayScale() const;
     
     // Hardware integration setup
     void setupHardwareCallbacks();
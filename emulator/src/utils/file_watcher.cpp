@@ -1,43 +1,285 @@
 #include "file_watcher.h"
 #include <sys/stat.h>
+#include <algorithm>
 #include <iostream>
 
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <climits>
+
+namespace {
+    // One mask for every directory watch: inotify_add_watch() on a directory
+    // that is already watched replaces its mask and returns the same descriptor
+    const uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB |
+                                IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+}
+#endif
+
 FileWatcher::FileWatcher() {
+#ifdef __linux__
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ >= 0 && pipe2(wake_pipe_, O_NONBLOCK | O_CLOEXEC) != 0) {
+        close(inotify_fd_);
+        inotify_fd_ = -1;
+    }
+    if (inotify_fd_ < 0) {
+        std::cerr << "FileWatcher: inotify unavailable, polling every " << POLL_INTERVAL_MS << " ms" << std::endl;
+    }
+#endif
 }
 
 FileWatcher::~FileWatcher() {
-    stopWatching();
+    if (running_.exchange(false)) {
+#ifdef __linux__
+        if (inotify_fd_ >= 0) {
+            char byte = 0;
+            ssize_t written = write(wake_pipe_[1], &byte, 1);
+            (void)written;
+        }
+#endif
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        wake_.notify_all();
+        thread_.join();
+    }
+    unwatchAll();
+#ifdef __linux__
+    if (inotify_fd_ >= 0) {
+        close(inotify_fd_);
+        close(wake_pipe_[0]);
+        close(wake_pipe_[1]);
+    }
+#endif
+}
+
+FileWatcher::WatchId FileWatcher::watch(const std::string& path, std::function<void()> callback) {
+    Watch watch;
+    bool directory = false;
+    if (!statPath(path, watch.modified, watch.size, directory)) {
+        // A file that doesn't exist yet is fine as long as its directory does
+        time_t parent_modified;
+        long long parent_size;
+        bool parent_directory = false;
+        if (!statPath(parentOf(path), parent_modified, parent_size, parent_directory) || !parent_directory) {
+            std::cerr << "FileWatcher: Cannot watch " << path << std::endl;
+            return -1;
+        }
+    }
+    watch.path = path;
+    watch.name = directory ? std::string() : nameOf(path);
+    watch.callback = callback;
+
+#ifdef __linux__
+    if (inotify_fd_ >= 0) {
+        std::string target = directory ? path : parentOf(path);
+        watch.descriptor = inotify_add_watch(inotify_fd_, target.c_str(), WATCH_MASK);
+        if (watch.descriptor < 0) {
+            std::cerr << "FileWatcher: inotify_add_watch failed for " << target << std::endl;
+            return -1;
+        }
+    }
+#endif
+
+    WatchId id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        id = watch.id = next_id_++;
+        watches_.push_back(watch);
+    }
+    start();
+    return id;
+}
+
+void FileWatcher::unwatch(WatchId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < watches_.size(); i++) {
+        if (watches_[i].id != id) continue;
+        int descriptor = watches_[i].descriptor;
+        watches_.erase(watches_.begin() + i);
+        releaseDescriptor(descriptor);
+        break;
+    }
+    ready_.erase(std::remove(ready_.begin(), ready_.end(), id), ready_.end());
+}
+
+void FileWatcher::unwatchAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!watches_.empty()) {
+        int descriptor = watches_.back().descriptor;
+        watches_.pop_back();
+        releaseDescriptor(descriptor);
+    }
+    ready_.clear();
 }
 
 void FileWatcher::watchFile(const std::string& path, std::function<void()> callback) {
-    watched_path_ = path;
-    callback_ = callback;
-    last_modified_ = getFileModTime(path);
-    watching_ = true;
+    unwatchAll();
+    watch(path, callback);
 }
 
 void FileWatcher::stopWatching() {
-    watching_ = false;
-    watched_path_.clear();
-    callback_ = nullptr;
+    unwatchAll();
 }
 
 void FileWatcher::update() {
-    if (!watching_ || watched_path_.empty()) return;
-    
-    time_t current_mod_time = getFileModTime(watched_path_);
-    if (current_mod_time > last_modified_) {
-        last_modified_ = current_mod_time;
-        if (callback_) {
-            callback_();
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (WatchId id : ready_) {
+            for (const Watch& watch : watches_) {
+                if (watch.id == id && watch.callback) {
+                    callbacks.push_back(watch.callback);
+                }
+            }
         }
+        ready_.clear();
+    }
+    // Outside the lock, so callbacks can add or remove watches
+    for (const auto& callback : callbacks) {
+        callback();
     }
 }
 
-time_t FileWatcher::getFileModTime(const std::string& path) {
+void FileWatcher::start() {
+    if (running_.exchange(true)) return;
+    thread_ = std::thread(&FileWatcher::threadLoop, this);
+}
+
+void FileWatcher::threadLoop() {
+    int timeout_ms = -1;
+    while (running_.load()) {
+#ifdef __linux__
+        if (inotify_fd_ >= 0) {
+            // Sleeps until an event arrives or a pending change settles
+            struct pollfd fds[2];
+            fds[0].fd = inotify_fd_;
+            fds[0].events = POLLIN;
+            fds[1].fd = wake_pipe_[0];
+            fds[1].events = POLLIN;
+            poll(fds, 2, timeout_ms);
+            if (!running_.load()) break;
+            if (fds[0].revents & POLLIN) {
+                readEvents();
+            }
+            timeout_ms = flushSettled(Clock::now());
+            continue;
+        }
+#endif
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            int wait_ms = timeout_ms < 0 ? POLL_INTERVAL_MS : std::min(timeout_ms, (int)POLL_INTERVAL_MS);
+            wake_.wait_for(lock, std::chrono::milliseconds(wait_ms));
+        }
+        if (!running_.load()) break;
+        pollFiles();
+        timeout_ms = flushSettled(Clock::now());
+    }
+}
+
+void FileWatcher::readEvents() {
+#ifdef __linux__
+    alignas(struct inotify_event) char buffer[16 * (sizeof(struct inotify_event) + NAME_MAX + 1)];
+    Clock::time_point now = Clock::now();
+    for (;;) {
+        ssize_t length = read(inotify_fd_, buffer, sizeof(buffer));
+        if (length <= 0) break;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (char* p = buffer; p < buffer + length; ) {
+            const struct inotify_event* event = (const struct inotify_event*)p;
+            p += sizeof(struct inotify_event) + event->len;
+            if (event->mask & IN_Q_OVERFLOW) {
+                // Events were dropped; assume everything changed
+                for (Watch& watch : watches_) markChanged(watch, now);
+                continue;
+            }
+            for (Watch& watch : watches_) {
+                if (watch.descriptor != event->wd) continue;
+                if (!watch.name.empty() && (event->len == 0 || watch.name != event->name)) continue;
+                markChanged(watch, now);
+            }
+        }
+    }
+#endif
+}
+
+void FileWatcher::pollFiles() {
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Watch& watch : watches_) {
+        time_t modified = 0;
+        long long size = -1;
+        bool directory = false;
+        statPath(watch.path, modified, size, directory);
+        if (modified != watch.modified || size != watch.size) {
+            watch.modified = modified;
+            watch.size = size;
+            markChanged(watch, now);
+        }
+    }
+}
+
+void FileWatcher::markChanged(Watch& watch, Clock::time_point now) {
+    watch.pending = true;
+    watch.deadline = now + std::chrono::milliseconds(debounce_ms_.load());
+}
+
+int FileWatcher::flushSettled(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int next_ms = -1;
+    for (Watch& watch : watches_) {
+        if (!watch.pending) continue;
+        if (watch.deadline <= now) {
+            watch.pending = false;
+            if (std::find(ready_.begin(), ready_.end(), watch.id) == ready_.end()) {
+                ready_.push_back(watch.id);
+            }
+            continue;
+        }
+        int remaining = (int)std::chrono::duration_cast<std::chrono::milliseconds>(watch.deadline - now).count() + 1;
+        if (next_ms < 0 || remaining < next_ms) next_ms = remaining;
+    }
+    return next_ms;
+}
+
+void FileWatcher::releaseDescriptor(int descriptor) {
+    // Caller holds mutex_. Several watches can share one directory descriptor.
+#ifdef __linux__
+    if (descriptor < 0 || inotify_fd_ < 0) return;
+    for (const Watch& watch : watches_) {
+        if (watch.descriptor == descriptor) return;
+    }
+    inotify_rm_watch(inotify_fd_, descriptor);
+#else
+    (void)descriptor;
+#endif
+}
+
+bool FileWatcher::statPath(const std::string& path, time_t& modified, long long& size, bool& directory) {
     struct stat st;
-    if (stat(path.c_str(), &st) == 0) {
-        return st.st_mtime;
+    if (stat(path.c_str(), &st) != 0) {
+        modified = 0;
+        size = -1;
+        return false;
     }
-    return 0;
-}
\ No newline at end of file
+    modified = st.st_mtime;
+    size = (long long)st.st_size;
+    directory = S_ISDIR(st.st_mode);
+    return true;
+}
+
+std::string FileWatcher::parentOf(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    if (slash == std::string::npos) return ".";
+    if (slash == 0) return "/";
+    return path.substr(0, slash);
+}
+
+std::string FileWatcher::nameOf(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
@@ -2,21 +2,88 @@
 
 #include <string>
 #include <functional>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <ctime>
 
+// Watches files and directories from a background thread.
+//
+// On Linux changes arrive as inotify events, so an idle watcher costs
+// nothing; elsewhere the thread polls modification times. A file is
+// watched through its parent directory, which also catches the file being
+// replaced rather than rewritten (linkers unlink and recreate their output).
+// A directory watch fires for any change to its entries, not recursively.
+//
+// A linker writes its output in many small chunks, so events for a watch
+// are coalesced until the path has been quiet for the debounce interval;
+// the callback is then queued and run by the next update() call, on the
+// thread that owns the main loop.
+//
+// Kept to C++11 and the standard library so the VCV plugin can build it.
 class FileWatcher {
 public:
+    typedef int WatchId;
+    static constexpr int DEFAULT_DEBOUNCE_MS = 250;
+    static constexpr int POLL_INTERVAL_MS = 500;   // Fallback without inotify
+
     FileWatcher();
     ~FileWatcher();
-    
+
+    // Returns -1 if the path (or a file's parent directory) can't be watched
+    WatchId watch(const std::string& path, std::function<void()> callback);
+    void unwatch(WatchId id);
+    void unwatchAll();
+
+    // Single-file convenience: replaces any existing watches
     void watchFile(const std::string& path, std::function<void()> callback);
     void stopWatching();
+
+    // Runs the callbacks of changes that have settled
     void update();
-    
+
+    void setDebounceMs(int ms) { debounce_ms_ = ms; }
+    bool isEventDriven() const { return inotify_fd_ >= 0; }
+
 private:
-    std::string watched_path_;
-    std::function<void()> callback_;
-    time_t last_modified_ = 0;
-    bool watching_ = false;
-    
-    time_t getFileModTime(const std::string& path);
-};
\ No newline at end of file
+    typedef std::chrono::steady_clock Clock;
+
+    struct Watch {
+        WatchId id = -1;
+        std::string path;
+        std::string name;           // File name within the watched directory; empty for directories
+        std::function<void()> callback;
+        int descriptor = -1;        // inotify watch on the directory
+        time_t modified = 0;        // Polling fallback
+        long long size = -1;
+        bool pending = false;
+        Clock::time_point deadline;
+    };
+
+    std::vector<Watch> watches_;
+    std::vector<WatchId> ready_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<int> debounce_ms_{DEFAULT_DEBOUNCE_MS};
+    WatchId next_id_ = 0;
+
+    int inotify_fd_ = -1;
+    int wake_pipe_[2] = {-1, -1};
+
+    void start();
+    void threadLoop();
+    void readEvents();
+    void pollFiles();
+    void markChanged(Watch& watch, Clock::time_point now);
+    int flushSettled(Clock::time_point now);   // Returns ms until the next deadline, or -1
+    void releaseDescriptor(int descriptor);
+
+    static bool statPath(const std::string& path, time_t& modified, long long& size, bool& directory);
+    static std::string parentOf(const std::string& path);
+    static std::string nameOf(const std::string& path);
+};
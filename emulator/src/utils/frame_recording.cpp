@@ -0,0 +1,313 @@
+#include "frame_recording.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+using namespace FrameRecording;
+
+namespace {
+    const char MAGIC[4] = {'N', 'T', 'F', 'R'};
+    const int HEADER_BYTES = 12;
+    const uint8_t FLAG_KEYFRAME = 1;
+
+    enum TokenKind { ZERO_RUN = 0, LITERAL = 1, REPEAT = 2 };
+
+    // Repeats shorter than this are cheaper as literals
+    const int MIN_REPEAT = 4;
+
+    void putU16(std::vector<uint8_t>& out, uint16_t value) {
+        out.push_back((uint8_t)value);
+        out.push_back((uint8_t)(value >> 8));
+    }
+
+    void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((uint8_t)value);
+    }
+
+    bool readVarint(FILE* file, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int c = fgetc(file);
+            if (c == EOF) return false;
+            value |= (uint64_t)(c & 0x7F) << shift;
+            if (!(c & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool readVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && p < end; shift += 7) {
+            uint8_t c = *p++;
+            value |= (uint64_t)(c & 0x7F) << shift;
+            if (!(c & 0x80)) return true;
+        }
+        return false;
+    }
+
+    void encode(const uint8_t* delta, int size, std::vector<uint8_t>& out) {
+        int i = 0;
+        int literal_start = -1;
+        auto flushLiteral = [&](int end) {
+            if (literal_start < 0) return;
+            putVarint(out, (uint64_t)(end - literal_start) << 2 | LITERAL);
+            out.insert(out.end(), delta + literal_start, delta + end);
+            literal_start = -1;
+        };
+
+        while (i < size) {
+            int run = 1;
+            while (i + run < size && delta[i + run] == delta[i]) run++;
+
+            if (delta[i] == 0 && (run >= 2 || literal_start < 0)) {
+                flushLiteral(i);
+                putVarint(out, (uint64_t)run << 2 | ZERO_RUN);
+            } else if (delta[i] != 0 && run >= MIN_REPEAT) {
+                flushLiteral(i);
+                putVarint(out, (uint64_t)run << 2 | REPEAT);
+                out.push_back(delta[i]);
+            } else {
+                if (literal_start < 0) literal_start = i;
+            }
+            i += run;
+        }
+        flushLiteral(size);
+    }
+
+    // XORs the decoded delta into screen
+    bool decode(const uint8_t* p, const uint8_t* end, uint8_t* screen, int size) {
+        int i = 0;
+        while (p < end) {
+            uint64_t token;
+            if (!readVarint(p, end, token)) return false;
+            uint64_t length = token >> 2;
+            if (length > (uint64_t)(size - i)) return false;
+            switch (token & 3) {
+                case ZERO_RUN:
+                    break;
+                case LITERAL:
+                    if (length > (uint64_t)(end - p)) return false;
+                    for (uint64_t n = 0; n < length; n++) screen[i + n] ^= p[n];
+                    p += length;
+                    break;
+                case REPEAT: {
+                    if (p >= end) return false;
+                    uint8_t value = *p++;
+                    for (uint64_t n = 0; n < length; n++) screen[i + n] ^= value;
+                    break;
+                }
+                default:
+                    return false;
+            }
+            i += (int)length;
+        }
+        return i == size;
+    }
+}
+
+// --- FrameRecorder ---------------------------------------------------------
+
+FrameRecorder::FrameRecorder()
+    : previous_(FRAME_BYTES, 0), delta_(FRAME_BYTES, 0) {
+}
+
+FrameRecorder::~FrameRecorder() {
+    close();
+}
+
+bool FrameRecorder::open(const std::string& path, std::string& error) {
+    close();
+    file_ = fopen(path.c_str(), "wb");
+    if (!file_) {
+        error = "Can't create " + path + ": " + strerror(errno);
+        return false;
+    }
+    path_ = path;
+    stats_ = Stats();
+    has_previous_ = false;
+    since_keyframe_ = 0;
+
+    std::vector<uint8_t> header(MAGIC, MAGIC + 4);
+    putU16(header, VERSION);
+    putU16(header, WIDTH);
+    putU16(header, HEIGHT);
+    putU16(header, 4);
+    fwrite(header.data(), 1, header.size(), file_);
+    stats_.bytes = header.size();
+    return true;
+}
+
+void FrameRecorder::close() {
+    if (file_) {
+        fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+bool FrameRecorder::record(const uint8_t* screen, uint64_t timestamp_us, uint64_t block) {
+    if (!file_) return false;
+
+    bool keyframe = !has_previous_ || since_keyframe_ >= KEYFRAME_INTERVAL;
+    if (!keyframe && memcmp(screen, previous_.data(), FRAME_BYTES) == 0) {
+        stats_.unchanged++;
+        return true;
+    }
+
+    // A keyframe is the delta against a blank screen, i.e. the frame itself
+    for (int i = 0; i < FRAME_BYTES; i++) {
+        delta_[i] = keyframe ? screen[i] : (uint8_t)(screen[i] ^ previous_[i]);
+    }
+    memcpy(previous_.data(), screen, FRAME_BYTES);
+
+    uint64_t elapsed = has_previous_ && timestamp_us > last_timestamp_ ? timestamp_us - last_timestamp_ : 0;
+    uint64_t blocks = has_previous_ && block > last_block_ ? block - last_block_ : 0;
+    last_timestamp_ = timestamp_us;
+    last_block_ = block;
+    has_previous_ = true;
+    since_keyframe_ = keyframe ? 1 : since_keyframe_ + 1;
+
+    payload_.clear();
+    encode(delta_.data(), FRAME_BYTES, payload_);
+
+    record_.clear();
+    record_.push_back(keyframe ? FLAG_KEYFRAME : 0);
+    putVarint(record_, elapsed);
+    putVarint(record_, blocks);
+    putVarint(record_, payload_.size());
+    record_.insert(record_.end(), payload_.begin(), payload_.end());
+
+    if (fwrite(record_.data(), 1, record_.size(), file_) != record_.size()) {
+        return false;
+    }
+    if (keyframe) {
+        // Bounds what a crash can lose without syncing every frame
+        fflush(file_);
+    }
+    stats_.frames++;
+    stats_.bytes += record_.size();
+    return true;
+}
+
+// --- FrameReplayer ---------------------------------------------------------
+
+FrameReplayer::FrameReplayer()
+    : screen_(FRAME_BYTES, 0) {
+}
+
+FrameReplayer::~FrameReplayer() {
+    close();
+}
+
+bool FrameReplayer::open(const std::string& path, std::string& error) {
+    close();
+    file_ = fopen(path.c_str(), "rb");
+    if (!file_) {
+        error = "Can't open " + path + ": " + strerror(errno);
+        return false;
+    }
+
+    uint8_t header[HEADER_BYTES];
+    if (fread(header, 1, HEADER_BYTES, file_) != (size_t)HEADER_BYTES || memcmp(header, MAGIC, 4) != 0) {
+        error = path + " is not a display recording";
+        close();
+        return false;
+    }
+    uint16_t version = (uint16_t)(header[4] | header[5] << 8);
+    uint16_t width = (uint16_t)(header[6] | header[7] << 8);
+    uint16_t height = (uint16_t)(header[8] | header[9] << 8);
+    uint16_t bits = (uint16_t)(header[10] | header[11] << 8);
+    if (version != VERSION || width != WIDTH || height != HEIGHT || bits != 4) {
+        error = path + ": unsupported recording format";
+        close();
+        return false;
+    }
+
+    // Index the records; a truncated last record is dropped
+    FrameInfo info;
+    while (true) {
+        int flags = fgetc(file_);
+        if (flags == EOF) break;
+        uint64_t elapsed, blocks, size;
+        if (!readVarint(file_, elapsed) || !readVarint(file_, blocks) || !readVarint(file_, size)) break;
+        if (frames_.empty() && !(flags & FLAG_KEYFRAME)) break;
+
+        info.timestamp_us += elapsed;
+        info.block += blocks;
+        info.keyframe = (flags & FLAG_KEYFRAME) != 0;
+        info.offset = ftell(file_);
+        info.size = (uint32_t)size;
+        if (fseek(file_, (long)size, SEEK_CUR) != 0) break;
+        frames_.push_back(info);
+    }
+    // fseek past the end succeeds; the last payload must actually be there
+    fseek(file_, 0, SEEK_END);
+    long end = ftell(file_);
+    while (!frames_.empty() && frames_.back().offset + (long)frames_.back().size > end) {
+        frames_.pop_back();
+    }
+
+    if (frames_.empty()) {
+        error = path + " has no frames";
+        close();
+        return false;
+    }
+    return seek(0);
+}
+
+void FrameReplayer::close() {
+    if (file_) {
+        fclose(file_);
+        file_ = nullptr;
+    }
+    frames_.clear();
+    index_ = 0;
+    decoded_ = false;
+}
+
+bool FrameReplayer::seek(size_t index) {
+    if (index >= frames_.size()) return false;
+
+    // Continue forward from the current frame unless a keyframe is closer
+    size_t start = index;
+    while (!frames_[start].keyframe) start--;
+    if (decoded_ && index_ <= index && index_ >= start) {
+        start = index_ + 1;
+    } else {
+        std::fill(screen_.begin(), screen_.end(), 0);
+    }
+
+    for (size_t i = start; i <= index; i++) {
+        if (!apply(i)) {
+            decoded_ = false;
+            return false;
+        }
+    }
+    index_ = index;
+    decoded_ = true;
+    return true;
+}
+
+bool FrameReplayer::next() {
+    return seek(index_ + 1);
+}
+
+bool FrameReplayer::previous() {
+    return index_ > 0 && seek(index_ - 1);
+}
+
+bool FrameReplayer::apply(size_t index) {
+    const FrameInfo& info = frames_[index];
+    if (info.keyframe) {
+        std::fill(screen_.begin(), screen_.end(), 0);
+    }
+    payload_.resize(info.size);
+    if (fseek(file_, info.offset, SEEK_SET) != 0 ||
+        fread(payload_.data(), 1, info.size, file_) != info.size) {
+        return false;
+    }
+    return decode(payload_.data(), payload_.data() + payload_.size(), screen_.data(), FRAME_BYTES);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Recording of the 256x64 4-bit screen over time, for chasing UI glitches.
+//
+// A recording is a stream of records, each a frame stored as the XOR of it
+// and the previous frame, run-length coded. Most of a typical frame is
+// unchanged, so most of a delta is one long zero run. Every
+// KEYFRAME_INTERVAL recorded frames a keyframe is written instead (the
+// frame XOR zero), so a replayer can seek without decoding from the start.
+// Frames identical to the previous one are not written at all: the
+// timestamps of the frames around them say how long it was held.
+//
+// Layout, little-endian:
+//   header:  "NTFR", u16 version, u16 width, u16 height, u16 bits per pixel
+//   record:  u8 flags (bit 0: keyframe), varint microseconds since the
+//            previous record, varint audio blocks since the previous
+//            record, varint payload bytes, payload
+//   payload: tokens, each a varint (length << 2 | kind) with kind
+//            0 = run of zero bytes, 1 = literal bytes follow,
+//            2 = run of the single byte that follows
+//
+// Records are self-delimiting, so a file cut short by a crash replays up
+// to its last complete record.
+//
+// Kept to C++11 and the standard library so the VCV plugin can build it.
+
+namespace FrameRecording {
+    static constexpr int WIDTH = 256;
+    static constexpr int HEIGHT = 64;
+    static constexpr int FRAME_BYTES = WIDTH * HEIGHT / 2;
+    static constexpr uint16_t VERSION = 1;
+    static constexpr int KEYFRAME_INTERVAL = 600;   // 10 s at 60 fps
+}
+
+class FrameRecorder {
+public:
+    struct Stats {
+        uint64_t frames = 0;        // Records written
+        uint64_t unchanged = 0;     // Frames skipped as identical to the last one
+        uint64_t bytes = 0;         // File size so far
+    };
+
+    FrameRecorder();
+    ~FrameRecorder();
+
+    bool open(const std::string& path, std::string& error);
+    void close();
+    bool isOpen() const { return file_ != nullptr; }
+    const std::string& getPath() const { return path_; }
+
+    // screen: FRAME_BYTES in NT_screen layout. timestamp_us is any
+    // monotonic clock; block is the audio block counter at this frame.
+    bool record(const uint8_t* screen, uint64_t timestamp_us, uint64_t block);
+
+    const Stats& getStats() const { return stats_; }
+
+private:
+    FILE* file_ = nullptr;
+    std::string path_;
+    Stats stats_;
+
+    std::vector<uint8_t> previous_;
+    std::vector<uint8_t> delta_;
+    std::vector<uint8_t> payload_;
+    std::vector<uint8_t> record_;
+    bool has_previous_ = false;
+    uint64_t last_timestamp_ = 0;
+    uint64_t last_block_ = 0;
+    int since_keyframe_ = 0;
+};
+
+class FrameReplayer {
+public:
+    struct FrameInfo {
+        uint64_t timestamp_us = 0;  // Since the first frame
+        uint64_t block = 0;         // Audio blocks since the first frame
+        bool keyframe = false;
+        long offset = 0;            // Payload position in the file
+        uint32_t size = 0;          // Payload bytes
+    };
+
+    FrameReplayer();
+    ~FrameReplayer();
+
+    // Reads the record headers; payloads are decoded on demand
+    bool open(const std::string& path, std::string& error);
+    void close();
+
+    size_t getFrameCount() const { return frames_.size(); }
+    const FrameInfo& getInfo(size_t index) const { return frames_[index]; }
+
+    // Decodes frame `index`, from the nearest keyframe before it if needed
+    bool seek(size_t index);
+    bool next();
+    bool previous();
+
+    size_t getIndex() const { return index_; }
+    const uint8_t* getScreen() const { return screen_.data(); }
+
+private:
+    FILE* file_ = nullptr;
+    std::vector<FrameInfo> frames_;
+    std::vector<uint8_t> screen_;
+    std::vector<uint8_t> payload_;
+    size_t index_ = 0;
+    bool decoded_ = false;
+
+    bool apply(size_t index);
+};
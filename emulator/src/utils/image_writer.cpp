@@ -0,0 +1,249 @@
+#include "image_writer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace {
+    const int WIDTH = 256;
+    const int HEIGHT = 64;
+    const int ROW_BYTES = WIDTH / 2;
+
+    void putU16(std::vector<uint8_t>& out, uint16_t value) {
+        out.push_back((uint8_t)value);
+        out.push_back((uint8_t)(value >> 8));
+    }
+
+    void putU32BE(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back((uint8_t)(value >> 24));
+        out.push_back((uint8_t)(value >> 16));
+        out.push_back((uint8_t)(value >> 8));
+        out.push_back((uint8_t)value);
+    }
+
+    uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+        static uint32_t table[256];
+        static bool built = false;
+        if (!built) {
+            for (uint32_t n = 0; n < 256; n++) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                table[n] = c;
+            }
+            built = true;
+        }
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    void putChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+        putU32BE(out, (uint32_t)data.size());
+        size_t start = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data.begin(), data.end());
+        putU32BE(out, crc32(&out[start], out.size() - start));
+    }
+
+    // One pixel of a screen, 0-15
+    inline uint8_t pixel(const uint8_t* screen, int x, int y) {
+        uint8_t pair = screen[y * ROW_BYTES + x / 2];
+        return (x & 1) ? (pair & 0x0F) : (pair >> 4);
+    }
+
+    bool writeFile(const std::string& path, const std::vector<uint8_t>& data, std::string& error) {
+        FILE* file = fopen(path.c_str(), "wb");
+        if (!file) {
+            error = "Can't create " + path + ": " + strerror(errno);
+            return false;
+        }
+        bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+        ok = fclose(file) == 0 && ok;
+        if (!ok) error = "Write failed: " + path;
+        return ok;
+    }
+}
+
+bool ImageWriter::writePng(const std::string& path, const uint8_t* screen, int scale, std::string& error) {
+    scale = std::max(1, scale);
+    const int width = WIDTH * scale;
+    const int height = HEIGHT * scale;
+    const int row_bytes = width / 2;
+
+    // Filter type 0 then 4-bit gray, high nibble first as on the screen
+    std::vector<uint8_t> raw;
+    raw.reserve((size_t)(row_bytes + 1) * height);
+    for (int y = 0; y < height; y++) {
+        raw.push_back(0);
+        for (int x = 0; x < width; x += 2) {
+            uint8_t even = pixel(screen, x / scale, y / scale);
+            uint8_t odd = pixel(screen, (x + 1) / scale, y / scale);
+            raw.push_back((uint8_t)(even << 4 | odd));
+        }
+    }
+
+    // zlib stream of stored deflate blocks
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    uint32_t a = 1, b = 0;
+    for (size_t pos = 0; pos < raw.size() || pos == 0; ) {
+        size_t n = std::min<size_t>(65535, raw.size() - pos);
+        bool last = pos + n == raw.size();
+        zlib.push_back(last ? 1 : 0);
+        putU16(zlib, (uint16_t)n);
+        putU16(zlib, (uint16_t)~n);
+        for (size_t i = pos; i < pos + n; i++) {
+            a = (a + raw[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        zlib.insert(zlib.end(), raw.begin() + pos, raw.begin() + pos + n);
+        pos += n;
+        if (last) break;
+    }
+    putU32BE(zlib, b << 16 | a);
+
+    std::vector<uint8_t> header;
+    putU32BE(header, (uint32_t)width);
+    putU32BE(header, (uint32_t)height);
+    header.push_back(4);    // Bit depth
+    header.push_back(0);    // Grayscale
+    header.push_back(0);    // Deflate
+    header.push_back(0);    // Adaptive filtering
+    header.push_back(0);    // No interlace
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    putChunk(png, "IHDR", header);
+    putChunk(png, "IDAT", zlib);
+    putChunk(png, "IEND", std::vector<uint8_t>());
+    return writeFile(path, png, error);
+}
+
+// --- GifWriter -------------------------------------------------------------
+
+GifWriter::GifWriter() {
+}
+
+GifWriter::~GifWriter() {
+    close();
+}
+
+bool GifWriter::open(const std::string& path, int scale, std::string& error) {
+    close();
+    file_ = fopen(path.c_str(), "wb");
+    if (!file_) {
+        error = "Can't create " + path + ": " + strerror(errno);
+        return false;
+    }
+    scale_ = std::max(1, scale);
+
+    std::vector<uint8_t> header = {'G', 'I', 'F', '8', '9', 'a'};
+    putU16(header, (uint16_t)(WIDTH * scale_));
+    putU16(header, (uint16_t)(HEIGHT * scale_));
+    header.push_back(0xF3);     // Global 16-colour table, 8-bit colour resolution
+    header.push_back(0);        // Background colour
+    header.push_back(0);        // Square pixels
+    for (int level = 0; level < 16; level++) {
+        uint8_t gray = (uint8_t)(level * 17);
+        header.insert(header.end(), {gray, gray, gray});
+    }
+    // Netscape extension: loop forever
+    header.insert(header.end(), {0x21, 0xFF, 0x0B, 'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0',
+                                 0x03, 0x01, 0x00, 0x00, 0x00});
+    return fwrite(header.data(), 1, header.size(), file_) == header.size();
+}
+
+bool GifWriter::addFrame(const uint8_t* screen, int delay_cs) {
+    if (!file_) return false;
+
+    const int width = WIDTH * scale_;
+    const int height = HEIGHT * scale_;
+    indices_.resize((size_t)width * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            indices_[(size_t)y * width + x] = pixel(screen, x / scale_, y / scale_);
+        }
+    }
+
+    std::vector<uint8_t> frame;
+    // Graphic control extension: delay, no transparency
+    frame.insert(frame.end(), {0x21, 0xF9, 0x04, 0x00});
+    putU16(frame, (uint16_t)std::max(0, std::min(delay_cs, 65535)));
+    frame.insert(frame.end(), {0x00, 0x00});
+    // Image descriptor: the whole canvas, no local colour table
+    frame.push_back(0x2C);
+    putU16(frame, 0);
+    putU16(frame, 0);
+    putU16(frame, (uint16_t)width);
+    putU16(frame, (uint16_t)height);
+    frame.push_back(0);
+
+    encodeLzw();
+    frame.push_back(4);     // Minimum code size for 16 colours
+    for (size_t pos = 0; pos < codes_.size(); pos += 255) {
+        size_t n = std::min<size_t>(255, codes_.size() - pos);
+        frame.push_back((uint8_t)n);
+        frame.insert(frame.end(), codes_.begin() + pos, codes_.begin() + pos + n);
+    }
+    frame.push_back(0);
+
+    return fwrite(frame.data(), 1, frame.size(), file_) == frame.size();
+}
+
+bool GifWriter::close() {
+    if (!file_) return true;
+    bool ok = fputc(0x3B, file_) != EOF;
+    ok = fclose(file_) == 0 && ok;
+    file_ = nullptr;
+    return ok;
+}
+
+void GifWriter::encodeLzw() {
+    const int MIN_CODE_SIZE = 4;
+    const int CLEAR = 1 << MIN_CODE_SIZE;
+    const int END = CLEAR + 1;
+    const int MAX_CODES = 4096;
+
+    // Dictionary as a trie: child[code * 16 + index] is the code for
+    // string(code) + index, or 0 if not yet added
+    std::vector<uint16_t> child((size_t)MAX_CODES * 16, 0);
+    int next_code = END + 1;
+    int code_size = MIN_CODE_SIZE + 1;
+
+    codes_.clear();
+    uint32_t bit_buffer = 0;
+    int bit_count = 0;
+    auto emit = [&](int code) {
+        bit_buffer |= (uint32_t)code << bit_count;
+        bit_count += code_size;
+        while (bit_count >= 8) {
+            codes_.push_back((uint8_t)bit_buffer);
+            bit_buffer >>= 8;
+            bit_count -= 8;
+        }
+    };
+
+    emit(CLEAR);
+    int current = indices_.empty() ? -1 : indices_[0];
+    for (size_t i = 1; i < indices_.size(); i++) {
+        uint8_t index = indices_[i];
+        uint16_t& slot = child[(size_t)current * 16 + index];
+        if (slot) {
+            current = slot;
+            continue;
+        }
+        emit(current);
+        if (next_code < MAX_CODES) {
+            slot = (uint16_t)next_code;
+            // The decoder widens its codes one step behind us
+            if (next_code == (1 << code_size) && code_size < 12) code_size++;
+            next_code++;
+        } else {
+            emit(CLEAR);
+            std::fill(child.begin(), child.end(), 0);
+            next_code = END + 1;
+            code_size = MIN_CODE_SIZE + 1;
+        }
+        current = index;
+    }
+    if (current >= 0) emit(current);
+    emit(END);
+    if (bit_count > 0) codes_.push_back((uint8_t)bit_buffer);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Writes 256x64 4-bit screens (NT_screen layout) as images, scaled up by
+// an integer factor. No image library: PNGs are 4-bit grayscale with
+// stored (uncompressed) deflate blocks, GIFs use a 16-gray palette and
+// their usual LZW coding.
+class ImageWriter {
+public:
+    static bool writePng(const std::string& path, const uint8_t* screen, int scale, std::string& error);
+};
+
+// Animated GIF, one screen per addFrame(), looping forever
+class GifWriter {
+public:
+    GifWriter();
+    ~GifWriter();
+
+    bool open(const std::string& path, int scale, std::string& error);
+    // delay_cs: how long the frame shows, in hundredths of a second
+    bool addFrame(const uint8_t* screen, int delay_cs);
+    bool close();
+
+private:
+    FILE* file_ = nullptr;
+    int scale_ = 1;
+    std::vector<uint8_t> indices_;
+    std::vector<uint8_t> codes_;
+
+    void encodeLzw();
+};
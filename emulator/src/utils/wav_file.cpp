@@ -0,0 +1,234 @@
+#include "wav_file.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    const uint16_t FORMAT_PCM = 1;
+    const uint16_t FORMAT_FLOAT = 3;
+    const uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+    uint16_t readU16(const uint8_t* p) {
+        return (uint16_t)(p[0] | (p[1] << 8));
+    }
+
+    uint32_t readU32(const uint8_t* p) {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    void writeU16(std::ofstream& out, uint16_t value) {
+        uint8_t bytes[2] = {(uint8_t)value, (uint8_t)(value >> 8)};
+        out.write(reinterpret_cast<const char*>(bytes), 2);
+    }
+
+    void writeU32(std::ofstream& out, uint32_t value) {
+        uint8_t bytes[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+        out.write(reinterpret_cast<const char*>(bytes), 4);
+    }
+
+    float decodeSample(const uint8_t* p, uint16_t format, uint16_t bits) {
+        if (format == FORMAT_FLOAT) {
+            if (bits == 32) {
+                uint32_t raw = readU32(p);
+                float value;
+                std::memcpy(&value, &raw, sizeof(value));
+                return value;
+            }
+            uint64_t raw = (uint64_t)readU32(p) | ((uint64_t)readU32(p + 4) << 32);
+            double value;
+            std::memcpy(&value, &raw, sizeof(value));
+            return (float)value;
+        }
+
+        switch (bits) {
+            case 8:
+                return (p[0] - 128) / 128.0f;
+            case 16:
+                return (int16_t)readU16(p) / 32768.0f;
+            case 24: {
+                int32_t value = (int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 24) >> 8;
+                return value / 8388608.0f;
+            }
+            default:
+                return (int32_t)readU32(p) / 2147483648.0f;
+        }
+    }
+}
+
+bool WavReader::open(const std::string& path, std::string& error) {
+    in_.open(path, std::ios::binary);
+    if (!in_) {
+        error = "Cannot open " + path;
+        return false;
+    }
+    in_.seekg(0, std::ios::end);
+    uint64_t file_size = (uint64_t)in_.tellg();
+    in_.seekg(0);
+
+    uint8_t header[12];
+    if (file_size < 12 || !in_.read(reinterpret_cast<char*>(header), 12) ||
+        std::memcmp(header, "RIFF", 4) != 0 || std::memcmp(header + 8, "WAVE", 4) != 0) {
+        error = path + " is not a RIFF/WAVE file";
+        return false;
+    }
+
+    // Walk the chunk headers only; the payload is read block by block later
+    uint64_t payload_offset = 0;
+    uint64_t payload_size = 0;
+    bool have_payload = false;
+
+    uint64_t pos = 12;
+    while (pos + 8 <= file_size) {
+        uint8_t chunk[8];
+        in_.seekg((std::streamoff)pos);
+        if (!in_.read(reinterpret_cast<char*>(chunk), 8)) break;
+        uint64_t size = readU32(chunk + 4);
+        uint64_t available = std::min(size, file_size - pos - 8);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && available >= 16) {
+            uint8_t fmt[40] = {};
+            in_.read(reinterpret_cast<char*>(fmt), (std::streamsize)std::min<uint64_t>(available, sizeof(fmt)));
+            format_ = readU16(fmt);
+            channels_ = readU16(fmt + 2);
+            sample_rate_ = readU32(fmt + 4);
+            bits_ = readU16(fmt + 14);
+            if (format_ == FORMAT_EXTENSIBLE && available >= 26) {
+                // First two bytes of the sub-format GUID carry the real format tag
+                format_ = readU16(fmt + 24);
+            }
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            payload_offset = pos + 8;
+            payload_size = available;
+            have_payload = true;
+        }
+
+        pos += 8 + size + (size & 1);
+    }
+
+    bool supported = (format_ == FORMAT_PCM && (bits_ == 8 || bits_ == 16 || bits_ == 24 || bits_ == 32)) ||
+                     (format_ == FORMAT_FLOAT && (bits_ == 32 || bits_ == 64));
+    if (!supported || channels_ == 0) {
+        error = path + ": unsupported sample format (tag " + std::to_string(format_) +
+                ", " + std::to_string(bits_) + " bits)";
+        return false;
+    }
+    if (!have_payload) {
+        error = path + " has no data chunk";
+        return false;
+    }
+
+    frames_ = payload_size / (bits_ / 8) / channels_;
+    position_ = 0;
+    in_.clear();
+    in_.seekg((std::streamoff)payload_offset);
+    return true;
+}
+
+size_t WavReader::read(float* samples, size_t frames) {
+    frames = (size_t)std::min<uint64_t>(frames, frames_ - position_);
+    if (frames == 0) return 0;
+
+    size_t bytes_per_sample = bits_ / 8;
+    size_t count = frames * channels_;
+    buffer_.resize(count * bytes_per_sample);
+    if (!in_.read(reinterpret_cast<char*>(buffer_.data()), (std::streamsize)buffer_.size())) {
+        // Truncated since open(); treat the rest as missing
+        count = (size_t)in_.gcount() / bytes_per_sample;
+        count -= count % channels_;
+        frames = count / channels_;
+        frames_ = position_ + frames;
+    }
+    for (size_t i = 0; i < count; i++) {
+        samples[i] = decodeSample(buffer_.data() + i * bytes_per_sample, format_, bits_);
+    }
+    position_ += frames;
+    return frames;
+}
+
+WavWriter::~WavWriter() {
+    std::string error;
+    close(error);
+}
+
+bool WavWriter::open(const std::string& path, int channels, int sample_rate, int bits, std::string& error) {
+    if (bits != 16 && bits != 24 && bits != 32) {
+        error = "Unsupported output bit depth " + std::to_string(bits);
+        return false;
+    }
+
+    out_.open(path, std::ios::binary);
+    if (!out_) {
+        error = "Cannot create " + path;
+        return false;
+    }
+    path_ = path;
+    channels_ = channels;
+    bits_ = bits;
+    data_bytes_ = 0;
+
+    uint16_t bytes_per_sample = (uint16_t)(bits / 8);
+
+    // RIFF and data sizes are patched in by close()
+    out_.write("RIFF", 4);
+    writeU32(out_, 0);
+    out_.write("WAVE", 4);
+
+    out_.write("fmt ", 4);
+    writeU32(out_, 16);
+    writeU16(out_, bits == 32 ? FORMAT_FLOAT : FORMAT_PCM);
+    writeU16(out_, (uint16_t)channels);
+    writeU32(out_, (uint32_t)sample_rate);
+    writeU32(out_, (uint32_t)sample_rate * channels * bytes_per_sample);
+    writeU16(out_, (uint16_t)(channels * bytes_per_sample));
+    writeU16(out_, (uint16_t)bits);
+
+    out_.write("data", 4);
+    writeU32(out_, 0);
+    return (bool)out_;
+}
+
+bool WavWriter::write(const float* samples, size_t frames) {
+    size_t count = frames * channels_;
+    size_t bytes_per_sample = bits_ / 8;
+    buffer_.resize(count * bytes_per_sample);
+
+    uint8_t* p = buffer_.data();
+    for (size_t i = 0; i < count; i++) {
+        float sample = samples[i];
+        if (bits_ == 32) {
+            uint32_t raw;
+            std::memcpy(&raw, &sample, sizeof(raw));
+            p[0] = (uint8_t)raw; p[1] = (uint8_t)(raw >> 8); p[2] = (uint8_t)(raw >> 16); p[3] = (uint8_t)(raw >> 24);
+        } else {
+            float clamped = std::max(-1.0f, std::min(1.0f, sample));
+            int32_t full_scale = bits_ == 16 ? 32767 : 8388607;
+            int32_t value = (int32_t)std::lround(clamped * full_scale);
+            p[0] = (uint8_t)value;
+            p[1] = (uint8_t)(value >> 8);
+            if (bits_ == 24) p[2] = (uint8_t)(value >> 16);
+        }
+        p += bytes_per_sample;
+    }
+    out_.write(reinterpret_cast<const char*>(buffer_.data()), (std::streamsize)buffer_.size());
+    data_bytes_ += buffer_.size();
+    return (bool)out_;
+}
+
+bool WavWriter::close(std::string& error) {
+    if (!out_.is_open()) return true;
+
+    uint32_t data_size = (uint32_t)std::min<uint64_t>(data_bytes_, UINT32_MAX - 36);
+    out_.seekp(4);
+    writeU32(out_, 36 + data_size);
+    out_.seekp(40);
+    writeU32(out_, data_size);
+
+    bool ok = (bool)out_;
+    out_.close();
+    if (!ok) {
+        error = "Failed writing " + path_;
+    }
+    return ok;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Streaming WAV input, a block of interleaved frames at a time, normalised
+// to [-1, 1]. Reads 8/16/24/32-bit PCM and 32/64-bit float, including
+// WAVE_FORMAT_EXTENSIBLE.
+class WavReader {
+public:
+    bool open(const std::string& path, std::string& error);
+
+    int getChannels() const { return channels_; }
+    int getSampleRate() const { return (int)sample_rate_; }
+    uint64_t getFrames() const { return frames_; }
+
+    // Decodes up to `frames` frames into `samples`; fewer at the end of the data
+    size_t read(float* samples, size_t frames);
+
+private:
+    std::ifstream in_;
+    uint16_t format_ = 0;
+    uint16_t bits_ = 0;
+    uint16_t channels_ = 0;
+    uint32_t sample_rate_ = 0;
+    uint64_t frames_ = 0;
+    uint64_t position_ = 0;
+    std::vector<uint8_t> buffer_;
+};
+
+// Streaming WAV output: 16/24-bit PCM or, for bits == 32, IEEE float.
+// The header's sizes are filled in by close().
+class WavWriter {
+public:
+    ~WavWriter();
+
+    bool open(const std::string& path, int channels, int sample_rate, int bits, std::string& error);
+
+    // Appends `frames` interleaved frames
+    bool write(const float* samples, size_t frames);
+    bool close(std::string& error);
+
+private:
+    std::ofstream out_;
+    std::string path_;
+    int channels_ = 0;
+    int bits_ = 0;
+    uint64_t data_bytes_ = 0;
+    std::vector<uint8_t> buffer_;
+};
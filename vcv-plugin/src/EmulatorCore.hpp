@@ -8,6 +8,8 @@
 
 // Import Disting NT API types
 #include <distingnt/api.h>
+#include "log/RtLog.hpp"
+#include "display/VCVDisplayBuffer.hpp"
 
 // Forward declaration for PluginManager
 class PluginManager;
@@ -54,59 +56,6 @@ struct VCVHardwareState {
     std::array<bool, 3> pot_pressed{false, false, false}; // Pot press states (encoders)
 };
 
-// Display buffer for 256x64 OLED
-struct VCVDisplayBuffer {
-    std::array<uint8_t, (256 * 64) / 2> pixels{};  // 4-bit grayscale, 2 pixels per byte
-    bool dirty = true;
-    
-    void clear() {
-        pixels.fill(0);
-        dirty = true;
-    }
-    
-    // Legacy method for backwards compatibility (threshold at 8)
-    void setPixel(int x, int y, bool on) {
-        setPixelGray(x, y, on ? 15 : 0);
-    }
-    
-    // New method for 4-bit grayscale (0-15)
-    void setPixelGray(int x, int y, uint8_t gray_value) {
-        if (x < 0 || x >= 256 || y < 0 || y >= 64) return;
-        
-        int byte_idx = y * 128 + x / 2;
-        gray_value = gray_value & 0x0F;  // Ensure 4-bit value
-        
-        if (x & 1) {
-            // Odd x: low nibble
-            pixels[byte_idx] = (pixels[byte_idx] & 0xF0) | gray_value;
-        } else {
-            // Even x: high nibble
-            pixels[byte_idx] = (pixels[byte_idx] & 0x0F) | (gray_value << 4);
-        }
-        dirty = true;
-    }
-    
-    // Legacy method for backwards compatibility
-    bool getPixel(int x, int y) const {
-        return getPixelGray(x, y) > 7;  // Threshold at 8
-    }
-    
-    // New method to get 4-bit grayscale value
-    uint8_t getPixelGray(int x, int y) const {
-        if (x < 0 || x >= 256 || y < 0 || y >= 64) return 0;
-        
-        int byte_idx = y * 128 + x / 2;
-        
-        if (x & 1) {
-            // Odd x: low nibble
-            return pixels[byte_idx] & 0x0F;
-        } else {
-            // Even x: high nibble
-            return (pixels[byte_idx] >> 4) & 0x0F;
-        }
-    }
-};
-
 // Plugin instance wrapper for VCV
 struct VCVPluginInstance {
     void* handle = nullptr;
@@ -224,7 +173,7 @@ private:
 // Implementations
 inline EmulatorCore::EmulatorCore() {
     // Initialize NT globals structure
-    nt_globals_.maxFramesPerStep = 4; // Process in 4-sample blocks
+    nt_globals_.maxFramesPerStep = 64; // Largest selectable step block size
     work_buffer_.resize(1024); // 1KB work buffer
     nt_globals_.workBuffer = work_buffer_.data();
     nt_globals_.workBufferSizeBytes = work_buffer_.size() * sizeof(float);
@@ -346,12 +295,12 @@ inline void EmulatorCore::processAudio(float* buses, int numFramesBy4) {
             current_algorithm_->factory->step(current_algorithm_->algorithm, buses, numFramesBy4);
         } catch (const std::exception& e) {
             // Plugin crashed during audio processing - disable it
-            printf("Plugin crashed during audio processing: %s\n", e.what());
+            RT_WARN(Plugin, "Plugin crashed during audio processing: %s", e.what());
             // Clear the current algorithm to prevent further crashes
             current_algorithm_ = nullptr;
         } catch (...) {
             // Plugin crashed during audio processing - disable it
-            printf("Plugin crashed during audio processing: unknown error\n");
+            RT_WARN(Plugin, "Plugin crashed during audio processing: unknown error");
             // Clear the current algorithm to prevent further crashes
             current_algorithm_ = nullptr;
         }
@@ -412,7 +361,7 @@ inline void EmulatorCore::processHardwareChanges(_NT_factory* factory, _NT_algor
                     try {
                         factory->parameterChanged(algorithm, i);
                     } catch (...) {
-                        printf("Plugin crashed during parameterChanged\n");
+                        RT_WARN(Plugin, "Plugin crashed during parameterChanged");
                         return;
                     }
                 }
@@ -645,7 +594,7 @@ inline void EmulatorCore::sendCustomUiEvents(_NT_factory* factory, _NT_algorithm
         try {
             factory->customUi(algorithm, uiData);
         } catch (...) {
-            INFO("Plugin crashed during customUi");
+            RT_WARN(Plugin, "Plugin crashed during customUi");
         }
     }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "plugin.hpp"
 #include "algorithms/Algorithm.hpp"
 #include "dsp/BusSystem.hpp"
+#include "dsp/RoutingPlan.hpp"
 #include "EmulatorCore.hpp"
 #include "json_bridge.h"
 #include "EncoderParamQuantity.hpp"
@@ -16,34 +17,30 @@
 // New modular components
 #include "plugin/PluginManager.hpp"
 #include "plugin/PluginExecutor.hpp"
+#include "plugin/PluginWorker.hpp"
+#include "plugin/HardwareLoadEstimator.hpp"
+#include "plugin/MemoryGuard.hpp"
 #include "parameter/ParameterSystem.hpp"
 #include "menu/MenuSystem.hpp"
 #include "midi/MidiProcessor.hpp"
 #include "EmulatorConstants.hpp"
 #include "api/NTApiWrapper.hpp"
 #include "api/VirtualSdCard.hpp"
+#include "api/VirtualScalaLibrary.hpp"
+#include "../../emulator/src/utils/file_watcher.h"
+#include "api/NTApiContext.hpp"
+#include "log/RtLog.hpp"
 #include "display/IDisplayDataProvider.hpp"
 #include "display/DisplayRenderer.hpp"
+#include "display/DisplayScheduler.hpp"
 #include <componentlibrary.hpp>
 #include <osdialog.h>
-#include <map>
 #include <cstring>
+#include <atomic>
 
 struct EmulatorModule;
-static EmulatorModule* g_currentModule = nullptr;
 
-// NT_screen buffer definition for the VCV plugin
-__attribute__((visibility("default"))) uint8_t NT_screen[128 * 64];
-
-// NT_globals structure for the VCV plugin
-static _NT_globals vcv_nt_globals = {
-    .sampleRate = 48000,
-    .maxFramesPerStep = 256,
-    .workBuffer = nullptr,
-    .workBufferSizeBytes = 0
-};
-
-__attribute__((visibility("default"))) const _NT_globals NT_globals = vcv_nt_globals;
+// NT_screen and NT_globals are defined in api/NTApiContext.cpp
 
 // Simple C API wrapper functions for plugins to use (minimal implementation)
 // External API provider function
@@ -196,6 +193,26 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     std::unique_ptr<ParameterSystem> parameterSystem;
     std::unique_ptr<MenuSystem> menuSystem;
     std::unique_ptr<MidiProcessor> midiProcessor;
+    std::unique_ptr<PluginWorker> pluginWorker;
+    
+    // Calls the plugin's draw() at a fixed rate, off the UI thread
+    std::unique_ptr<DisplayScheduler> displayScheduler;
+    
+    // State behind the NT_* API for this instance (screen, globals, MIDI sink)
+    NTApiContext apiContext;
+    
+    // Pipelined mode: step() runs on pluginWorker one block behind the engine.
+    // Requested from the UI thread, switched by process() at a block boundary.
+    std::atomic<bool> pipelineRequested{false};
+    bool pipelineActive = false;
+    
+    // Hot swap: fade from the old build to the new one over this long (0 = cut)
+    float hotSwapCrossfadeMs = 0.f;
+    
+    // Plugin rebuilds (when hotSwapOnRebuild) and SD card edits, delivered
+    // on the UI thread from EmulatorWidget::step()
+    FileWatcher fileWatcher;
+    bool hotSwapOnRebuild = false;
     
     // MIDI activity divider
     dsp::ClockDivider midiActivityDivider;
@@ -220,6 +237,7 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     
     // Display state
     bool displayDirty = true;
+    OLEDLook displayLook = OLEDLook::PLAIN;
     
     // Menu system state
     enum MenuMode {
@@ -253,33 +271,17 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     
     // Debug data for display
     
-    // Bus routing maps
-    std::array<int, 28> busInputMap;
-    std::array<int, 28> busOutputMap;
     bool routingDirty = false;
     
-    // Parameter-based routing structures
-    struct InputRouting {
-        int paramIndex;      // Which parameter controls this routing
-        int busIndex;        // Target bus (0-27)
-        bool isCV;           // Audio or CV input
-    };
-    
-    struct OutputRouting {
-        int paramIndex;           // Which parameter controls this routing
-        int busIndex;             // Source bus (0-27)
-        bool isCV;                // Audio or CV output
-        bool hasOutputMode;       // Has associated output mode parameter
-        int outputModeParamIndex; // Index of output mode parameter
-    };
-    
-    // Maps from parameter index to routing info
-    std::map<int, InputRouting> paramInputRouting;
-    std::map<int, OutputRouting> paramOutputRouting;
+    // Parameter-based routing: rebuilt on the UI thread when routing parameters
+    // change, picked up by the engine thread at the next block boundary
+    RoutingPlanPublisher routingPlans;
+    const RoutingPlan* activeRouting = nullptr;
+    std::atomic<bool> routingPlanDirty{false};
     
-    // Sample accumulation for 4-sample processing blocks
-    int sampleCounter = 0;
-    static constexpr int BLOCK_SIZE = 4;
+    // Frames buffered per step() call (4/16/32/64). Set from the UI thread and
+    // applied by process() at the next block boundary.
+    std::atomic<int> blockSize{BusSystem::MIN_BLOCK_FRAMES};
     
     // Trigger detectors for buttons and encoders
     dsp::SchmittTrigger buttonTriggers[4];
@@ -291,8 +293,6 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     EmulatorModule() {
         config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
         
-        g_currentModule = this;
-        
         // Configure parameters
         configParam(POT_L_PARAM, 0.f, 1.f, 0.5f, "Pot L");
         configParam(POT_C_PARAM, 0.f, 1.f, 0.5f, "Pot C");  
@@ -345,9 +345,8 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         // Initialize emulator core
         emulatorCore.initialize(APP->engine->getSampleRate());
         
-        // Initialize bus routing matrices
-        busInputMap.fill(-1);
-        busOutputMap.fill(-1);
+        // Start with an empty routing plan
+        activeRouting = &routingPlans.acquire();
         
         // Initialize encoder step tracking to current parameter values
         // (This ensures first delta calculation works correctly)
@@ -357,6 +356,9 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         // Configure MIDI activity divider
         midiActivityDivider.setDivision(512);
         
+        // Forwards RT_* records from the engine threads to the log
+        RtLog::startDrain();
+        
         // Initialize new modular components (C++11 compatible)
         pluginManager.reset(new PluginManager());
         pluginManager->addObserver(this);  // Register for plugin state notifications
@@ -364,6 +366,17 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         parameterSystem.reset(new ParameterSystem(pluginManager.get()));
         menuSystem.reset(new MenuSystem(parameterSystem.get()));
         midiProcessor.reset(new MidiProcessor(pluginExecutor.get()));
+        pluginWorker.reset(new PluginWorker(&EmulatorModule::pipelinedStep, this));
+        displayScheduler.reset(new DisplayScheduler(pluginExecutor.get(), &apiContext));
+        
+        // Per-instance NT API context
+        apiContext.module = this;
+        apiContext.midiSink = midiProcessor.get();
+        apiContext.globals.maxFramesPerStep = getBlockSize();
+        NTApi::setSampleRate(&apiContext, (uint32_t)APP->engine->getSampleRate());
+        NTApi::initApiInterface(&apiContext);
+        pluginExecutor->setApiContext(&apiContext);
+        displayScheduler->start();
         
         // Initialize parameter system routing matrix with parameter defaults
         // NOTE: At construction time, no plugin is loaded yet, so parameterSystem will have no parameters
@@ -395,8 +408,13 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     }
     
     ~EmulatorModule() {
-        if (g_currentModule == this) {
-            g_currentModule = nullptr;
+        // Stop the worker and display threads before the plugin and buses go away
+        if (pluginWorker) {
+            pluginWorker->stop();
+        }
+        if (displayScheduler) {
+            displayScheduler->stop();
+            displayScheduler->stopRecording();
         }
         
         // Clean up pending parameter values if any
@@ -412,6 +430,8 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         if (pluginManager) {
             pluginManager->removeObserver(this);
         }
+        
+        RtLog::stopDrain();
     }
     
     // MIDI setup method - simplified for modular architecture
@@ -444,9 +464,16 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     }
     
     void unloadPlugin() {
+        NTApi::ScopedContext apiScope(&apiContext);
         menuMode = MENU_OFF;
         parameterSystem->clearParameters();
+        pluginWorker->pause();
+        displayScheduler->pause();
+        pluginManager->clearSlots();
+        parameterSystem->clearSlotParameters();
         pluginManager->unloadPlugin();
+        displayScheduler->resume();
+        pluginWorker->resume();
         displayDirty = true;
     }
     
@@ -457,10 +484,77 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         }
         
         // Use PluginManager's reload method which properly handles observer notifications
+        NTApi::ScopedContext apiScope(&apiContext);
+        pluginWorker->pause();
+        displayScheduler->pause();
         pluginManager->reloadPlugin();
+        displayScheduler->resume();
+        pluginWorker->resume();
         displayDirty = true;
     }
     
+    // Reload the plugin from disk without stopping audio (see PluginManager::beginHotSwap)
+    void hotSwapPlugin() {
+        if (!isPluginLoaded() || pluginManager->isHotSwapping()) {
+            return;
+        }
+        if (!pluginManager->beginHotSwap(&apiContext, parameterSystem->getRoutingMatrix().data(), hotSwapCrossfadeMs)) {
+            reloadPlugin();
+        }
+        displayDirty = true;
+    }
+    
+    void setHotSwapOnRebuild(bool enabled) {
+        hotSwapOnRebuild = enabled;
+        updateFileWatches();
+    }
+    
+    void setVirtualSdCardPath(const std::string& path) {
+        virtualSdCardPath = path;
+        VirtualSdCard::getInstance().setRootPath(path);
+        updateFileWatches();
+    }
+    
+    void updateFileWatches() {
+        fileWatcher.unwatchAll();
+        if (hotSwapOnRebuild && isPluginLoaded()) {
+            fileWatcher.watch(pluginManager->getPluginPath(), [this]() {
+                INFO("NtEmu: Plugin rebuilt, hot swapping");
+                hotSwapPlugin();
+            });
+        }
+        if (!virtualSdCardPath.empty()) {
+            // Sample folders are one level down, so watch each of them too
+            std::function<void()> rescan = [this]() {
+                INFO("NtEmu: Virtual SD card changed, rescanning");
+                VirtualSdCard::getInstance().rescan();
+                VirtualScalaLibrary::getInstance().rescan();
+                updateFileWatches();
+            };
+            std::string samplesPath = virtualSdCardPath + "/samples";
+            if (rack::system::isDirectory(samplesPath)) {
+                fileWatcher.watch(samplesPath, rescan);
+                for (const std::string& entry : rack::system::getEntries(samplesPath)) {
+                    if (rack::system::isDirectory(entry)) {
+                        fileWatcher.watch(entry, rescan);
+                    }
+                }
+            }
+            std::string sclPath = virtualSdCardPath + "/scl";
+            if (rack::system::isDirectory(sclPath)) {
+                fileWatcher.watch(sclPath, rescan);
+            }
+        }
+    }
+    
+    // UI thread: finish a hot swap once the audio thread has switched
+    void updateHotSwap() {
+        if (!pluginManager->isHotSwapping()) return;
+        if (pluginManager->updateHotSwap() == PluginManager::HotSwapResult::NeedsColdReload) {
+            reloadPlugin();
+        }
+    }
+    
     // Plugin specification discovery (phase 1 of loading)
     struct PluginSpecificationInfo {
         std::string path;
@@ -539,16 +633,58 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     // Plugin loading methods
     bool loadPlugin(const std::string& path) {
         // Observer will handle initialization automatically via onPluginLoaded()
-        return pluginManager->loadPlugin(path);
+        NTApi::ScopedContext apiScope(&apiContext);
+        pluginWorker->pause();
+        displayScheduler->pause();
+        bool loaded = pluginManager->loadPlugin(path);
+        displayScheduler->resume();
+        pluginWorker->resume();
+        return loaded;
     }
     
     // Overloaded loadPlugin that accepts custom specifications  
     bool loadPlugin(const std::string& path, const std::vector<int32_t>& customSpecifications) {
         // Observer will handle initialization automatically via onPluginLoaded()
-        return pluginManager->loadPlugin(path, customSpecifications);
+        NTApi::ScopedContext apiScope(&apiContext);
+        pluginWorker->pause();
+        displayScheduler->pause();
+        bool loaded = pluginManager->loadPlugin(path, customSpecifications);
+        displayScheduler->resume();
+        pluginWorker->resume();
+        return loaded;
     }
     
     
+    // Algorithm chain (slots 1..N after the primary plugin)
+    int addAlgorithmSlot(const std::string& path, const std::vector<int32_t>& specifications = {}) {
+        NTApi::ScopedContext apiScope(&apiContext);
+        std::unique_ptr<AlgorithmSlot> built = pluginManager->createSlot(path, specifications);
+        if (!built) {
+            displayDirty = true;
+            return -1;
+        }
+        
+        // Fully set up (algorithm->v, parameterChanged) before the audio thread can see it
+        int slot = pluginManager->getSlotCount();
+        {
+            NTApi::ScopedAlgorithmIndex indexScope(slot);
+            parameterSystem->extractSlotParameters(slot, *built);
+        }
+        if (pluginManager->addSlot(std::move(built)) != slot) {
+            parameterSystem->removeSlotParameters(slot);
+            slot = -1;
+        }
+        displayDirty = true;
+        return slot;
+    }
+    
+    void removeAlgorithmSlot(int slot) {
+        NTApi::ScopedContext apiScope(&apiContext);
+        pluginManager->removeSlot(slot);
+        parameterSystem->removeSlotParameters(slot);
+        displayDirty = true;
+    }
+    
     // extractParameterData now handled by ParameterSystem
     
     // Sync VCV pot positions to menu navigation state when entering menu
@@ -623,6 +759,7 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
             params[POT_R_PARAM].getValue()
         };
 
+        NTApi::ScopedContext apiScope(&apiContext);
         INFO("NtEmu: Calling setupUi after %s with pot values: %.3f %.3f %.3f",
              reason, potValues[0], potValues[1], potValues[2]);
         pluginManager->callSetupUi(potValues);
@@ -700,7 +837,7 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         if (paramIdx >= 0 && paramIdx < (int)parameterSystem->getParameterCount()) {
             const _NT_parameter& param = parameterSystem->getParameters()[paramIdx];
             if (isRoutingParameter(param)) {
-                updateParameterRouting();
+                requestRoutingUpdate();
             }
         }
         
@@ -719,13 +856,12 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         // Delegate to existing setParameterValue method
         setParameterValue(paramIdx, value);
         
-        // Also call parameterChanged to notify plugin
-        if (pluginManager->isLoaded() && pluginManager->getFactory() && pluginManager->getFactory()->parameterChanged) {
-            try {
-                pluginManager->getFactory()->parameterChanged(pluginManager->getAlgorithm(), paramIdx);
-            } catch (...) {
-                WARN("NtEmu: Plugin crashed during parameterChanged callback");
-            }
+        // Also call parameterChanged to notify plugin. The executor checks the
+        // plugin pointers, times the call and serialises it with step() and
+        // draw(); the lock is recursive, so calls made from inside step() or
+        // customUi() are fine.
+        if (pluginManager->isLoaded()) {
+            pluginExecutor->safeParameterChanged(paramIdx);
         }
     }
     
@@ -768,59 +904,46 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     
     void applyRoutingChanges() {
         // Update bus routing based on parameter values
-        updateBusRouting();
+        requestRoutingUpdate();
         
         // Save routing to module state
         routingDirty = true;
     }
     
+    // Safe from any thread; the plan is rebuilt by EmulatorWidget::step()
+    void requestRoutingUpdate() {
+        routingPlanDirty.store(true);
+    }
+    
+    // UI thread only: compile the routing parameters into a flat plan and publish it
     void updateParameterRouting() {
-        // Clear existing routing
-        paramInputRouting.clear();
-        paramOutputRouting.clear();
+        RoutingPlan& plan = routingPlans.beginWrite();
         
-        // Scan parameters for input/output types
-        for (size_t i = 0; i < parameterSystem->getParameterCount(); i++) {
-            const _NT_parameter& param = parameterSystem->getParameters()[i];
+        if (pluginManager && pluginManager->getAlgorithm() && parameterSystem->hasParameters()) {
+            const auto& matrix = parameterSystem->getRoutingMatrix();
+            size_t count = std::min(parameterSystem->getParameterCount(), matrix.size());
             
-            if (param.unit == kNT_unitAudioInput || param.unit == kNT_unitCvInput) {
-                // This parameter controls an input routing
-                paramInputRouting[i] = {
-                    .paramIndex = (int)i,
-                    .busIndex = parameterSystem->getRoutingMatrix()[i] > 0 ? parameterSystem->getRoutingMatrix()[i] - 1 : -1,  // Convert to 0-based
-                    .isCV = (param.unit == kNT_unitCvInput)
-                };
-            }
-            else if (param.unit == kNT_unitAudioOutput || param.unit == kNT_unitCvOutput) {
-                // This parameter controls an output routing
-                paramOutputRouting[i] = {
-                    .paramIndex = (int)i,
-                    .busIndex = parameterSystem->getRoutingMatrix()[i] > 0 ? parameterSystem->getRoutingMatrix()[i] - 1 : -1,  // Convert to 0-based
-                    .isCV = (param.unit == kNT_unitCvOutput),
-                    .hasOutputMode = false,
-                    .outputModeParamIndex = -1
-                };
+            // Scan parameters for input/output types
+            for (size_t i = 0; i < count; i++) {
+                const _NT_parameter& param = parameterSystem->getParameters()[i];
+                int busIndex = matrix[i] > 0 ? matrix[i] - 1 : -1;  // Convert to 0-based
                 
-                // Check if next parameter is output mode
-                if (i + 1 < parameterSystem->getParameterCount() && parameterSystem->getParameters()[i + 1].unit == kNT_unitOutputMode) {
-                    paramOutputRouting[i].hasOutputMode = true;
-                    paramOutputRouting[i].outputModeParamIndex = i + 1;
+                if (param.unit == kNT_unitAudioInput || param.unit == kNT_unitCvInput) {
+                    plan.addInput((int)i, busIndex, param.unit == kNT_unitCvInput);
+                }
+                else if (param.unit == kNT_unitAudioOutput || param.unit == kNT_unitCvOutput) {
+                    // Output mode parameter, if any, follows the output parameter
+                    int modeIndex = -1;
+                    if (i + 1 < count && parameterSystem->getParameters()[i + 1].unit == kNT_unitOutputMode) {
+                        modeIndex = (int)i + 1;
+                    }
+                    bool replace = modeIndex >= 0 && matrix[modeIndex] != 0;
+                    plan.addOutput((int)i, busIndex, param.unit == kNT_unitCvOutput, modeIndex, replace);
                 }
             }
         }
         
-        // Update the busInputMap and busOutputMap for compatibility
-        updateBusRouting();
-    }
-    
-    void updateBusRouting() {
-        // Validate plugin state before updating routing
-        if (!pluginManager || !pluginManager->getAlgorithm() || !parameterSystem->hasParameters()) {
-            return;
-        }
-        
-        // This method is now called from updateParameterRouting()
-        // and uses the paramInputRouting and paramOutputRouting maps
+        routingPlans.publish();
     }
     
     int getVCVInputForParameter(int paramIndex) {
@@ -861,6 +984,7 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     bool safeExecutePlugin(Func func, const char* operation) {
         if (!isPluginLoaded()) return false;
         
+        NTApi::ScopedContext apiScope(&apiContext);
         try {
             func();
             return true;
@@ -873,14 +997,101 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         }
     }
     
+    // Block size selection (frames per step() call)
+    void setBlockSize(int frames) {
+        // process() applies it, and updates the plugin-visible globals, at the next block boundary
+        blockSize.store(clamp(frames, BusSystem::MIN_BLOCK_FRAMES, BusSystem::MAX_BLOCK_FRAMES) & ~3);
+    }
+
+    int getBlockSize() const {
+        return blockSize.load();
+    }
+
+    // Buffering one block delays every output by blockSize samples
+    float getBlockLatencyMs() const {
+        return 1000.f * getBlockSize() / APP->engine->getSampleRate();
+    }
+
+    // Pipelined mode (plugin step on a worker thread, one block of latency)
+    void setPipelined(bool enabled) {
+        pipelineRequested.store(enabled);
+        // A job left pending when the thread stops is reclaimed by process()
+        if (enabled) {
+            pluginWorker->start();
+        } else {
+            pluginWorker->stop();
+        }
+    }
+    
+    bool isPipelined() const {
+        return pipelineRequested.load();
+    }
+    
+    void stepPlugin(float* buses, int numFramesBy4, bool realtime) {
+        // Slot 0 then the chained algorithms on the same buses; the executor
+        // checks the plugin pointers and times each call
+        pluginExecutor->safeStepBlock(buses, numFramesBy4, realtime);
+    }
+    
+    // Profiler summary plus the context needed to read it
+    json_t* profileToJson() {
+        json_t* rootJ = pluginExecutor->getProfiler().toJson();
+        json_object_set_new(rootJ, "sampleRate", json_real(APP->engine->getSampleRate()));
+        json_object_set_new(rootJ, "blockSize", json_integer(getBlockSize()));
+        json_object_set_new(rootJ, "blockPeriodUs", json_real(getBlockLatencyMs() * 1000.f));
+        json_object_set_new(rootJ, "lockMisses", json_integer(pluginExecutor->getLockMisses()));
+        
+        const HardwareLoadEstimator& estimator = HardwareLoadEstimator::getInstance();
+        if (pluginExecutor->isHardwareLoadEstimate() && estimator.isCalibrated()) {
+            PluginExecutor::HardwareLoadStats stats = pluginExecutor->getHardwareLoadStats();
+            json_t* hardwareJ = json_object();
+            json_object_set_new(hardwareJ, "scale", json_real(estimator.getScale()));
+            json_object_set_new(hardwareJ, "minScale", json_real(estimator.getMinScale()));
+            json_object_set_new(hardwareJ, "maxScale", json_real(estimator.getMaxScale()));
+            json_object_set_new(hardwareJ, "lastPercent", json_real(stats.lastPercent));
+            json_object_set_new(hardwareJ, "peakPercent", json_real(stats.peakPercent));
+            json_object_set_new(hardwareJ, "meanPercent", json_real(stats.meanPercent));
+            json_object_set_new(hardwareJ, "p99Percent", json_real(stats.p99Percent));
+            json_object_set_new(hardwareJ, "windowBlocks", json_integer(stats.windowBlocks));
+            json_object_set_new(rootJ, "hardwareLoad", hardwareJ);
+        }
+        
+        json_t* algorithmsJ = json_array();
+        if (isPluginLoaded()) {
+            const char* name = pluginManager->getFactory()->name;
+            json_array_append_new(algorithmsJ, json_string(name ? name : "Unknown"));
+            // The chain can change on another thread; hold it still while reading
+            std::lock_guard<std::mutex> lock(pluginManager->getSlotMutex());
+            for (int slot = 1; slot < pluginManager->getSlotCountLocked(); slot++) {
+                json_array_append_new(algorithmsJ, json_string(pluginManager->getSlot(slot)->getName()));
+            }
+        }
+        json_object_set_new(rootJ, "algorithms", algorithmsJ);
+        return rootJ;
+    }
+    
+    static void pipelinedStep(void* context, float* buses, int numFramesBy4) {
+        // The worker thread may wait for draw(); the engine thread never does
+        static_cast<EmulatorModule*>(context)->stepPlugin(buses, numFramesBy4, false);
+    }
+    
     void process(const ProcessArgs& args) override {
+        // Every plugin callback made from the engine thread resolves to this module
+        NTApi::ScopedContext apiScope(&apiContext);
         try {
         
         // Update plugin manager timers
         pluginManager->updateLoadingTimer(args.sampleTime);
         
-        // Process MIDI input using new MidiProcessor
-        midiProcessor->processInputMessages(args);
+        // Process MIDI input using new MidiProcessor. In pipelined mode this
+        // waits for the block boundary, when the worker is not inside step().
+        // Messages stay queued while draw() or the UI holds the plugin.
+        if (!pipelineActive) {
+            PluginExecutor::ExecutionTryLock lock(pluginExecutor->getExecutionMutex(), std::try_to_lock);
+            if (lock.owns_lock()) {
+                midiProcessor->processInputMessages(args);
+            }
+        }
         
         // Update MIDI activity lights
         if (midiActivityDivider.process()) {
@@ -915,8 +1126,8 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
             
             // Debug log encoder deltas if non-zero
             if (encoderDeltas[0] != 0 || encoderDeltas[1] != 0) {
-                INFO("EmulatorModule: Encoder deltas before menu: L=%d R=%d", 
-                     encoderDeltas[0], encoderDeltas[1]);
+                RT_DEBUG(Audio, "Encoder deltas before menu: L=%d R=%d",
+                         encoderDeltas[0], encoderDeltas[1]);
             }
             
             std::array<bool, 2> encoderPressed = {
@@ -944,12 +1155,19 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         //     }
         // }
         
-        // Route inputs to buses for current sample
+        // Apply pending block size and routing changes at the block boundary
+        if (busSystem.getCurrentSampleIndex() == 0) {
+            busSystem.setBlockFrames(blockSize.load(std::memory_order_relaxed));
+            apiContext.globals.maxFramesPerStep = busSystem.getBlockFrames();
+            activeRouting = &routingPlans.acquire();
+        }
+
+        // Stage inputs for current sample (committed to buses 0-11 on the last sample)
         busSystem.routeInputs(this);
 
-        bool processBlock = (sampleCounter == BLOCK_SIZE - 1);
+        bool processBlock = busSystem.isLastSampleOfBlock();
 
-        // Route outputs for current sample (read previous block data first)
+        // Route outputs for current sample (previous block's staged output)
         busSystem.routeOutputs(this);
 
         // After outputting the last sample of the block, process the next block.
@@ -957,35 +1175,53 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
             // Clear output buses before plugin processes (plugins use += for Add mode)
             busSystem.clearOutputBuses();
 
-            // Process algorithm with 4-sample blocks
-            printf("Audio block complete, isPluginLoaded()=%s\n", isPluginLoaded() ? "true" : "false");
+            const int numFramesBy4 = busSystem.getNumFramesBy4();
+
+            // Collect the worker's previous block. If it missed the deadline it
+            // still holds the execution lock, so the try-lock below skips MIDI
+            // and exchange() repeats the last output block.
+            if (pipelineActive) {
+                pluginWorker->finishPrevious();
+                PluginExecutor::ExecutionTryLock lock(pluginExecutor->getExecutionMutex(), std::try_to_lock);
+                if (lock.owns_lock()) {
+                    midiProcessor->processInputMessages(args);
+                }
+            }
+            bool pipelined = pipelineRequested.load() && isPluginLoaded();
+            if (pipelineActive && !pipelined) {
+                // Leaving pipelined mode: the in-flight result is dropped
+                pipelineActive = false;
+            }
+
+            // Process algorithm with the buffered block
+            RT_DEBUG(Audio, "Audio block complete, isPluginLoaded()=%s", isPluginLoaded() ? "true" : "false");
             if (isPluginLoaded()) {
                 // Keep plugin customUi inactive while the parameter menu owns the controls.
                 if (!isParameterMenuActive()) {
-                    printf("Processing hardware changes for loaded plugin\n");
-                    emulatorCore.processHardwareChanges(pluginManager->getFactory(), pluginManager->getAlgorithm());
+                    // Skipped for this block while draw() or the UI holds the plugin
+                    PluginExecutor::ExecutionTryLock lock(pluginExecutor->getExecutionMutex(), std::try_to_lock);
+                    if (lock.owns_lock()) {
+                        RT_DEBUG(Audio, "Processing hardware changes for loaded plugin");
+                        emulatorCore.processHardwareChanges(pluginManager->getFactory(), pluginManager->getAlgorithm());
+                    }
                 }
 
                 // Use plugin for audio processing
-                safeExecutePlugin([&]() {
-                    // Add comprehensive null checks for plugin reload safety
-                    if (pluginManager && pluginManager->getFactory() && pluginManager->getAlgorithm() && pluginManager->getFactory()->step) {
-                        // Debug logging disabled for performance
-
-                        pluginManager->getFactory()->step(pluginManager->getAlgorithm(), busSystem.getBuses(), 1);
-
-                        // Debug logging disabled for performance
+                if (pipelined) {
+                    if (!pipelineActive) {
+                        pluginWorker->resetPipeline();
+                        pipelineActive = true;
                     }
-                }, "step");
+                    pluginWorker->exchange(busSystem.getBuses(), BusSystem::NUM_BUSES * busSystem.getBlockFrames(), numFramesBy4);
+                } else {
+                    stepPlugin(busSystem.getBuses(), numFramesBy4, true);
+                }
             } else {
                 // Use built-in emulator
-                emulatorCore.processAudio(busSystem.getBuses(), 1); // 1 = numFramesBy4
+                emulatorCore.processAudio(busSystem.getBuses(), numFramesBy4);
             }
         }
 
-        // Increment sample counter and wrap at block size
-        sampleCounter = (sampleCounter + 1) % BLOCK_SIZE;
-
         // Update lights
         updateLights();
         
@@ -1095,7 +1331,10 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         if (isPluginLoaded()) {
             // Only process hardware changes for non-customUi plugins
             if (!pluginManager->getFactory()->customUi) {
-                emulatorCore.processHardwareChanges(pluginManager->getFactory(), pluginManager->getAlgorithm());
+                PluginExecutor::ExecutionTryLock lock(pluginExecutor->getExecutionMutex(), std::try_to_lock);
+                if (lock.owns_lock()) {
+                    emulatorCore.processHardwareChanges(pluginManager->getFactory(), pluginManager->getAlgorithm());
+                }
             }
         }
     }
@@ -1111,28 +1350,16 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     }
     
     void updatePortLights() {
-        // Light up connected inputs
-        for (int i = 0; i < 12; i++) {
-            bool isRouted = false;
-            for (int bus = 0; bus < 28; bus++) {
-                if (busInputMap[bus] == i) {
-                    isRouted = true;
-                    break;
-                }
-            }
-            lights[INPUT_LIGHT_1 + i].setBrightness(isRouted ? 1.0f : 0.0f);
+        const RoutingPlan& plan = *activeRouting;
+        
+        // Light up inputs whose bus is read by the plugin
+        for (int i = 0; i < RoutingPlan::NUM_INPUT_JACKS; i++) {
+            lights[INPUT_LIGHT_1 + i].setBrightness(plan.inputJackRouted[i] ? 1.0f : 0.0f);
         }
         
-        // Light up connected outputs
-        for (int i = 0; i < 6; i++) {
-            bool isRouted = false;
-            for (int bus = 0; bus < 28; bus++) {
-                if (busOutputMap[bus] == i) {
-                    isRouted = true;
-                    break;
-                }
-            }
-            lights[OUTPUT_LIGHT_1 + i].setBrightness(isRouted ? 1.0f : 0.0f);
+        // Light up outputs whose bus is written by the plugin
+        for (int i = 0; i < RoutingPlan::NUM_OUTPUT_JACKS; i++) {
+            lights[OUTPUT_LIGHT_1 + i].setBrightness(plan.outputJackRouted[i] ? 1.0f : 0.0f);
         }
         
         // Update MIDI activity lights using new MidiProcessor
@@ -1154,7 +1381,7 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     }
     
     void onButtonPress(int button, bool pressed) {
-        INFO("Button %d %s", button + 1, pressed ? "pressed" : "released");
+        RT_DEBUG(Audio, "Button %d %s", button + 1, pressed ? "pressed" : "released");
         
         // If menu is active, don't send to plugin
         if (menuSystem->isMenuActive()) {
@@ -1207,6 +1434,7 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     // VCV Rack lifecycle methods
     void onSampleRateChange() override {
         emulatorCore.initialize(APP->engine->getSampleRate());
+        NTApi::setSampleRate(&apiContext, (uint32_t)APP->engine->getSampleRate());
     }
     
     void onReset() override {
@@ -1223,6 +1451,7 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     }
     
     json_t* dataToJson() override {
+        NTApi::ScopedContext apiScope(&apiContext);
         json_t* rootJ = emulatorCore.saveState();
         
         // Save plugin info if loaded
@@ -1240,6 +1469,24 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
             }
         }
         
+        // Save chained algorithms with their parameter values
+        if (pluginManager->getSlotCount() > 1) {
+            json_t* chainJ = json_array();
+            for (int slot = 1; slot < pluginManager->getSlotCount(); slot++) {
+                const AlgorithmSlot* algorithmSlot = pluginManager->getSlot(slot);
+                json_t* slotJ = json_object();
+                json_object_set_new(slotJ, "path", json_string(algorithmSlot->path.c_str()));
+                json_t* specsJ = json_array();
+                for (int32_t s : algorithmSlot->specifications) {
+                    json_array_append_new(specsJ, json_integer(s));
+                }
+                json_object_set_new(slotJ, "specifications", specsJ);
+                json_object_set_new(slotJ, "parameterValues", parameterSystem->saveSlotParameterState(slot));
+                json_array_append_new(chainJ, slotJ);
+            }
+            json_object_set_new(rootJ, "chain", chainJ);
+        }
+        
         // Save parameter values
         json_t* paramsJ = json_array();
         for (int i = 0; i < 3; i++) {
@@ -1269,6 +1516,17 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         json_object_set_new(rootJ, "midiInput", midiProcessor->getInputQueue().toJson());
         json_object_set_new(rootJ, "midiOutput", midiProcessor->getOutput().toJson());
 
+        // Save step block size and pipelined mode
+        json_object_set_new(rootJ, "blockSize", json_integer(getBlockSize()));
+        json_object_set_new(rootJ, "pipelined", json_boolean(isPipelined()));
+        json_object_set_new(rootJ, "hardwareLoadEstimate", json_boolean(pluginExecutor->isHardwareLoadEstimate()));
+        json_object_set_new(rootJ, "enforceMemoryLimits", json_boolean(pluginManager->isEnforceMemoryLimits()));
+        json_object_set_new(rootJ, "guardedMemory", json_boolean(pluginManager->isGuardedMemory()));
+        json_object_set_new(rootJ, "hotSwapCrossfadeMs", json_real(hotSwapCrossfadeMs));
+        json_object_set_new(rootJ, "hotSwapOnRebuild", json_boolean(hotSwapOnRebuild));
+        json_object_set_new(rootJ, "displayLook", json_integer((int)displayLook));
+        json_object_set_new(rootJ, "displayRateHz", json_integer(displayScheduler->getRate()));
+
         // Save virtual SD card path
         if (!virtualSdCardPath.empty()) {
             json_object_set_new(rootJ, "virtualSdCardPath", json_string(virtualSdCardPath.c_str()));
@@ -1301,8 +1559,47 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     }
     
     void dataFromJson(json_t* rootJ) override {
+        NTApi::ScopedContext apiScope(&apiContext);
         emulatorCore.loadState(rootJ);
         
+        // Restore step block size (defaults to 4 frames for older patches)
+        json_t* blockSizeJ = json_object_get(rootJ, "blockSize");
+        if (blockSizeJ && json_is_integer(blockSizeJ)) {
+            setBlockSize((int)json_integer_value(blockSizeJ));
+        }
+        json_t* pipelinedJ = json_object_get(rootJ, "pipelined");
+        if (pipelinedJ) {
+            setPipelined(json_boolean_value(pipelinedJ));
+        }
+        json_t* hardwareLoadJ = json_object_get(rootJ, "hardwareLoadEstimate");
+        if (hardwareLoadJ) {
+            pluginExecutor->setHardwareLoadEstimate(json_boolean_value(hardwareLoadJ));
+        }
+        json_t* enforceMemoryJ = json_object_get(rootJ, "enforceMemoryLimits");
+        if (enforceMemoryJ) {
+            pluginManager->setEnforceMemoryLimits(json_boolean_value(enforceMemoryJ));
+        }
+        json_t* guardedMemoryJ = json_object_get(rootJ, "guardedMemory");
+        if (guardedMemoryJ) {
+            pluginManager->setGuardedMemory(json_boolean_value(guardedMemoryJ));
+        }
+        json_t* hotSwapCrossfadeJ = json_object_get(rootJ, "hotSwapCrossfadeMs");
+        if (hotSwapCrossfadeJ) {
+            hotSwapCrossfadeMs = clamp((float)json_number_value(hotSwapCrossfadeJ), 0.f, 100.f);
+        }
+        json_t* hotSwapOnRebuildJ = json_object_get(rootJ, "hotSwapOnRebuild");
+        if (hotSwapOnRebuildJ) {
+            setHotSwapOnRebuild(json_boolean_value(hotSwapOnRebuildJ));
+        }
+        json_t* displayLookJ = json_object_get(rootJ, "displayLook");
+        if (displayLookJ && json_is_integer(displayLookJ)) {
+            setDisplayLook((OLEDLook)clamp((int)json_integer_value(displayLookJ), 0, (int)OLEDLook::NUM_LOOKS - 1));
+        }
+        json_t* displayRateJ = json_object_get(rootJ, "displayRateHz");
+        if (displayRateJ && json_is_integer(displayRateJ)) {
+            displayScheduler->setRate((int)json_integer_value(displayRateJ));
+        }
+
         // First, store plugin state for restoration BEFORE loading plugin
         json_t* pluginStateJ = json_object_get(rootJ, "pluginState");
         if (pluginStateJ && json_is_string(pluginStateJ)) {
@@ -1347,6 +1644,27 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
             }
         }
         
+        // Restore chained algorithms after the primary plugin
+        json_t* chainJ = json_object_get(rootJ, "chain");
+        if (chainJ && json_is_array(chainJ) && isPluginLoaded()) {
+            size_t chainSize = json_array_size(chainJ);
+            for (size_t i = 0; i < chainSize; i++) {
+                json_t* slotJ = json_array_get(chainJ, i);
+                json_t* slotPathJ = json_object_get(slotJ, "path");
+                if (!slotPathJ || !rack::system::exists(json_string_value(slotPathJ))) continue;
+                
+                std::vector<int32_t> specs;
+                json_t* specsJ = json_object_get(slotJ, "specifications");
+                for (size_t s = 0; specsJ && s < json_array_size(specsJ); s++) {
+                    specs.push_back((int32_t)json_integer_value(json_array_get(specsJ, s)));
+                }
+                int slot = addAlgorithmSlot(json_string_value(slotPathJ), specs);
+                if (slot > 0) {
+                    parameterSystem->loadSlotParameterState(slot, json_object_get(slotJ, "parameterValues"));
+                }
+            }
+        }
+        
         // Restore parameters
         json_t* paramsJ = json_object_get(rootJ, "params");
         if (paramsJ) {
@@ -1382,7 +1700,7 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
             }
             
             // Apply routing
-            updateBusRouting();
+            requestRoutingUpdate();
         }
         
         // Handle parameter values restoration
@@ -1449,7 +1767,7 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         if (sdCardPathJ && json_is_string(sdCardPathJ)) {
             virtualSdCardPath = json_string_value(sdCardPathJ);
             if (!virtualSdCardPath.empty() && rack::system::isDirectory(virtualSdCardPath)) {
-                VirtualSdCard::getInstance().setRootPath(virtualSdCardPath);
+                setVirtualSdCardPath(virtualSdCardPath);
                 INFO("NtEmu: Restored virtual SD card path: %s", virtualSdCardPath.c_str());
             }
         }
@@ -1460,12 +1778,18 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     // IParameterObserver interface implementation
     void onParameterChanged(int index, int16_t value) override {
         // Notify plugin of parameter change
-        if (pluginManager->getFactory() && pluginManager->getFactory()->parameterChanged) {
-            pluginManager->getFactory()->parameterChanged(pluginManager->getAlgorithm(), index);
+        pluginExecutor->safeParameterChanged(index);
+        if (index >= 0 && index < (int)parameterSystem->getParameterCount() &&
+            isRoutingParameter(parameterSystem->getParameters()[index])) {
+            requestRoutingUpdate();
         }
         displayDirty = true;
     }
     
+    void onSlotParameterChanged(int slot, int index, int16_t value) override {
+        pluginExecutor->safeSlotParameterChanged(slot, index);
+    }
+    
     void onParameterPageChanged(int pageIndex) override {
         displayDirty = true;
     }
@@ -1475,6 +1799,7 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         if (pluginManager->getAlgorithm()) {
             pluginManager->getAlgorithm()->v = parameterSystem->getRoutingMatrix().data();
         }
+        requestRoutingUpdate();
         displayDirty = true;
     }
     
@@ -1510,12 +1835,22 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         }
         
         syncPotsToPluginUi("plugin load");
+        updateFileWatches();
         
         displayDirty = true;
     }
     
+    void onPluginHotSwapped() override {
+        // Names and pages now come from the new build; values stay as they were
+        parameterSystem->extractParameterData(true);
+        syncPotsToPluginUi("hot swap");
+        displayDirty = true;
+    }
+    
     void onPluginUnloaded() override {
-        // Plugin unloaded - could add any cleanup here if needed
+        // Plugin unloaded - drop its routing
+        requestRoutingUpdate();
+        updateFileWatches();
         displayDirty = true;
     }
     
@@ -1720,6 +2055,13 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
     void setDisplayDirty(bool dirty) override { displayDirty = dirty; }
     const VCVDisplayBuffer& getDisplayBuffer() const override { return emulatorCore.getDisplayBuffer(); }
     void updateDisplay() override { emulatorCore.updateDisplay(); }
+    int getDisplayLook() const override { return (int)displayLook; }
+    DisplayScheduler* getDisplaySchedulerPtr() const override { return displayScheduler.get(); }
+    
+    void setDisplayLook(OLEDLook look) {
+        displayLook = look;
+        displayDirty = true;
+    }
     
     int getMenuMode() const override { return static_cast<int>(menuMode); }
     
@@ -1730,6 +2072,10 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         return pluginManager.get(); 
     }
     
+    PluginExecutor* getPluginExecutorPtr() const override {
+        return pluginExecutor.get();
+    }
+    
     ParameterSystem* getParameterSystemPtr() const override { 
         return parameterSystem.get(); 
     }
@@ -1738,35 +2084,45 @@ struct EmulatorModule : Module, IParameterObserver, IPluginStateObserver, IDispl
         // Delegate to the existing safeExecutePlugin method
         this->safeExecutePlugin(func, operation.c_str());
     }
+    
+    NTApiContext* getApiContext() override {
+        return &apiContext;
+    }
 };
 
 
-// MIDI API functions - now properly implemented after EmulatorModule definition
+// MIDI API functions - routed to the MIDI sink of the module whose plugin is calling
+static MidiProcessor* currentMidiSink() {
+    NTApiContext* context = NTApi::getCurrentContext();
+    return context ? context->midiSink : nullptr;
+}
+
 extern "C" {
     __attribute__((visibility("default"))) void NT_sendMidiByte(uint32_t destination, uint8_t b0) {
-        if (g_currentModule && g_currentModule->midiProcessor) {
-            g_currentModule->midiProcessor->sendMidiMessage(b0);
+        if (MidiProcessor* midi = currentMidiSink()) {
+            midi->sendMidiMessage(b0);
         }
     }
     
     __attribute__((visibility("default"))) void NT_sendMidi2ByteMessage(uint32_t destination, uint8_t b0, uint8_t b1) {
-        if (g_currentModule && g_currentModule->midiProcessor) {
-            g_currentModule->midiProcessor->sendMidiMessage(b0, b1);
+        if (MidiProcessor* midi = currentMidiSink()) {
+            midi->sendMidiMessage(b0, b1);
         }
     }
     
     __attribute__((visibility("default"))) void NT_sendMidi3ByteMessage(uint32_t destination, uint8_t b0, uint8_t b1, uint8_t b2) {
-        INFO("NT_sendMidi3ByteMessage: %02X %02X %02X, destination=%08X", b0, b1, b2, destination);
-        if (g_currentModule && g_currentModule->midiProcessor) {
-            g_currentModule->midiProcessor->sendMidiMessage(b0, b1, b2);
+        RT_DEBUG(Midi, "NT_sendMidi3ByteMessage: %02X %02X %02X, destination=%08X", b0, b1, b2, destination);
+        if (MidiProcessor* midi = currentMidiSink()) {
+            midi->sendMidiMessage(b0, b1, b2);
         } else {
-            INFO("NT_sendMidi3ByteMessage: No module or midiProcessor available");
+            RT_WARN(Midi, "NT_sendMidi3ByteMessage: called outside a module context");
         }
     }
     
     __attribute__((visibility("default"))) void NT_sendMidiSysEx(uint32_t destination, const uint8_t* data, uint32_t count, bool end) {
-        if (g_currentModule && g_currentModule->midiProcessor && data && count > 0) {
-            g_currentModule->midiProcessor->sendSysEx(data, count, end);
+        MidiProcessor* midi = currentMidiSink();
+        if (midi && data && count > 0) {
+            midi->sendSysEx(data, count, end);
         }
     }
 }
@@ -1795,30 +2151,38 @@ std::string ContextAwareEncoderQuantity::getDisplayValueString() {
 void TooltipOutputPort::onHover(const HoverEvent& e) {
     PJ301MPort::onHover(e);
     
-    // Update tooltip based on current routing
-    if (distingModule && distingModule->isPluginLoaded()) {
-        // Find parameter that routes to this output
-        for (const auto& pair : distingModule->paramOutputRouting) {
-            size_t paramIdx = pair.first;
-            // Check if this parameter's routing would send to this output
-            const std::string& paramName = distingModule->parameterSystem->getParameters()[paramIdx].name;
-            int targetOutput = -1;
-            
-            // Extract output number from parameter name
-            if (sscanf(paramName.c_str(), "Output %d", &targetOutput) == 1 ||
-                sscanf(paramName.c_str(), "Out %d", &targetOutput) == 1) {
-                targetOutput--; // Convert to 0-based
-                
-                if (targetOutput == outputIndex) {
-                    // Tooltip will be displayed through VCV's mechanism
-                    return;
-                }
-            }
+    if (!distingModule || outputIndex < 0 || outputIndex >= RoutingPlan::NUM_OUTPUT_JACKS) return;
+    
+    // Describe the parameter that writes this output's bus
+    std::string description;
+    if (distingModule->isPluginLoaded()) {
+        const RoutingPlan& plan = distingModule->routingPlans.getPublished();
+        int paramIdx = plan.outputJackParam[outputIndex];
+        if (paramIdx >= 0 && paramIdx < (int)distingModule->parameterSystem->getParameterCount()) {
+            description = distingModule->parameterSystem->getParameters()[paramIdx].name;
         }
     }
+    
+    PortInfo* info = distingModule->outputInfos[EmulatorModule::AUDIO_OUTPUT_1 + outputIndex];
+    if (info) {
+        info->description = description;
+    }
 }
 
 struct EmulatorWidget : ModuleWidget {
+    void step() override {
+        // Rebuild the routing plan off the engine thread
+        EmulatorModule* module = dynamic_cast<EmulatorModule*>(this->module);
+        if (module && module->routingPlanDirty.exchange(false)) {
+            module->updateParameterRouting();
+        }
+        if (module) {
+            module->fileWatcher.update();
+            module->updateHotSwap();
+        }
+        ModuleWidget::step();
+    }
+    
     EmulatorWidget(EmulatorModule* module) {
         setModule(module);
         setPanel(createPanel(asset::plugin(pluginInstance, "res/panels/DistingNT.svg")));
@@ -1957,6 +2321,23 @@ struct EmulatorWidget : ModuleWidget {
                 menu->addChild(createMenuItem("Reload Plugin", "", [=]() {
                     module->reloadPlugin();
                 }));
+                menu->addChild(createMenuItem("Hot Swap (keep audio running)", "", [=]() {
+                    module->hotSwapPlugin();
+                }, module->pluginManager->isHotSwapping()));
+                menu->addChild(createBoolMenuItem("Hot swap on rebuild", "",
+                    [=]() { return module->hotSwapOnRebuild; },
+                    [=](bool enabled) { module->setHotSwapOnRebuild(enabled); }
+                ));
+                menu->addChild(createSubmenuItem("Hot swap crossfade", "", [=](Menu* menu) {
+                    static const float fadeTimes[] = {0.f, 5.f, 20.f, 50.f};
+                    for (float ms : fadeTimes) {
+                        std::string label = ms > 0.f ? string::f("%.0f ms", ms) : "Off";
+                        menu->addChild(createCheckMenuItem(label, "",
+                            [=]() { return module->hotSwapCrossfadeMs == ms; },
+                            [=]() { module->hotSwapCrossfadeMs = ms; }
+                        ));
+                    }
+                }));
                 menu->addChild(createMenuItem("Unload Plugin", "", [=]() {
                     module->unloadPlugin();
                 }));
@@ -1964,6 +2345,7 @@ struct EmulatorWidget : ModuleWidget {
                 // Show current plugin
                 std::string filename = rack::system::getFilename(module->pluginManager->getPluginPath());
                 menu->addChild(createMenuLabel(string::f("Current: %s", filename.c_str())));
+                menu->addChild(createMenuLabel(string::f("Last load: %.1f ms", module->pluginManager->getLastLoadMs())));
             }
         }));
 
@@ -1980,8 +2362,7 @@ struct EmulatorWidget : ModuleWidget {
 
                 // Clear option
                 menu->addChild(createMenuItem("Clear Path", "", [=]() {
-                    module->virtualSdCardPath.clear();
-                    VirtualSdCard::getInstance().setRootPath("");
+                    module->setVirtualSdCardPath("");
                 }));
 
                 // Show current folder
@@ -1998,6 +2379,175 @@ struct EmulatorWidget : ModuleWidget {
             }
         }));
 
+        // OLED presentation
+        menu->addChild(createSubmenuItem("Display Look", "", [=](Menu* menu) {
+            static const char* lookNames[] = {"Plain", "Pixel grid", "Bloom"};
+            for (int i = 0; i < (int)OLEDLook::NUM_LOOKS; i++) {
+                OLEDLook look = (OLEDLook)i;
+                menu->addChild(createCheckMenuItem(lookNames[i], "",
+                    [=]() { return module->displayLook == look; },
+                    [=]() { module->setDisplayLook(look); }
+                ));
+            }
+        }));
+
+        // Plugin draw() rate
+        menu->addChild(createSubmenuItem("Display Rate", string::f("%d Hz", module->displayScheduler->getRate()), [=](Menu* menu) {
+            static const int rates[] = {15, 30, 60};
+            for (int hz : rates) {
+                menu->addChild(createCheckMenuItem(string::f("%d Hz", hz), "",
+                    [=]() { return module->displayScheduler->getRate() == hz; },
+                    [=]() { module->displayScheduler->setRate(hz); }
+                ));
+            }
+            const DisplayScheduler::Stats& stats = module->displayScheduler->getStats();
+            menu->addChild(new MenuSeparator);
+            menu->addChild(createMenuLabel(string::f("Frames: %u drawn, %u not shown", stats.frames, stats.skipped)));
+        }));
+
+        // Display recording, replayed with DistingNTReplay from the emulator build
+        if (module->displayScheduler->isRecording()) {
+            FrameRecorder::Stats recorded = module->displayScheduler->getRecordingStats();
+            menu->addChild(createMenuItem("Stop recording display", string::f("%llu frames", (unsigned long long)recorded.frames),
+                [=]() { module->displayScheduler->stopRecording(); }
+            ));
+        } else {
+            menu->addChild(createMenuItem("Record display...", "", [=]() { recordDisplayDialog(module); }));
+        }
+
+        // Step block size submenu
+        menu->addChild(createSubmenuItem("Block Size", string::f("%d", module->getBlockSize()), [=](Menu* menu) {
+            static const int blockSizes[] = {4, 16, 32, 64};
+            for (int frames : blockSizes) {
+                menu->addChild(createCheckMenuItem(string::f("%d frames", frames), "",
+                    [=]() { return module->getBlockSize() == frames; },
+                    [=]() { module->setBlockSize(frames); }
+                ));
+            }
+            menu->addChild(new MenuSeparator);
+            menu->addChild(createMenuLabel(string::f("Added latency: %.2f ms", module->getBlockLatencyMs())));
+            menu->addChild(createMenuLabel(string::f("Exported NT_globals report %d frames", BusSystem::MAX_BLOCK_FRAMES)));
+        }));
+
+        // Pipelined worker thread submenu
+        menu->addChild(createSubmenuItem("Worker Thread", module->isPipelined() ? "On" : "Off", [=](Menu* menu) {
+            menu->addChild(createBoolMenuItem("Run step() on worker thread", "",
+                [=]() { return module->isPipelined(); },
+                [=](bool enabled) { module->setPipelined(enabled); }
+            ));
+            menu->addChild(createMenuLabel(string::f("Extra latency: %.2f ms (one block)", module->getBlockLatencyMs())));
+
+            PluginWorker::Stats stats = module->pluginWorker->getStats();
+            menu->addChild(new MenuSeparator);
+            menu->addChild(createMenuLabel(string::f("Blocks: %u", stats.blocks)));
+            menu->addChild(createMenuLabel(string::f("Handoff wait: %.1f us mean, %.1f us max", stats.meanWaitUs, stats.maxWaitUs)));
+            menu->addChild(createMenuLabel(string::f("Step time: %.1f us mean, %.1f us max", stats.meanStepUs, stats.maxStepUs)));
+            menu->addChild(createMenuLabel(string::f("Missed deadlines: %u inline, %u repeated", stats.inlineFallbacks, stats.missedDeadlines)));
+            menu->addChild(createMenuItem("Reset Statistics", "", [=]() {
+                module->pluginWorker->resetStats();
+            }));
+        }));
+
+        // Per-slot call timings
+        menu->addChild(createSubmenuItem("Profiler", "", [=](Menu* menu) {
+            PluginProfiler& profiler = module->pluginExecutor->getProfiler();
+            bool empty = true;
+            for (int slot = 0; slot < module->pluginManager->getSlotCount(); slot++) {
+                for (int s = 0; s < (int)ProfileSite::Count; s++) {
+                    PluginProfiler::Summary summary = profiler.summarize(slot, (ProfileSite)s);
+                    if (summary.samples == 0) continue;
+                    menu->addChild(createMenuLabel(string::f("%d %s: %.1f / %.1f / %.1f / %.1f us",
+                        slot, PluginProfiler::getSiteName((ProfileSite)s),
+                        summary.minUs, summary.meanUs, summary.p99Us, summary.maxUs)));
+                    empty = false;
+                }
+            }
+            if (empty) {
+                menu->addChild(createMenuLabel("No calls recorded"));
+            } else {
+                menu->addChild(createMenuLabel("(slot site: min / mean / p99 / max)"));
+            }
+            menu->addChild(createMenuLabel(string::f("Block period: %.1f us", module->getBlockLatencyMs() * 1000.f)));
+            menu->addChild(createMenuLabel(string::f("Blocks repeated (plugin busy): %u", module->pluginExecutor->getLockMisses())));
+            
+            // Predicted load on the 600 MHz Cortex-M7
+            menu->addChild(new MenuSeparator);
+            menu->addChild(createBoolMenuItem("Hardware load estimate", "",
+                [=]() { return module->pluginExecutor->isHardwareLoadEstimate(); },
+                [=](bool enabled) { module->pluginExecutor->setHardwareLoadEstimate(enabled); }
+            ));
+            if (module->pluginExecutor->isHardwareLoadEstimate()) {
+                appendHardwareLoadMenu(menu, module);
+            }
+            
+            menu->addChild(new MenuSeparator);
+            menu->addChild(createMenuItem("Save as JSON...", "", [=]() {
+                saveProfileDialog(module);
+            }));
+            menu->addChild(createMenuItem("Reset", "", [=]() {
+                module->pluginExecutor->getProfiler().reset();
+                module->pluginExecutor->resetHardwareLoadStats();
+            }));
+        }));
+
+        // Instance memory per region, summed over the algorithm chain
+        menu->addChild(createSubmenuItem("Memory", "", [=](Menu* menu) {
+            for (int r = 0; r < (int)MemoryRegion::Count; r++) {
+                MemoryRegion region = (MemoryRegion)r;
+                uint32_t used = module->pluginManager->getRegionUsage(region);
+                uint32_t limit = AlgorithmMemory::getRegionLimit(region);
+                menu->addChild(createMenuLabel(string::f("%s: %.1f / %u KB%s",
+                    AlgorithmMemory::getRegionName(region), used / 1024.f, limit / 1024,
+                    used > limit ? " (over limit)" : "")));
+            }
+            bool hugePages = module->pluginManager->getMemory().isHugePageBacked();
+            for (int slot = 1; slot < module->pluginManager->getSlotCount(); slot++) {
+                hugePages |= module->pluginManager->getSlot(slot)->memory.isHugePageBacked();
+            }
+            if (hugePages) {
+                menu->addChild(createMenuLabel("DRAM backed by huge pages"));
+            }
+            const MemoryArena& arena = module->pluginManager->getMemoryArena();
+            menu->addChild(createMenuLabel(string::f("Recycled blocks: %.1f MB kept, %u reused, %u new",
+                arena.getRetainedBytes() / (1024.f * 1024.f), arena.getHits(), arena.getMisses())));
+            menu->addChild(new MenuSeparator);
+            menu->addChild(createBoolMenuItem("Enforce hardware memory limits", "",
+                [=]() { return module->pluginManager->isEnforceMemoryLimits(); },
+                [=](bool enabled) { module->pluginManager->setEnforceMemoryLimits(enabled); }
+            ));
+            if (MemoryGuard::isSupported()) {
+                menu->addChild(createBoolMenuItem("Guard pages (from next load)", "",
+                    [=]() { return module->pluginManager->isGuardedMemory(); },
+                    [=](bool enabled) { module->pluginManager->setGuardedMemory(enabled); }
+                ));
+                if (module->pluginManager->getMemory().isGuarded()) {
+                    menu->addChild(createMenuLabel("Faults: nt_emu_memory_faults.txt"));
+                }
+            }
+        }));
+
+        // Real-time log verbosity (shared by all NtEmu instances)
+        menu->addChild(createSubmenuItem("Logging", "", [=](Menu* menu) {
+            for (int c = 0; c < (int)RtLogCategory::Count; c++) {
+                RtLogCategory category = (RtLogCategory)c;
+                menu->addChild(createSubmenuItem(RtLog::getCategoryName(category),
+                    RtLog::getLevelName(RtLog::getVerbosity(category)), [=](Menu* menu) {
+                    for (int l = (int)RtLogLevel::Off; l <= (int)RtLogLevel::Debug; l++) {
+                        RtLogLevel level = (RtLogLevel)l;
+                        menu->addChild(createCheckMenuItem(RtLog::getLevelName(level), "",
+                            [=]() { return RtLog::getVerbosity(category) == level; },
+                            [=]() { RtLog::setVerbosity(category, level); }
+                        ));
+                    }
+                }));
+            }
+            uint32_t dropped = RtLog::getInstance().getDroppedCount();
+            if (dropped > 0) {
+                menu->addChild(new MenuSeparator);
+                menu->addChild(createMenuLabel(string::f("Dropped records: %u", dropped)));
+            }
+        }));
+
         menu->addChild(new MenuSeparator);
 
         // MIDI Input submenu
@@ -2011,9 +2561,109 @@ struct EmulatorWidget : ModuleWidget {
         }));
         
         menu->addChild(new MenuSeparator);
-        menu->addChild(createMenuLabel("Algorithm"));
         
-        // This will be implemented when we have actual algorithms loaded
+        // Algorithm chain submenu (slot 0 is the plugin loaded above)
+        menu->addChild(createSubmenuItem("Algorithm Chain", string::f("%d", module->pluginManager->getSlotCount()), [=](Menu* menu) {
+            if (!module->isPluginLoaded()) {
+                menu->addChild(createMenuLabel("Load a plugin first"));
+                return;
+            }
+            const char* primaryName = module->pluginManager->getFactory()->name;
+            menu->addChild(createMenuLabel(string::f("0: %s", primaryName ? primaryName : "Unknown")));
+            for (int slot = 1; slot < module->pluginManager->getSlotCount(); slot++) {
+                const AlgorithmSlot* algorithmSlot = module->pluginManager->getSlot(slot);
+                std::string label = string::f("%d: %s", slot, algorithmSlot->getName());
+                uint32_t slotId = algorithmSlot->id;
+                menu->addChild(createSubmenuItem(label, algorithmSlot->faulted ? "Crashed" : "", [=](Menu* menu) {
+                    appendSlotParameterMenu(menu, module, slotId);
+                }));
+            }
+            menu->addChild(new MenuSeparator);
+            menu->addChild(createMenuItem("Add Algorithm...", "", [=]() {
+                addAlgorithmDialog(module);
+            }, module->pluginManager->getSlotCount() >= PluginManager::MAX_SLOTS));
+        }));
+    }
+    
+    // Adjusts one parameter of a chained slot from the context menu
+    // Holds the slot's id, not its position, which shifts when an earlier
+    // slot is removed while the menu is open
+    struct SlotParameterQuantity : Quantity {
+        EmulatorModule* module;
+        uint32_t slotId;
+        int paramIdx;
+        
+        const _NT_parameter* getInfo() const {
+            return module->parameterSystem->getSlotParameterInfo(module->pluginManager->findSlot(slotId), paramIdx);
+        }
+        void setValue(float value) override {
+            int slot = module->pluginManager->findSlot(slotId);
+            if (slot > 0) {
+                module->parameterSystem->setSlotParameterValue(slot, paramIdx, (int16_t)std::round(value));
+            }
+        }
+        float getValue() override {
+            return module->parameterSystem->getSlotParameterValue(module->pluginManager->findSlot(slotId), paramIdx);
+        }
+        float getMinValue() override { return getInfo() ? getInfo()->min : 0.f; }
+        float getMaxValue() override { return getInfo() ? getInfo()->max : 0.f; }
+        float getDefaultValue() override { return getInfo() ? getInfo()->def : 0.f; }
+        std::string getLabel() override {
+            return (getInfo() && getInfo()->name) ? getInfo()->name : string::f("Parameter %d", paramIdx);
+        }
+        int getDisplayPrecision() override { return 0; }
+    };
+    
+    struct SlotParameterSlider : ui::Slider {
+        SlotParameterSlider(EmulatorModule* module, uint32_t slotId, int paramIdx) {
+            SlotParameterQuantity* slotQuantity = new SlotParameterQuantity;
+            slotQuantity->module = module;
+            slotQuantity->slotId = slotId;
+            slotQuantity->paramIdx = paramIdx;
+            quantity = slotQuantity;
+            box.size.x = 220.f;
+        }
+        ~SlotParameterSlider() {
+            delete quantity;
+        }
+    };
+    
+    void appendSlotParameterMenu(Menu* menu, EmulatorModule* module, uint32_t slotId) {
+        int slot = module->pluginManager->findSlot(slotId);
+        if (slot < 1) return;
+        size_t count = module->parameterSystem->getSlotParameterCount(slot);
+        for (size_t i = 0; i < count; i++) {
+            menu->addChild(new SlotParameterSlider(module, slotId, (int)i));
+        }
+        if (count > 0) {
+            menu->addChild(new MenuSeparator);
+        }
+        menu->addChild(createMenuItem("Remove", "", [=]() {
+            int current = module->pluginManager->findSlot(slotId);
+            if (current > 0) {
+                module->removeAlgorithmSlot(current);
+            }
+        }));
+    }
+    
+    void addAlgorithmDialog(EmulatorModule* module) {
+        std::string startPath = module->lastPluginFolder.empty() ?
+            asset::user("") : module->lastPluginFolder;
+        
+        osdialog_filters* filters = osdialog_filters_parse(
+            "Disting NT Plugin:dylib,so,dll"
+        );
+        
+        // Chained algorithms use their default specifications
+        char* pathC = osdialog_file(OSDIALOG_OPEN, startPath.c_str(), NULL, filters);
+        if (pathC) {
+            std::string path = pathC;
+            free(pathC);
+            module->lastPluginFolder = rack::system::getDirectory(path);
+            module->addAlgorithmSlot(path);
+        }
+        
+        osdialog_filters_free(filters);
     }
     
     void loadPluginDialog(EmulatorModule* module, std::string startPath = "") {
@@ -2049,6 +2699,65 @@ struct EmulatorWidget : ModuleWidget {
         osdialog_filters_free(filters);
     }
 
+    void appendHardwareLoadMenu(Menu* menu, EmulatorModule* module) {
+        const HardwareLoadEstimator& estimator = HardwareLoadEstimator::getInstance();
+        if (!estimator.isCalibrated()) {
+            menu->addChild(createMenuLabel("Calibrating..."));
+            return;
+        }
+        
+        // Window percentiles of the block's step() time; single blocks are
+        // too exposed to host preemption to warn on
+        PluginExecutor::HardwareLoadStats stats = module->pluginExecutor->getHardwareLoadStats();
+        
+        menu->addChild(createMenuLabel(string::f("NT load: %.0f%% mean, %.0f%% p99, %.0f%% peak",
+            stats.meanPercent, stats.p99Percent, stats.peakPercent)));
+        menu->addChild(createMenuLabel(string::f("Scale %.1fx host (kernel range %.1f - %.1f)",
+            estimator.getScale(), estimator.getMinScale(), estimator.getMaxScale())));
+        if (stats.p99Percent > 100.f) {
+            menu->addChild(createMenuLabel(string::f("WARNING: would overrun on the NT (p99 over %u blocks)", stats.windowBlocks)));
+        } else if (stats.p99Percent > 80.f) {
+            menu->addChild(createMenuLabel("Caution: less than 20% headroom on the NT"));
+        }
+    }
+    
+    void recordDisplayDialog(EmulatorModule* module) {
+        osdialog_filters* filters = osdialog_filters_parse("Display recording:ntfr");
+        char* pathC = osdialog_file(OSDIALOG_SAVE, asset::user("").c_str(), "nt_emu_display.ntfr", filters);
+        if (pathC) {
+            std::string path = pathC;
+            free(pathC);
+            if (rack::system::getExtension(path).empty()) {
+                path += ".ntfr";
+            }
+            
+            std::string error;
+            if (!module->displayScheduler->startRecording(path, error)) {
+                WARN("%s", error.c_str());
+            }
+        }
+        osdialog_filters_free(filters);
+    }
+    
+    void saveProfileDialog(EmulatorModule* module) {
+        osdialog_filters* filters = osdialog_filters_parse("JSON:json");
+        char* pathC = osdialog_file(OSDIALOG_SAVE, asset::user("").c_str(), "nt_emu_profile.json", filters);
+        if (pathC) {
+            std::string path = pathC;
+            free(pathC);
+            if (rack::system::getExtension(path).empty()) {
+                path += ".json";
+            }
+            
+            json_t* profileJ = module->profileToJson();
+            if (json_dump_file(profileJ, path.c_str(), JSON_INDENT(2)) != 0) {
+                WARN("Could not write profile to %s", path.c_str());
+            }
+            json_decref(profileJ);
+        }
+        osdialog_filters_free(filters);
+    }
+
     void selectVirtualSdCardFolder(EmulatorModule* module) {
         std::string startPath = module->virtualSdCardPath.empty() ?
             asset::user("") : module->virtualSdCardPath;
@@ -2058,8 +2767,7 @@ struct EmulatorWidget : ModuleWidget {
             std::string path = pathC;
             free(pathC);
 
-            module->virtualSdCardPath = path;
-            VirtualSdCard::getInstance().setRootPath(path);
+            module->setVirtualSdCardPath(path);
             INFO("NtEmu: Set virtual SD card path: %s", path.c_str());
         }
     }
@@ -2212,41 +2920,58 @@ struct EmulatorWidget : ModuleWidget {
 
 Model* modelNtEmu = createModel<EmulatorModule, EmulatorWidget>("nt_emu");
 
-extern "C" void emulatorHandleSetParameterFromUi(uint32_t parameter, int16_t value) {
-    if (g_currentModule) {
-        g_currentModule->handleSetParameterFromUi(parameter, value);
+// Module whose plugin is currently calling into the NT API
+static EmulatorModule* currentModule() {
+    NTApiContext* context = NTApi::getCurrentContext();
+    return context ? context->module : nullptr;
+}
+
+extern "C" void emulatorHandleSetParameterFromUi(uint32_t algorithmIndex, uint32_t parameter, int16_t value) {
+    EmulatorModule* module = currentModule();
+    if (!module) return;
+    if (algorithmIndex == 0) {
+        module->handleSetParameterFromUi(parameter, value);
+    } else if (module->parameterSystem) {
+        // Chained slot: observers forward parameterChanged to that slot
+        module->parameterSystem->setSlotParameterValue(algorithmIndex, parameter, value);
     }
 }
 
 extern "C" void emulatorHandleSetParameterGrayedOut(uint32_t parameter, bool gray) {
-    if (g_currentModule && g_currentModule->parameterSystem) {
-        g_currentModule->parameterSystem->setParameterGrayedOut(parameter, gray);
-        g_currentModule->displayDirty = true;
+    EmulatorModule* module = currentModule();
+    if (module && module->parameterSystem) {
+        module->parameterSystem->setParameterGrayedOut(parameter, gray);
+        module->displayDirty = true;
     }
 }
 
 extern "C" void emulatorHandleUpdateParameterDefinition(uint32_t parameterIndex) {
-    if (g_currentModule && g_currentModule->parameterSystem) {
-        g_currentModule->parameterSystem->updateParameterDefinition(parameterIndex);
-        g_currentModule->displayDirty = true;
+    EmulatorModule* module = currentModule();
+    if (module && module->parameterSystem) {
+        module->parameterSystem->updateParameterDefinition(parameterIndex);
+        module->displayDirty = true;
     }
 }
 
 extern "C" void emulatorHandleUpdateParameterPages() {
-    if (g_currentModule && g_currentModule->parameterSystem) {
-        g_currentModule->parameterSystem->reExtractParameterPages();
-        g_currentModule->displayDirty = true;
+    EmulatorModule* module = currentModule();
+    if (module && module->parameterSystem) {
+        module->parameterSystem->reExtractParameterPages();
+        module->displayDirty = true;
     }
 }
 
-extern "C" void emulatorHandleSetParameterFromAudio(uint32_t parameter, int16_t value) {
-    if (g_currentModule && g_currentModule->parameterSystem) {
+extern "C" void emulatorHandleSetParameterFromAudio(uint32_t algorithmIndex, uint32_t parameter, int16_t value) {
+    EmulatorModule* module = currentModule();
+    if (module && module->parameterSystem && algorithmIndex != 0) {
+        module->parameterSystem->writeSlotParameterValue(algorithmIndex, parameter, value);
+    } else if (module && module->parameterSystem) {
         // Write directly to routing matrix without observer notification
         // to avoid re-entrancy (plugin is already inside parameterChanged).
-        auto& rm = g_currentModule->parameterSystem->getRoutingMatrix();
+        auto& rm = module->parameterSystem->getRoutingMatrix();
         if (parameter < rm.size()) {
             rm[parameter] = value;
         }
-        g_currentModule->displayDirty = true;
+        module->displayDirty = true;
     }
 }
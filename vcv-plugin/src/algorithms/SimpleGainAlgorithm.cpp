@@ -10,7 +10,8 @@ public:
     
     void step(float* buses, int numFramesBy4) override {
         // Apply gain to input bus 0 and output to bus 4
-        for (int frame = 0; frame < numFramesBy4 * 4; frame += 4) {
+        const int numFrames = numFramesBy4 * 4;
+        for (int frame = 0; frame < numFrames; frame += 4) {
             for (int sample = 0; sample < 4; sample++) {
                 int index = frame + sample;
                 
@@ -20,8 +21,8 @@ public:
                 // Apply gain
                 float output = input * gain;
                 
-                // Send to output bus 4 
-                buses[4 * 4 + index] = output; // Bus 4 for audio output
+                // Send to output bus 4 (each bus holds numFrames samples)
+                buses[4 * numFrames + index] = output; // Bus 4 for audio output
             }
         }
     }
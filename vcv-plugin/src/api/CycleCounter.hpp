@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#endif
+
+namespace NTApi {
+    // Free-running host counter behind NT_getCpuCycleCount(). Like the
+    // Cortex-M7 DWT cycle counter it wraps and only differences between two
+    // reads are meaningful. Units are TSC ticks on x86, the generic timer on
+    // ARM64 and nanoseconds elsewhere.
+    inline uint64_t readCycleCounter() {
+    #if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+    #elif defined(__aarch64__)
+        uint64_t value;
+        __asm__ volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+    #else
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    #endif
+    }
+
+    // Monotonic wall time for profiling, in nanoseconds
+    inline uint64_t readNanoseconds() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
@@ -0,0 +1,113 @@
+// Plugins resolve NT_screen and NT_globals from the host binary, so the API's
+// declarations must have default visibility even under -fvisibility=hidden.
+// A visibility attribute on the definitions alone is ignored after them.
+#pragma GCC visibility push(default)
+#include <distingnt/api.h>
+#pragma GCC visibility pop
+
+#include "NTApiContext.hpp"
+#include "../dsp/BusSystem.hpp"
+#include <cstring>
+
+// Shared drawing surface. Plugins write to this symbol directly, so it stays a
+// single global; draw() calls are serialised and each frame is copied into the
+// owning module's NTApiContext::screen.
+uint8_t NT_screen[128 * 64];
+
+// Read when NT_globals is initialised. Being volatile, it forces dynamic
+// initialisation, which keeps NT_globals out of read-only memory (a constant
+// initialiser would let the compiler put it there).
+static volatile uint32_t g_initialSampleRate = 48000;
+
+// Process-wide globals for plugins that read the NT_globals symbol directly,
+// defined const exactly as distingnt/api.h declares it. Per-instance values
+// (sample rate, block size) are in NTApiContext::globals, handed out through
+// getNT_API()->globals. The sample rate is Rack's engine rate, the same for
+// every instance, so setSampleRate() mirrors it here. The step block size is
+// not: instances running different block sizes on different threads would
+// race on one shared field, so maxFramesPerStep here stays at the largest
+// selectable size, a valid upper bound for sizing buffers.
+extern "C" {
+const _NT_globals NT_globals = {
+    .sampleRate = g_initialSampleRate,
+    .maxFramesPerStep = BusSystem::MAX_BLOCK_FRAMES,
+    .workBuffer = nullptr,
+    .workBufferSizeBytes = 0
+};
+}
+
+namespace NTApi {
+    static thread_local NTApiContext* g_currentContext = nullptr;
+    static thread_local int32_t g_currentAlgorithmIndex = 0;
+
+    NTApiContext* getCurrentContext() {
+        return g_currentContext;
+    }
+
+    void setSampleRate(NTApiContext* context, uint32_t sampleRate) {
+        context->globals.sampleRate = sampleRate;
+        // The only write to NT_globals. Plugins see it as const, like on the
+        // hardware, where the firmware updates it too; the storage is writable
+        // because of the dynamic initialiser above.
+        const_cast<_NT_globals&>(NT_globals).sampleRate = sampleRate;
+    }
+
+    ScopedContext::ScopedContext(NTApiContext* context) : previous(g_currentContext) {
+        g_currentContext = context;
+    }
+
+    ScopedContext::~ScopedContext() {
+        g_currentContext = previous;
+    }
+
+    int32_t getCurrentAlgorithmIndex() {
+        return g_currentAlgorithmIndex;
+    }
+
+    ScopedAlgorithmIndex::ScopedAlgorithmIndex(int32_t index) : previous(g_currentAlgorithmIndex) {
+        g_currentAlgorithmIndex = index;
+    }
+
+    ScopedAlgorithmIndex::~ScopedAlgorithmIndex() {
+        g_currentAlgorithmIndex = previous;
+    }
+
+    // Rows of NT_screen that may be non-zero. Guarded by the screen mutex.
+    static uint64_t g_litRows = NTApiContext::ALL_ROWS;
+
+    std::mutex& getScreenMutex() {
+        static std::mutex screenMutex;
+        return screenMutex;
+    }
+
+    void beginScreenFrame() {
+        const int rowBytes = NTApiContext::SCREEN_ROW_BYTES;
+        for (int y = 0; y < NTApiContext::SCREEN_ROWS; y++) {
+            if (g_litRows & (1ull << y)) {
+                memset(NT_screen + y * rowBytes, 0, rowBytes);
+            }
+        }
+        // Unknown again until the frame is captured
+        g_litRows = NTApiContext::ALL_ROWS;
+    }
+
+    void captureScreen(NTApiContext* context) {
+        if (!context) return;
+
+        const int rowBytes = NTApiContext::SCREEN_ROW_BYTES;
+        static const uint8_t blankRow[NTApiContext::SCREEN_ROW_BYTES] = {};
+        uint64_t lit = 0;
+        for (int y = 0; y < NTApiContext::SCREEN_ROWS; y++) {
+            const uint8_t* row = NT_screen + y * rowBytes;
+            uint8_t* captured = context->screen + y * rowBytes;
+            if (memcmp(captured, row, rowBytes) != 0) {
+                memcpy(captured, row, rowBytes);
+                context->dirtyRows |= 1ull << y;
+            }
+            if (memcmp(row, blankRow, rowBytes) != 0) {
+                lit |= 1ull << y;
+            }
+        }
+        g_litRows = lit;
+    }
+}
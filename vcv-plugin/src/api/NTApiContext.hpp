@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../nt_api_interface.h"
+#include <cstdint>
+#include <mutex>
+
+// Forward declarations
+struct EmulatorModule;
+class MidiProcessor;
+
+/**
+ * NTApiContext - Per-module state behind the NT_* C API
+ *
+ * Plugins call NT_* functions without saying which module they belong to.
+ * Each EmulatorModule owns one context and installs it in thread-local
+ * storage (NTApi::ScopedContext) around every call into its plugin, so the
+ * callbacks resolve to the right instance even when Rack runs modules on
+ * several engine threads.
+ */
+struct NTApiContext {
+    static constexpr int SCREEN_ROW_BYTES = 128;
+    static constexpr int SCREEN_ROWS = 64;
+    static constexpr int SCREEN_BYTES = SCREEN_ROW_BYTES * SCREEN_ROWS;
+    static constexpr uint64_t ALL_ROWS = ~0ull;
+
+    EmulatorModule* module = nullptr;       // Target of parameter callbacks
+    MidiProcessor* midiSink = nullptr;      // Target of NT_sendMidi*
+    _NT_globals globals = {};               // Per-instance, returned through getNT_API()->globals
+    NT_API_Interface apiInterface = {};     // Per-instance copy of the API table
+
+    // Last frame drawn by this instance's plugin (4-bit, 2 pixels per byte)
+    alignas(16) uint8_t screen[SCREEN_BYTES] = {};
+
+    // Bit y set when row y of `screen` has changed since the display last
+    // cleared it. Set by captureScreen(); read and cleared by the display
+    // thread when it publishes the frame (see DisplayScheduler).
+    uint64_t dirtyRows = ALL_ROWS;
+};
+
+namespace NTApi {
+    // Context installed on the calling thread, or nullptr outside plugin calls
+    NTApiContext* getCurrentContext();
+
+    // Fills the context's API table once; getNT_API() then only hands it out
+    void initApiInterface(NTApiContext* context);
+
+    // Engine thread (or before processing starts): updates the context and
+    // the exported NT_globals symbol
+    void setSampleRate(NTApiContext* context, uint32_t sampleRate);
+
+    // Installs a context for the lifetime of the scope; nests safely
+    class ScopedContext {
+    public:
+        explicit ScopedContext(NTApiContext* context);
+        ~ScopedContext();
+
+        ScopedContext(const ScopedContext&) = delete;
+        ScopedContext& operator=(const ScopedContext&) = delete;
+
+    private:
+        NTApiContext* previous;
+    };
+
+    // Chain slot being called on this thread (NT_algorithmIndex), 0 outside
+    // chained calls. ScopedAlgorithmIndex marks a call into slot 1..N.
+    int32_t getCurrentAlgorithmIndex();
+
+    class ScopedAlgorithmIndex {
+    public:
+        explicit ScopedAlgorithmIndex(int32_t index);
+        ~ScopedAlgorithmIndex();
+
+        ScopedAlgorithmIndex(const ScopedAlgorithmIndex&) = delete;
+        ScopedAlgorithmIndex& operator=(const ScopedAlgorithmIndex&) = delete;
+
+    private:
+        int32_t previous;
+    };
+
+    // Plugins draw into the exported NT_screen symbol, which every instance
+    // shares. Hold this lock from beginScreenFrame() until captureScreen().
+    //
+    // Plugins may write NT_screen directly, so changes can't be tracked at
+    // the NT_draw* calls. Instead captureScreen() compares the frame with the
+    // context's previous one row by row, copies only rows that differ and
+    // marks them in dirtyRows; it also notes which rows are lit so the next
+    // beginScreenFrame() only clears those.
+    std::mutex& getScreenMutex();
+    void beginScreenFrame();
+    void captureScreen(NTApiContext* context);
+}
@@ -1,6 +1,10 @@
 #include "NTApiWrapper.hpp"
+#include "NTApiContext.hpp"
+#include "NTRaster.hpp"
+#include "CycleCounter.hpp"
 #include "VirtualSdCard.hpp"
 #include "VirtualScalaLibrary.hpp"
+#include "../log/RtLog.hpp"
 #include <logger.hpp>
 #include <cstdio>
 #include <cstring>
@@ -139,43 +143,17 @@ namespace NTApi {
     
     // Helper function to set a single pixel in NT_screen buffer with clipping
     void setNTPixel(int x, int y, int colour) {
-        // Clip coordinates to screen bounds
-        if (x < 0 || x >= SCREEN_WIDTH || y < 0 || y >= SCREEN_HEIGHT) {
-            return; // Out of bounds - just return without drawing
-        }
-        
-        int byte_idx = y * 128 + x / 2;
-        colour = colour & 0x0F;  // Ensure 4-bit value
-        
-        if (x & 1) {
-            // Odd x: low nibble (bits 0-3)
-            NT_screen[byte_idx] = (NT_screen[byte_idx] & 0xF0) | colour;
-        } else {
-            // Even x: high nibble (bits 4-7)
-            NT_screen[byte_idx] = (NT_screen[byte_idx] & 0x0F) | (colour << 4);
-        }
+        NTRaster::setPixel(NT_screen, x, y, colour);
     }
     
-    // Bresenham's line algorithm with clipping
+    // Line with Cohen-Sutherland clipping; NTRaster draws the clipped segment
     void drawNTLine(int x0, int y0, int x1, int y1, int colour) {
         // First clip the line to screen bounds
         if (!clipLine(x0, y0, x1, y1)) {
             return; // Line is completely outside screen bounds
         }
         
-        int dx = abs(x1 - x0);
-        int dy = abs(y1 - y0);
-        int sx = x0 < x1 ? 1 : -1;
-        int sy = y0 < y1 ? 1 : -1;
-        int err = dx - dy;
-        
-        while (true) {
-            setNTPixel(x0, y0, colour);
-            if (x0 == x1 && y0 == y1) break;
-            int e2 = 2 * err;
-            if (e2 > -dy) { err -= dy; x0 += sx; }
-            if (e2 < dx) { err += dx; y0 += sy; }
-        }
+        NTRaster::clippedLine(NT_screen, x0, y0, x1, y1, colour);
     }
     
     // Helper functions implementation stays in namespace
@@ -245,17 +223,14 @@ extern "C" {
             default: fontType = NT::FontType::NORMAL; break;
         }
         
-        // Get accurate text width using shared font system
-        int text_width = NT::getTextWidth(str, fontType);
+        // Apply alignment; left-aligned text doesn't need its width
         int start_x = x;
-        
-        // Apply alignment
         switch (align) {
             case kNT_textCentre:
-                start_x = x - text_width / 2;
+                start_x = x - NT::getTextWidth(str, fontType) / 2;
                 break;
             case kNT_textRight:
-                start_x = x - text_width;
+                start_x = x - NT::getTextWidth(str, fontType);
                 break;
             case kNT_textLeft:
             default:
@@ -283,29 +258,15 @@ extern "C" {
                 NTApi::drawNTLine(x0, y0, x1, y1, colour);
                 break;
                 
-            case kNT_box: {
+            case kNT_box:
                 // Unfilled rectangle (box outline)
-                NTApi::drawNTLine(x0, y0, x1, y0, colour); // Top
-                NTApi::drawNTLine(x1, y0, x1, y1, colour); // Right
-                NTApi::drawNTLine(x1, y1, x0, y1, colour); // Bottom
-                NTApi::drawNTLine(x0, y1, x0, y0, colour); // Left
+                NTRaster::box(NT_screen, x0, y0, x1, y1, colour);
                 break;
-            }
             
-            case kNT_rectangle: {
-                // Filled rectangle with clipping
-                // Clip rectangle bounds to screen
-                int clipX0 = std::max(0, std::min(x0, x1));
-                int clipY0 = std::max(0, std::min(y0, y1));
-                int clipX1 = std::min(NTApi::SCREEN_WIDTH - 1, std::max(x0, x1));
-                int clipY1 = std::min(NTApi::SCREEN_HEIGHT - 1, std::max(y0, y1));
-                
-                // Draw horizontal lines for filled rectangle
-                for (int y = clipY0; y <= clipY1; y++) {
-                    NTApi::drawNTLine(clipX0, y, clipX1, y, colour);
-                }
+            case kNT_rectangle:
+                // Filled rectangle, clipped to the screen
+                NTRaster::fillRect(NT_screen, x0, y0, x1, y1, colour);
                 break;
-            }
             
             default:
                 // Unknown shape - draw a point
@@ -319,8 +280,8 @@ extern "C" {
     }
     
     __attribute__((visibility("default"))) int32_t NT_algorithmIndex(const _NT_algorithm* algorithm) {
-        // For now, return 0 as we only support one algorithm at a time in VCV
-        return 0;
+        // Position in the module's algorithm chain of the slot being called
+        return NTApi::getCurrentAlgorithmIndex();
     }
     
     __attribute__((visibility("default"))) uint32_t NT_parameterOffset(void) {
@@ -329,25 +290,27 @@ extern "C" {
     }
     
     // Forward declaration
-    extern "C" void emulatorHandleSetParameterFromUi(uint32_t parameter, int16_t value);
+    extern "C" void emulatorHandleSetParameterFromUi(uint32_t algorithmIndex, uint32_t parameter, int16_t value);
     
     __attribute__((visibility("default"))) void NT_setParameterFromUi(uint32_t algorithmIndex, uint32_t parameter, int16_t value) {
-        INFO("NT_setParameterFromUi called: alg=%d, param=%d, value=%d", algorithmIndex, parameter, value);
-        emulatorHandleSetParameterFromUi(parameter, value);
+        RT_DEBUG(Plugin, "NT_setParameterFromUi called: alg=%u, param=%u, value=%d", algorithmIndex, parameter, value);
+        emulatorHandleSetParameterFromUi(algorithmIndex, parameter, value);
     }
     
     // Forward declaration
-    extern "C" void emulatorHandleSetParameterFromAudio(uint32_t parameter, int16_t value);
+    extern "C" void emulatorHandleSetParameterFromAudio(uint32_t algorithmIndex, uint32_t parameter, int16_t value);
 
     __attribute__((visibility("default"))) void NT_setParameterFromAudio(uint32_t algorithmIndex, uint32_t parameter, int16_t value) {
-        emulatorHandleSetParameterFromAudio(parameter, value);
+        emulatorHandleSetParameterFromAudio(algorithmIndex, parameter, value);
     }
 
     // Forward declaration for grayed out handler
     extern "C" void emulatorHandleSetParameterGrayedOut(uint32_t parameter, bool gray);
 
     __attribute__((visibility("default"))) void NT_setParameterGrayedOut(uint32_t algorithmIndex, uint32_t parameter, bool gray) {
-        INFO("NT_setParameterGrayedOut called: alg=%d, param=%d, gray=%d", algorithmIndex, parameter, gray ? 1 : 0);
+        RT_DEBUG(Plugin, "NT_setParameterGrayedOut called: alg=%u, param=%u, gray=%d", algorithmIndex, parameter, gray ? 1 : 0);
+        // Only slot 0 has menu pages; chained slots have no grayed-out state
+        if (algorithmIndex != 0) return;
         emulatorHandleSetParameterGrayedOut(parameter, gray);
     }
 
@@ -355,6 +318,7 @@ extern "C" {
     extern "C" void emulatorHandleUpdateParameterDefinition(uint32_t parameterIndex);
 
     __attribute__((visibility("default"))) void NT_updateParameterDefinition(uint32_t algorithmIndex, uint32_t parameterIndex) {
+        if (algorithmIndex != 0) return;
         emulatorHandleUpdateParameterDefinition(parameterIndex);
     }
 
@@ -362,12 +326,13 @@ extern "C" {
     extern "C" void emulatorHandleUpdateParameterPages();
 
     __attribute__((visibility("default"))) void NT_updateParameterPages(uint32_t algorithmIndex) {
+        if (algorithmIndex != 0) return;
         emulatorHandleUpdateParameterPages();
     }
 
     __attribute__((visibility("default"))) uint32_t NT_getCpuCycleCount(void) {
-        // Simple implementation for profiling - could use mach_absolute_time() on macOS
-        return 0;
+        // Wraps at 32 bits like the hardware counter; plugins take differences
+        return (uint32_t)NTApi::readCycleCounter();
     }
     
     __attribute__((visibility("default"))) void NT_setParameterRange(_NT_parameter* ptr, float init, float min, float max, float step) {
@@ -0,0 +1,99 @@
+#include "NTGlyphAtlas.hpp"
+#include "NTRaster.hpp"
+#include <algorithm>
+
+namespace {
+    // colourScale[colour][b]: both coverage nibbles of b scaled by colour
+    struct ColourScale {
+        uint8_t table[16][256];
+
+        ColourScale() {
+            for (int colour = 0; colour < 16; colour++) {
+                for (int b = 0; b < 256; b++) {
+                    int high = ((b >> 4) * colour + 7) / 15;
+                    int low = ((b & 0x0F) * colour + 7) / 15;
+                    table[colour][b] = (uint8_t)((high << 4) | low);
+                }
+            }
+        }
+    };
+
+    const ColourScale& colourScale() {
+        static const ColourScale scale;
+        return scale;
+    }
+}
+
+NTGlyphAtlas::NTGlyphAtlas(int glyphCount, int width, int height)
+    : glyphCount(glyphCount), width(width), height(height),
+      stride(width / 2 + 1), glyphs(glyphCount),
+      packed((size_t)glyphCount * 2 * height * stride, 0),
+      masks(packed.size(), 0) {
+}
+
+void NTGlyphAtlas::setGlyph(int index, const uint8_t* coverage) {
+    if (index < 0 || index >= glyphCount) return;
+    Glyph& glyph = glyphs[index];
+    glyph = Glyph();
+    glyph.byteBegin[0] = glyph.byteBegin[1] = (uint8_t)stride;
+
+    int rowBegin = height, rowEnd = 0;
+    for (int alignment = 0; alignment < 2; alignment++) {
+        uint8_t* rowPacked = &packed[offset(index, alignment)];
+        uint8_t* rowMasks = &masks[offset(index, alignment)];
+        for (int row = 0; row < height; row++, rowPacked += stride, rowMasks += stride) {
+            std::fill(rowPacked, rowPacked + stride, 0);
+            std::fill(rowMasks, rowMasks + stride, 0);
+            for (int col = 0; col < width; col++) {
+                uint8_t value = coverage[row * width + col] & 0x0F;
+                if (!value) continue;
+
+                // Same nibble order as the screen: even x in the high nibble
+                int x = col + alignment;
+                int shift = (x & 1) ? 0 : 4;
+                rowPacked[x >> 1] |= value << shift;
+                rowMasks[x >> 1] |= 0x0F << shift;
+
+                rowBegin = std::min(rowBegin, row);
+                rowEnd = std::max(rowEnd, row + 1);
+                glyph.byteBegin[alignment] = (uint8_t)std::min((int)glyph.byteBegin[alignment], x >> 1);
+                glyph.byteEnd[alignment] = (uint8_t)std::max((int)glyph.byteEnd[alignment], (x >> 1) + 1);
+            }
+        }
+    }
+    if (rowEnd > rowBegin) {
+        glyph.rowBegin = (uint8_t)rowBegin;
+        glyph.rowEnd = (uint8_t)rowEnd;
+    } else {
+        glyph = Glyph();
+    }
+}
+
+void NTGlyphAtlas::draw(uint8_t* screen, int x, int top, int index, int colour) const {
+    if (index < 0 || index >= glyphCount) return;
+    const Glyph& glyph = glyphs[index];
+
+    // Clip rows and bytes once; a screen byte holds both pixels of a pair
+    int rowBegin = std::max((int)glyph.rowBegin, -top);
+    int rowEnd = std::min((int)glyph.rowEnd, NTRaster::HEIGHT - top);
+    if (rowBegin >= rowEnd) return;
+
+    int alignment = x & 1;
+    int baseByte = (x - alignment) / 2;
+    int byteBegin = std::max((int)glyph.byteBegin[alignment], -baseByte);
+    int byteEnd = std::min((int)glyph.byteEnd[alignment], NTRaster::ROW_BYTES - baseByte);
+    if (byteBegin >= byteEnd) return;
+
+    const uint8_t* scale = colourScale().table[colour & 0x0F];
+    const uint8_t* src = &packed[offset(index, alignment) + rowBegin * stride];
+    const uint8_t* mask = &masks[offset(index, alignment) + rowBegin * stride];
+    uint8_t* dst = screen + (top + rowBegin) * NTRaster::ROW_BYTES + baseByte;
+    for (int row = rowBegin; row < rowEnd; row++) {
+        for (int b = byteBegin; b < byteEnd; b++) {
+            dst[b] = (uint8_t)((dst[b] & ~mask[b]) | scale[src[b]]);
+        }
+        src += stride;
+        mask += stride;
+        dst += NTRaster::ROW_BYTES;
+    }
+}
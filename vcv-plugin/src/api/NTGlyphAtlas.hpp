@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * NTGlyphAtlas - A font pre-packed in NT_screen's nibble format
+ *
+ * Each glyph is stored twice, once for an even and once for an odd start
+ * x, as packed coverage bytes plus a mask of the nibbles it covers. Drawing
+ * a glyph row is then a byte loop, dst = (dst & ~mask) | colour(coverage),
+ * with clipping done once per glyph against the screen edges rather than
+ * per pixel. Blank rows and the blank bytes either side of the ink are
+ * trimmed when the glyph is added.
+ *
+ * Coverage is 0-15; drawn pixels are scaled by the text colour as
+ * (coverage * colour + 7) / 15, so 1-bit fonts (coverage 15) draw in the
+ * colour itself and anti-aliased fonts keep their ramps.
+ */
+class NTGlyphAtlas {
+public:
+    NTGlyphAtlas(int glyphCount, int width, int height);
+
+    // coverage: width * height values, row-major; non-zero pixels are drawn
+    void setGlyph(int index, const uint8_t* coverage);
+
+    // Draws glyph `index` with its top-left pixel at (x, top)
+    void draw(uint8_t* screen, int x, int top, int index, int colour) const;
+
+private:
+    struct Glyph {
+        uint8_t rowBegin = 0, rowEnd = 0;       // Rows with ink
+        uint8_t byteBegin[2] = {0, 0};          // Bytes with ink, per alignment
+        uint8_t byteEnd[2] = {0, 0};
+    };
+
+    int glyphCount;
+    int width;
+    int height;
+    int stride;             // Bytes per packed row, enough for an odd start
+
+    std::vector<Glyph> glyphs;
+    std::vector<uint8_t> packed;    // [glyph][alignment][row][stride]
+    std::vector<uint8_t> masks;     // Same layout
+
+    size_t offset(int index, int alignment) const {
+        return ((size_t)index * 2 + alignment) * height * stride;
+    }
+};
@@ -0,0 +1,109 @@
+#include "NTRaster.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace NTRaster {
+
+    namespace {
+        // Clips [lo, hi] to [0, limit); false if nothing is left
+        bool clipRange(int& lo, int& hi, int limit) {
+            if (lo > hi) std::swap(lo, hi);
+            if (hi < 0 || lo >= limit) return false;
+            lo = std::max(lo, 0);
+            hi = std::min(hi, limit - 1);
+            return true;
+        }
+
+        // Pixels [x0, x1] of one row, already clipped and ordered
+        inline void spanRow(uint8_t* row, int x0, int x1, uint8_t colour) {
+            if (x0 & 1) {
+                // Odd left edge: low nibble of its byte
+                row[x0 >> 1] = (row[x0 >> 1] & 0xF0) | colour;
+                x0++;
+            }
+            if (x0 > x1) return;
+            if (!(x1 & 1)) {
+                // Even right edge: high nibble of its byte
+                row[x1 >> 1] = (row[x1 >> 1] & 0x0F) | (colour << 4);
+                x1--;
+            }
+            if (x0 < x1) {
+                memset(row + (x0 >> 1), colour * 0x11, (x1 - x0 + 1) >> 1);
+            }
+        }
+    }
+
+    void fillSpan(uint8_t* screen, int x0, int x1, int y, int colour) {
+        if ((unsigned)y >= (unsigned)HEIGHT || !clipRange(x0, x1, WIDTH)) return;
+        spanRow(screen + y * ROW_BYTES, x0, x1, (uint8_t)(colour & 0x0F));
+    }
+
+    void verticalLine(uint8_t* screen, int x, int y0, int y1, int colour) {
+        if ((unsigned)x >= (unsigned)WIDTH || !clipRange(y0, y1, HEIGHT)) return;
+        uint8_t keep = (x & 1) ? 0xF0 : 0x0F;
+        uint8_t bits = (x & 1) ? (uint8_t)(colour & 0x0F) : (uint8_t)((colour & 0x0F) << 4);
+        uint8_t* byte = screen + y0 * ROW_BYTES + (x >> 1);
+        for (int y = y0; y <= y1; y++, byte += ROW_BYTES) {
+            *byte = (*byte & keep) | bits;
+        }
+    }
+
+    void fillRect(uint8_t* screen, int x0, int y0, int x1, int y1, int colour) {
+        if (!clipRange(x0, x1, WIDTH) || !clipRange(y0, y1, HEIGHT)) return;
+        uint8_t c = (uint8_t)(colour & 0x0F);
+        if (x0 == 0 && x1 == WIDTH - 1) {
+            // Full-width rows are contiguous
+            memset(screen + y0 * ROW_BYTES, c * 0x11, (y1 - y0 + 1) * ROW_BYTES);
+            return;
+        }
+        for (int y = y0; y <= y1; y++) {
+            spanRow(screen + y * ROW_BYTES, x0, x1, c);
+        }
+    }
+
+    void clippedLine(uint8_t* screen, int x0, int y0, int x1, int y1, int colour) {
+        // Axis-aligned lines are spans; only diagonals need Bresenham
+        if (y0 == y1) {
+            fillSpan(screen, x0, x1, y0, colour);
+            return;
+        }
+        if (x0 == x1) {
+            verticalLine(screen, x0, y0, y1, colour);
+            return;
+        }
+
+        uint8_t c = (uint8_t)(colour & 0x0F);
+        int dx = std::abs(x1 - x0);
+        int dy = std::abs(y1 - y0);
+        int sx = x0 < x1 ? 1 : -1;
+        int sy = y0 < y1 ? ROW_BYTES : -ROW_BYTES;
+        int err = dx - dy;
+        uint8_t* row = screen + y0 * ROW_BYTES;
+        uint8_t* lastRow = screen + y1 * ROW_BYTES;
+        while (true) {
+            uint8_t* byte = row + (x0 >> 1);
+            if (x0 & 1) {
+                *byte = (*byte & 0xF0) | c;
+            } else {
+                *byte = (*byte & 0x0F) | (c << 4);
+            }
+            if (x0 == x1 && row == lastRow) break;
+            int e2 = 2 * err;
+            if (e2 > -dy) { err -= dy; x0 += sx; }
+            if (e2 < dx) { err += dx; row += sy; }
+        }
+    }
+
+    void box(uint8_t* screen, int x0, int y0, int x1, int y1, int colour) {
+        if (x0 > x1) std::swap(x0, x1);
+        if (y0 > y1) std::swap(y0, y1);
+        fillSpan(screen, x0, x1, y0, colour);
+        fillSpan(screen, x0, x1, y1, colour);
+        if (y1 - y0 > 1) {
+            verticalLine(screen, x0, y0 + 1, y1 - 1, colour);
+            verticalLine(screen, x1, y0 + 1, y1 - 1, colour);
+        }
+    }
+
+}
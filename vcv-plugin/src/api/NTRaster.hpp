@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * NTRaster - Clipped drawing primitives on a packed 4-bit screen
+ *
+ * The screen is in NT_screen layout: 128 bytes per row, two pixels per
+ * byte, the even x in the high nibble. Horizontal spans touch a partial
+ * byte only at an odd left edge or an even right edge; the whole bytes in
+ * between are filled with memset, which the C library vectorises for long
+ * runs. Vertical lines keep the nibble mask fixed and step a row at a time.
+ *
+ * Coordinates are inclusive and may be in either order; anything outside
+ * the 256x64 screen is clipped. Colours are masked to 4 bits.
+ */
+namespace NTRaster {
+    static constexpr int WIDTH = 256;
+    static constexpr int HEIGHT = 64;
+    static constexpr int ROW_BYTES = WIDTH / 2;
+
+    // Inline: callers plot shapes a pixel at a time
+    inline void setPixel(uint8_t* screen, int x, int y, int colour) {
+        if ((unsigned)x >= (unsigned)WIDTH || (unsigned)y >= (unsigned)HEIGHT) return;
+        uint8_t* byte = screen + y * ROW_BYTES + (x >> 1);
+        colour &= 0x0F;
+        if (x & 1) {
+            *byte = (*byte & 0xF0) | colour;
+        } else {
+            *byte = (*byte & 0x0F) | (colour << 4);
+        }
+    }
+
+    void fillSpan(uint8_t* screen, int x0, int x1, int y, int colour);
+    void verticalLine(uint8_t* screen, int x, int y0, int y1, int colour);
+    void fillRect(uint8_t* screen, int x0, int y0, int x1, int y1, int colour);
+    // Endpoints must already be on screen (see NTApi::drawNTLine's clipping)
+    void clippedLine(uint8_t* screen, int x0, int y0, int x1, int y1, int colour);
+    void box(uint8_t* screen, int x0, int y0, int x1, int y1, int colour);
+}
@@ -41,6 +41,12 @@ public:
     // Force re-scan of folders (call after changing root path)
     void rescan();
 
+    // Convert between formats during reading
+    static bool convertSamples(const void* src, void* dst,
+                               uint32_t numFrames,
+                               _NT_wavChannels srcChannels, _NT_wavChannels dstChannels,
+                               _NT_wavBits srcBits, _NT_wavBits dstBits);
+
 private:
     VirtualSdCard();
     ~VirtualSdCard();
@@ -64,12 +70,6 @@ private:
     // Scan a WAV file and populate its info
     bool scanWavFile(const std::string& path, WavFileInfo& info);
 
-    // Convert between formats during reading
-    bool convertSamples(const void* src, void* dst,
-                       uint32_t numFrames,
-                       _NT_wavChannels srcChannels, _NT_wavChannels dstChannels,
-                       _NT_wavBits srcBits, _NT_wavBits dstBits);
-
     std::string m_rootPath;
     std::vector<SampleFolder> m_folders;
     bool m_mounted;
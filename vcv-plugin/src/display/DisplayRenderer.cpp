@@ -1,7 +1,10 @@
 #include "DisplayRenderer.hpp"
 #include "../EmulatorCore.hpp"
 #include "../plugin/PluginManager.hpp"
+#include "../plugin/PluginExecutor.hpp"
 #include "../parameter/ParameterSystem.hpp"
+#include "../api/NTApiContext.hpp"
+#include "DisplayScheduler.hpp"
 
 namespace DisplayRenderer {
 
@@ -14,6 +17,11 @@ namespace DisplayRenderer {
             FramebufferWidget::dirty = true;
             dataProvider->setDisplayDirty(false);
         }
+        // A new frame from the plugin's draw() (the menu covers it otherwise)
+        DisplayScheduler* scheduler = dataProvider ? dataProvider->getDisplaySchedulerPtr() : nullptr;
+        if (scheduler && scheduler->hasNewFrame() && dataProvider->getMenuMode() == 0) {
+            FramebufferWidget::dirty = true;
+        }
         FramebufferWidget::step();
     }
 
@@ -69,7 +77,7 @@ namespace DisplayRenderer {
                 if (pluginManager && pluginManager->getFactory() && pluginManager->getFactory()->draw) {
                     static int drawCallCount = 0;
                     if (drawCallCount++ < 5) {
-                        INFO("Calling plugin draw() function, attempt %d", drawCallCount);
+                        INFO("Showing plugin draw() frame, attempt %d", drawCallCount);
                     }
                 } else {
                     static int failureCount = 0;
@@ -82,52 +90,10 @@ namespace DisplayRenderer {
                 }
                 
                 if (pluginManager && pluginManager->getFactory() && pluginManager->getFactory()->draw) {
-                    
-                    // Clear NT_screen buffer before plugin draws
-                    memset(NT_screen, 0, sizeof(NT_screen));
-                    
-                    static int pluginDrawCallCount = 0;
-                    if (pluginDrawCallCount++ < 5) {
-                        INFO("About to call plugin draw() for %s, attempt %d", 
-                             pluginManager->getFactory()->name ? pluginManager->getFactory()->name : "unknown", 
-                             pluginDrawCallCount);
-                    }
-                    
-                    dataProvider->safeExecutePlugin([&]() {
-                        pluginDrew = pluginManager->getFactory()->draw(pluginManager->getAlgorithm());
-                        
-                        static int drawResultCount = 0;
-                        if (drawResultCount++ < 5) {
-                            INFO("Plugin draw() returned %s, attempt %d", pluginDrew ? "true" : "false", drawResultCount);
-                            
-                            // Don't clear the buffer if plugin returned false - keep whatever it drew
-                            // The plugin may have drawn text but returned false for other reasons
-                            
-                            // Check buffer state after plugin draw but before any potential clearing
-                            INFO("NT_screen at row 40 (text area): %02x %02x %02x %02x %02x %02x %02x %02x",
-                                 NT_screen[40 * 128], NT_screen[40 * 128 + 1], NT_screen[40 * 128 + 2], NT_screen[40 * 128 + 3],
-                                 NT_screen[40 * 128 + 4], NT_screen[40 * 128 + 5], NT_screen[40 * 128 + 6], NT_screen[40 * 128 + 7]);
-                                 
-                            INFO("NT_screen first 16 bytes: %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x",
-                                 NT_screen[0], NT_screen[1], NT_screen[2], NT_screen[3],
-                                 NT_screen[4], NT_screen[5], NT_screen[6], NT_screen[7],
-                                 NT_screen[8], NT_screen[9], NT_screen[10], NT_screen[11],
-                                 NT_screen[12], NT_screen[13], NT_screen[14], NT_screen[15]);
-                        }
-                    }, "draw");
-                    
-                    // Always sync NT_screen buffer to VCV display after plugin draw call
-                    // This handles both direct NT_screen writes and NT_drawText/NT_drawShape calls
+                    // draw() runs on the DisplayScheduler thread; show its latest frame.
                     // Even if plugin returned false, it may have drawn text/shapes we want to display
-                    VCVDisplayBuffer pluginBuffer;
-                    syncNTScreenToVCVBuffer(pluginBuffer);
-                    drawDisplayBuffer(args.vg, pluginBuffer);
-                    pluginDrew = true; // Plugin attempted to draw, show the results even if it returned false
-                    
-                    static int syncCount = 0;
-                    if (syncCount++ < 5) {
-                        INFO("Synced NT_screen to VCV display buffer, attempt %d", syncCount);
-                    }
+                    drawPluginScreen(args.vg);
+                    pluginDrew = true;
                 }
                 
                 if (!pluginDrew) {
@@ -157,6 +123,13 @@ namespace DisplayRenderer {
         nvgRestore(args.vg);
     }
 
+    void ModuleOLEDWidget::onContextDestroy(const ContextDestroyEvent& e) {
+        // The images die with the context, and text widths with its fonts
+        texture.reset();
+        menuCache = MenuCache();
+        FramebufferWidget::onContextDestroy(e);
+    }
+
     void ModuleOLEDWidget::drawPlaceholder(const DrawArgs& args) {
         // Draw placeholder when module is not available (browser preview)
         nvgBeginPath(args.vg);
@@ -178,50 +151,32 @@ namespace DisplayRenderer {
         nvgText(args.vg, box.size.x / 2, box.size.y / 2, "OLED DISPLAY", nullptr);
     }
 
-    void ModuleOLEDWidget::syncNTScreenToVCVBuffer(VCVDisplayBuffer& buffer) {
-        // Convert NT_screen buffer (4-bit grayscale, 2 pixels per byte) to VCV display buffer with full grayscale support
-        // NT_screen format: 128*64 bytes, each byte contains 2 pixels (high nibble = even x, low nibble = odd x)
-        // VCV format: 256*64 pixels, grayscale values 0-15
-        
-        buffer.clear();
-        
-        for (int y = 0; y < 64; y++) {
-            for (int x = 0; x < 256; x += 2) {
-                int byte_idx = y * 128 + x / 2;
-                uint8_t byte_val = NT_screen[byte_idx];
-                
-                // Extract high nibble (even x coordinate)
-                uint8_t pixel_even = (byte_val >> 4) & 0x0F;
-                // Extract low nibble (odd x coordinate)  
-                uint8_t pixel_odd = byte_val & 0x0F;
-                
-                // Store full 4-bit grayscale values (0-15)
-                buffer.setPixelGray(x, y, pixel_even);
-                if (x + 1 < 256) {
-                    buffer.setPixelGray(x + 1, y, pixel_odd);
-                }
-            }
-        }
+    void ModuleOLEDWidget::drawPluginScreen(NVGcontext* vg) {
+        // Published frames are already in NT_screen layout, so they go to the
+        // texture as is. Only rows that changed since the frame we last took
+        // are looked at; redrawing the same frame uploads nothing.
+        DisplayScheduler* scheduler = dataProvider->getDisplaySchedulerPtr();
+        const DisplayScheduler::Frame* frame = scheduler ? scheduler->acquire() : nullptr;
+        if (!frame) return;
+        uint64_t rows = (frame->sequence != lastFrameSequence) ? frame->dirtyRows : 0;
+        lastFrameSequence = frame->sequence;
+        drawScreen(vg, frame->screen, rows, scheduler);
     }
 
     void ModuleOLEDWidget::drawDisplayBuffer(NVGcontext* vg, const VCVDisplayBuffer& buffer) {
-        // Draw the display buffer pixel by pixel with full 4-bit grayscale support
-        for (int y = 0; y < DISPLAY_HEIGHT; y++) {
-            for (int x = 0; x < DISPLAY_WIDTH; x++) {
-                uint8_t gray_value = buffer.getPixelGray(x, y);
-                if (gray_value > 0) {
-                    // Map 4-bit grayscale (0-15) to 0.0-1.0 range
-                    float intensity = (float)gray_value / 15.0f;
-                    
-                    // Set color based on intensity (white pixels with varying alpha/brightness)
-                    nvgFillColor(vg, nvgRGBA(255, 255, 255, (int)(intensity * 255)));
-                    
-                    nvgBeginPath(vg);
-                    nvgRect(vg, x, y, 1, 1);
-                    nvgFill(vg);
-                }
-            }
+        // Same packed layout; the texture finds the changed rows itself
+        drawScreen(vg, buffer.pixels.data(), OLEDTexture::ALL_ROWS, &buffer);
+    }
+
+    void ModuleOLEDWidget::drawScreen(NVGcontext* vg, const uint8_t* packed, uint64_t rows, const void* source) {
+        // Row hints are relative to the last frame from the same source
+        if (source != textureSource) {
+            rows = OLEDTexture::ALL_ROWS;
+            textureSource = source;
         }
+        // One textured quad with full 4-bit grayscale, plus the selected look
+        OLEDLook look = (OLEDLook)clamp(dataProvider->getDisplayLook(), 0, (int)OLEDLook::NUM_LOOKS - 1);
+        texture.draw(vg, packed, look, rows);
     }
 
     void ModuleOLEDWidget::drawMenuInterface(NVGcontext* vg, IDisplayDataProvider* dataProvider) {
@@ -241,6 +196,24 @@ namespace DisplayRenderer {
         auto parameterSystem = dataProvider->getParameterSystemPtr();
         if (!parameterSystem) return;
         
+        // New definitions or pages (plugin load, hot swap, NT_updateParameter*):
+        // start the cache again
+        if (menuCache.source != parameterSystem ||
+            menuCache.layoutGeneration != parameterSystem->getLayoutGeneration() ||
+            menuCache.pageNames.size() != parameterSystem->getPageCount() ||
+            menuCache.values.size() != parameterSystem->getParameterCount()) {
+            menuCache = MenuCache();
+            menuCache.source = parameterSystem;
+            menuCache.layoutGeneration = parameterSystem->getLayoutGeneration();
+            for (const _NT_parameterPage& page : parameterSystem->getParameterPages()) {
+                // Truncated to fit the page column
+                size_t length = 0;
+                while (length < 11 && page.name && page.name[length]) length++;
+                menuCache.pageNames.push_back(std::string(page.name ? page.name : "", length));
+            }
+            menuCache.values.resize(parameterSystem->getParameterCount());
+        }
+        
         // === LEFT COLUMN: PAGE LIST (always visible, scrollable) ===
         const int visiblePages = 5;
         int pageStartIdx = 0;
@@ -254,7 +227,6 @@ namespace DisplayRenderer {
         // Draw pages
         for (int i = 0; i < visiblePages && (pageStartIdx + i) < (int)parameterSystem->getPageCount(); i++) {
             int pageIdx = pageStartIdx + i;
-            const _NT_parameterPage& page = parameterSystem->getParameterPages()[pageIdx];
             float y = 8 + i * 10;
             
             bool isCurrentPage = (pageIdx == parameterSystem->getCurrentPageIndex());
@@ -263,11 +235,8 @@ namespace DisplayRenderer {
             nvgFillColor(vg, isCurrentPage ? nvgRGB(255, 255, 255) : nvgRGB(120, 120, 120));
             nvgTextAlign(vg, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
             
-            // Truncate page name if too long
-            char pageName[12];
-            strncpy(pageName, page.name, 11);
-            pageName[11] = '\0';
-            nvgText(vg, pageColumn, y, pageName, NULL);
+            const std::string& pageName = menuCache.pageNames[pageIdx];
+            nvgText(vg, pageColumn, y, pageName.c_str(), pageName.c_str() + pageName.size());
         }
         
         // Page scroll indicators
@@ -326,18 +295,16 @@ namespace DisplayRenderer {
                     nvgTextAlign(vg, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
                     nvgText(vg, paramColumn, y, param.name, NULL);
 
-                    // PARAMETER VALUE (beside the name)
-                    int value = parameterSystem->getRoutingMatrix()[paramIdx];
-                    char valueStr[kNT_parameterStringSize];
-                    formatParameterValue(valueStr, param, value, paramIdx);
+                    // PARAMETER VALUE (beside the name), right-aligned by its cached width
+                    const MenuValueLine& line = getMenuValueLine(vg, parameterSystem, paramIdx);
 
                     if (isCurrentParam) {
                         nvgFillColor(vg, nvgRGBA(255, 255, 255, alpha));
                     } else {
                         nvgFillColor(vg, nvgRGBA(160, 160, 160, alpha));
                     }
-                    nvgTextAlign(vg, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP);
-                    nvgText(vg, valueColumn + valueWidth, y, valueStr, NULL);
+                    nvgTextAlign(vg, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+                    nvgText(vg, valueColumn + valueWidth - line.width, y, line.text, NULL);
                 }
                 
                 // Parameter scroll indicators
@@ -355,6 +322,29 @@ namespace DisplayRenderer {
         }
     }
 
+    const ModuleOLEDWidget::MenuValueLine& ModuleOLEDWidget::getMenuValueLine(NVGcontext* vg, const ParameterSystem* parameterSystem, int paramIdx) {
+        MenuValueLine& line = menuCache.values[paramIdx];
+        const _NT_parameter& param = parameterSystem->getParameters()[paramIdx];
+        int16_t value = parameterSystem->getRoutingMatrix()[paramIdx];
+        uint32_t valueGeneration = parameterSystem->getValueGeneration();
+
+        // The plugin's parameterString() may depend on other parameters, so
+        // those lines are redone after any value change; ours only on their own
+        bool pluginFormatted = param.unit == kNT_unitHasStrings || param.unit == kNT_unitConfirm;
+        if (line.valid && line.value == value &&
+            (!pluginFormatted || line.valueGeneration == valueGeneration)) {
+            return line;
+        }
+
+        formatParameterValue(line.text, param, value, paramIdx);
+        line.text[kNT_parameterStringSize - 1] = '\0';
+        line.width = nvgTextBounds(vg, 0, 0, line.text, NULL, NULL);
+        line.value = value;
+        line.valueGeneration = valueGeneration;
+        line.valid = true;
+        return line;
+    }
+
     void ModuleOLEDWidget::formatParameterValue(char* str, const _NT_parameter& param, int value, int paramIdx) const {
         // Apply scaling first
         float scaledValue = value;
@@ -3,11 +3,15 @@
 #include <rack.hpp>
 #include "../nt_api_interface.h"
 #include "IDisplayDataProvider.hpp"
+#include "OLEDTexture.hpp"
+#include <string>
+#include <vector>
 
 using namespace rack;
 
 // Forward declarations  
 struct VCVDisplayBuffer;
+class ParameterSystem;
 
 namespace DisplayRenderer {
 
@@ -23,12 +27,39 @@ namespace DisplayRenderer {
         
         void step() override;
         void draw(const DrawArgs& args) override;
+        void onContextDestroy(const ContextDestroyEvent& e) override;
         
     private:
+        // The OLED frame as one image, re-uploaded only when it changes
+        OLEDTexture texture;
+        const void* textureSource = nullptr;    // Scheduler or emulator buffer shown last
+        uint32_t lastFrameSequence = 0;
+        
+        // Menu text, laid out once and redone only for lines that changed.
+        // Page names are kept per page index and value strings per
+        // parameter index; all of it goes when the ParameterSystem's layout
+        // generation moves.
+        struct MenuValueLine {
+            bool valid = false;
+            int16_t value = 0;
+            uint32_t valueGeneration = 0;           // Checked for plugin-formatted units only
+            char text[kNT_parameterStringSize] = {};
+            float width = 0.f;                      // Of text at the menu font size
+        };
+        struct MenuCache {
+            const ParameterSystem* source = nullptr;
+            uint32_t layoutGeneration = 0;
+            std::vector<std::string> pageNames;
+            std::vector<MenuValueLine> values;
+        };
+        MenuCache menuCache;
+        
         void drawPlaceholder(const DrawArgs& args);
-        void syncNTScreenToVCVBuffer(VCVDisplayBuffer& buffer);
+        void drawPluginScreen(NVGcontext* vg);
         void drawDisplayBuffer(NVGcontext* vg, const VCVDisplayBuffer& buffer);
+        void drawScreen(NVGcontext* vg, const uint8_t* packed, uint64_t rows, const void* source);
         void drawMenuInterface(NVGcontext* vg, IDisplayDataProvider* dataProvider);
+        const MenuValueLine& getMenuValueLine(NVGcontext* vg, const ParameterSystem* parameterSystem, int paramIdx);
         void formatParameterValue(char* str, const _NT_parameter& param, int value, int paramIdx = -1) const;
     };
 
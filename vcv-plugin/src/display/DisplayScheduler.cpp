@@ -0,0 +1,173 @@
+#include "DisplayScheduler.hpp"
+#include "../plugin/PluginExecutor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+} // namespace
+
+DisplayScheduler::DisplayScheduler(PluginExecutor* executor, NTApiContext* context)
+    : executor(executor), context(context) {
+    for (Frame& frame : frames) {
+        memset(frame.screen, 0, sizeof(frame.screen));
+    }
+}
+
+DisplayScheduler::~DisplayScheduler() {
+    stop();
+}
+
+void DisplayScheduler::start() {
+    if (running.load()) return;
+    running.store(true);
+    thread = std::thread(&DisplayScheduler::threadLoop, this);
+}
+
+void DisplayScheduler::stop() {
+    if (!running.exchange(false)) return;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wakeCondition.notify_one();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void DisplayScheduler::pause() {
+    // Pairs with drawFrame(): either it sees paused or we see drawing
+    paused.store(true);
+    while (drawing.load()) {
+        std::this_thread::yield();
+    }
+}
+
+void DisplayScheduler::resume() {
+    paused.store(false);
+}
+
+void DisplayScheduler::setRate(int hz) {
+    rateHz.store(std::min(std::max(hz, (int)MIN_RATE_HZ), (int)MAX_RATE_HZ));
+    wakeCondition.notify_one();
+}
+
+const DisplayScheduler::Frame* DisplayScheduler::acquire() {
+    if (middle.load(std::memory_order_acquire) & NEW_FRAME) {
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        hasFront = true;
+    }
+    return hasFront ? &frames[front] : nullptr;
+}
+
+void DisplayScheduler::threadLoop() {
+    Clock::time_point next = Clock::now();
+    while (running.load()) {
+        drawFrame();
+
+        // Fixed rate; after a stall (slow draw, rate change) start again from now
+        Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / rateHz.load()));
+        next += period;
+        Clock::time_point now = Clock::now();
+        if (next < now || next > now + period) {
+            next = now + period;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait_until(lock, next, [this]() {
+            return !running.load();
+        });
+    }
+}
+
+void DisplayScheduler::drawFrame() {
+    drawing.store(true);
+    if (!paused.load() && executor->hasDraw()) {
+        {
+            // NT_screen is shared by all instances: hold it until this
+            // frame has been copied into our own context
+            std::lock_guard<std::mutex> screenLock(NTApi::getScreenMutex());
+            NTApi::beginScreenFrame();
+            // Whatever draw() returns, show what it drew
+            executor->safeDraw();
+            NTApi::captureScreen(context);
+        }
+        publish();
+    }
+    drawing.store(false);
+}
+
+void DisplayScheduler::publish() {
+    Frame& frame = frames[back];
+    memcpy(frame.screen, context->screen, sizeof(frame.screen));
+
+    // If the UI hasn't taken the previous frame yet it may never see it, so
+    // its rows still count as changed. Checked before the exchange: once the
+    // UI has taken a frame it can't un-take it, and if it takes it in
+    // between we only upload a few rows more than needed.
+    bool previousUnread = (middle.load(std::memory_order_acquire) & NEW_FRAME) != 0;
+    frame.dirtyRows = context->dirtyRows | (previousUnread ? publishedRows : 0);
+    frame.sequence = ++sequence;
+    context->dirtyRows = 0;
+    publishedRows = frame.dirtyRows;
+
+    int previous = middle.exchange(back | NEW_FRAME, std::memory_order_acq_rel);
+    if (previous & NEW_FRAME) {
+        stats.skipped++;
+    }
+    back = previous & INDEX_MASK;
+    stats.frames++;
+
+    if (recording.load(std::memory_order_relaxed)) {
+        recordFrame();
+    }
+}
+
+void DisplayScheduler::recordFrame() {
+    std::lock_guard<std::mutex> lock(recorderMutex);
+    if (!recorder) return;
+
+    uint64_t timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now().time_since_epoch()).count();
+    if (!recorder->record(context->screen, timestampUs, executor->getBlockCount())) {
+        WARN("Display recording failed, stopping: %s", recorder->getPath().c_str());
+        recorder.reset();
+        recording.store(false);
+    }
+}
+
+bool DisplayScheduler::startRecording(const std::string& path, std::string& error) {
+    std::unique_ptr<FrameRecorder> newRecorder(new FrameRecorder());
+    if (!newRecorder->open(path, error)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(recorderMutex);
+    recorder = std::move(newRecorder);
+    recording.store(true);
+    INFO("Recording display to %s", path.c_str());
+    return true;
+}
+
+void DisplayScheduler::stopRecording() {
+    std::unique_ptr<FrameRecorder> finished;
+    {
+        std::lock_guard<std::mutex> lock(recorderMutex);
+        recording.store(false);
+        finished = std::move(recorder);
+    }
+    if (!finished) return;
+
+    const FrameRecorder::Stats& recorded = finished->getStats();
+    INFO("Display recording stopped: %llu frames (%llu unchanged skipped), %llu bytes",
+         (unsigned long long)recorded.frames, (unsigned long long)recorded.unchanged,
+         (unsigned long long)recorded.bytes);
+}
+
+FrameRecorder::Stats DisplayScheduler::getRecordingStats() {
+    std::lock_guard<std::mutex> lock(recorderMutex);
+    return recorder ? recorder->getStats() : FrameRecorder::Stats();
+}
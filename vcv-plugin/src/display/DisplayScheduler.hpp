@@ -0,0 +1,115 @@
+#pragma once
+#include "../api/NTApiContext.hpp"
+#include "../../../emulator/src/utils/frame_recording.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class PluginExecutor;
+
+// Per-module thread that calls the plugin's draw() at a fixed rate, like the
+// hardware's display task, instead of whenever Rack repaints the OLED.
+//
+// Each frame is drawn into the shared NT_screen under the screen lock and
+// captured into the module's NTApiContext, then published through a triple
+// buffer: the thread always has a free buffer to draw into and the UI takes
+// the newest finished frame without waiting. draw() runs under the
+// executor's execution lock, so it never overlaps step().
+//
+// A published frame carries the rows that changed since the frame the UI
+// last took, including rows changed in frames the UI never saw.
+//
+// While recording, every published frame also goes to a FrameRecorder,
+// stamped with the executor's block count (unchanged frames cost nothing).
+class DisplayScheduler {
+public:
+    static constexpr int DEFAULT_RATE_HZ = 30;
+    static constexpr int MIN_RATE_HZ = 1;
+    static constexpr int MAX_RATE_HZ = 120;
+
+    struct Frame {
+        alignas(16) uint8_t screen[NTApiContext::SCREEN_BYTES];
+        uint64_t dirtyRows = NTApiContext::ALL_ROWS;
+        uint32_t sequence = 0;
+    };
+
+    struct Stats {
+        uint32_t frames = 0;        // Frames drawn and published
+        uint32_t skipped = 0;       // Published frames replaced before the UI took them
+    };
+
+    DisplayScheduler(PluginExecutor* executor, NTApiContext* context);
+    ~DisplayScheduler();
+
+    // UI thread
+    void start();
+    void stop();
+    bool isRunning() const { return running.load(); }
+
+    // Keep the thread out of draw() (e.g. while the plugin is unloaded).
+    // Returns once any frame in progress has finished.
+    void pause();
+    void resume();
+
+    void setRate(int hz);
+    int getRate() const { return rateHz.load(); }
+
+    // UI thread: a frame newer than the last acquire() is waiting
+    bool hasNewFrame() const { return (middle.load(std::memory_order_acquire) & NEW_FRAME) != 0; }
+
+    // UI thread: takes the newest frame if there is one and returns the UI's
+    // frame, or nullptr until the first frame has been published
+    const Frame* acquire();
+
+    // Written by the scheduler thread; reads may tear but each field is a plain word
+    const Stats& getStats() const { return stats; }
+    void resetStats() { stats = Stats(); }
+
+    // UI thread: record published frames to `path` until stopRecording()
+    bool startRecording(const std::string& path, std::string& error);
+    void stopRecording();
+    bool isRecording() const { return recording.load(); }
+    FrameRecorder::Stats getRecordingStats();
+
+private:
+    static constexpr int NEW_FRAME = 4;
+    static constexpr int INDEX_MASK = 3;
+
+    PluginExecutor* executor;
+    NTApiContext* context;
+
+    // Triple buffer: the thread owns frames[back], the UI owns frames[front],
+    // and the middle index (plus NEW_FRAME when unread) is exchanged between them
+    Frame frames[3];
+    int back = 0;
+    int front = 2;
+    std::atomic<int> middle{1};
+    bool hasFront = false;
+    uint64_t publishedRows = 0;
+    uint32_t sequence = 0;
+
+    std::atomic<int> rateHz{DEFAULT_RATE_HZ};
+    std::atomic<bool> running{false};
+    std::atomic<bool> paused{false};
+    std::atomic<bool> drawing{false};
+
+    std::thread thread;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+
+    Stats stats;
+
+    // Guards recorder: written by publish(), swapped by the UI thread
+    std::mutex recorderMutex;
+    std::unique_ptr<FrameRecorder> recorder;
+    std::atomic<bool> recording{false};
+    void recordFrame();
+
+    void threadLoop();
+    void drawFrame();
+    void publish();
+};
@@ -7,8 +7,11 @@
 
 // Forward declarations
 struct VCVDisplayBuffer;
+struct NTApiContext;
 class PluginManager;
+class PluginExecutor;
 class ParameterSystem;
+class DisplayScheduler;
 
 // Interface to break circular dependency between DisplayRenderer and EmulatorModule
 class IDisplayDataProvider {
@@ -20,6 +23,8 @@ public:
     virtual void setDisplayDirty(bool dirty) = 0;
     virtual const VCVDisplayBuffer& getDisplayBuffer() const = 0;
     virtual void updateDisplay() = 0;
+    virtual int getDisplayLook() const = 0;     // OLEDLook
+    virtual DisplayScheduler* getDisplaySchedulerPtr() const = 0;   // Frames drawn by the plugin
     
     // Menu system
     virtual int getMenuMode() const = 0;
@@ -27,10 +32,14 @@ public:
     // Plugin system
     virtual bool hasLoadedPlugin() const = 0;
     virtual PluginManager* getPluginManagerPtr() const = 0;
+    virtual PluginExecutor* getPluginExecutorPtr() const = 0;
     
     // Parameter system
     virtual ParameterSystem* getParameterSystemPtr() const = 0;
     
     // Safe plugin execution
     virtual void safeExecutePlugin(std::function<void()> func, const std::string& operation) = 0;
+    
+    // Per-instance NT API state (owns the screen the plugin last drew)
+    virtual NTApiContext* getApiContext() = 0;
 };
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "OLEDTexture.hpp"
+#include <cstring>
+
+namespace {
+    const int GLOW_WIDTH = OLEDTexture::WIDTH / OLEDTexture::GLOW_SCALE;
+    const int GLOW_HEIGHT = OLEDTexture::HEIGHT / OLEDTexture::GLOW_SCALE;
+
+    // One display pixel of the grid mask; the last row and column are the gap
+    const int GRID_CELL = 8;
+    const uint8_t GRID_GAP_ALPHA = 150;
+
+    const float GLOW_ALPHA = 0.6f;
+}
+
+OLEDTexture::OLEDTexture() {
+    std::memset(lastPacked, 0, sizeof(lastPacked));
+    std::memset(rgba, 0, sizeof(rgba));
+    std::memset(glowRgba, 0, sizeof(glowRgba));
+}
+
+OLEDTexture::~OLEDTexture() {
+    release();
+}
+
+void OLEDTexture::draw(NVGcontext* vg, const uint8_t* packed, OLEDLook look, uint64_t rows) {
+    if (!createImages(vg)) return;
+
+    upload(packed, uploaded ? rows : ALL_ROWS);
+
+    nvgBeginPath(vg);
+    nvgRect(vg, 0, 0, WIDTH, HEIGHT);
+    nvgFillPaint(vg, nvgImagePattern(vg, 0, 0, WIDTH, HEIGHT, 0.f, image, 1.f));
+    nvgFill(vg);
+
+    if (look == OLEDLook::PIXEL_GRID) {
+        // Pattern extent of one display pixel, repeated across the panel
+        nvgBeginPath(vg);
+        nvgRect(vg, 0, 0, WIDTH, HEIGHT);
+        nvgFillPaint(vg, nvgImagePattern(vg, 0, 0, 1, 1, 0.f, gridImage, 1.f));
+        nvgFill(vg);
+    } else if (look == OLEDLook::BLOOM) {
+        if (!glowUploaded) {
+            uploadGlow();
+        }
+        nvgSave(vg);
+        nvgGlobalCompositeOperation(vg, NVG_LIGHTER);
+        nvgBeginPath(vg);
+        nvgRect(vg, 0, 0, WIDTH, HEIGHT);
+        nvgFillPaint(vg, nvgImagePattern(vg, 0, 0, WIDTH, HEIGHT, 0.f, glowImage, GLOW_ALPHA));
+        nvgFill(vg);
+        nvgRestore(vg);
+    }
+}
+
+void OLEDTexture::reset() {
+    context = nullptr;
+    image = glowImage = gridImage = -1;
+    uploaded = glowUploaded = false;
+}
+
+bool OLEDTexture::createImages(NVGcontext* vg) {
+    if (context == vg && image > 0) return true;
+    release();
+
+    image = nvgCreateImageRGBA(vg, WIDTH, HEIGHT, NVG_IMAGE_NEAREST, rgba);
+    glowImage = nvgCreateImageRGBA(vg, GLOW_WIDTH, GLOW_HEIGHT, 0, glowRgba);
+
+    uint8_t grid[GRID_CELL * GRID_CELL * 4];
+    for (int y = 0; y < GRID_CELL; y++) {
+        for (int x = 0; x < GRID_CELL; x++) {
+            uint8_t* texel = &grid[(y * GRID_CELL + x) * 4];
+            texel[0] = texel[1] = texel[2] = 0;
+            texel[3] = (x == GRID_CELL - 1 || y == GRID_CELL - 1) ? GRID_GAP_ALPHA : 0;
+        }
+    }
+    gridImage = nvgCreateImageRGBA(vg, GRID_CELL, GRID_CELL,
+        NVG_IMAGE_REPEATX | NVG_IMAGE_REPEATY | NVG_IMAGE_GENERATE_MIPMAPS, grid);
+
+    context = vg;
+    if (image <= 0 || glowImage <= 0 || gridImage <= 0) {
+        WARN("OLEDTexture: Failed to create display images");
+        release();
+        return false;
+    }
+    return true;
+}
+
+void OLEDTexture::release() {
+    if (context) {
+        if (image > 0) nvgDeleteImage(context, image);
+        if (glowImage > 0) nvgDeleteImage(context, glowImage);
+        if (gridImage > 0) nvgDeleteImage(context, gridImage);
+    }
+    reset();
+}
+
+void OLEDTexture::upload(const uint8_t* packed, uint64_t rows) {
+    uint64_t changed = 0;
+    for (int y = 0; y < HEIGHT; y++) {
+        if (!(rows & (1ull << y))) continue;
+        const uint8_t* row = packed + y * ROW_BYTES;
+        uint8_t* last = lastPacked + y * ROW_BYTES;
+        if (uploaded && std::memcmp(row, last, ROW_BYTES) == 0) continue;
+        std::memcpy(last, row, ROW_BYTES);
+        changed |= 1ull << y;
+
+        // Opaque gray, matching the old white-at-gray/15 pixels over black
+        uint8_t* out = &rgba[y * WIDTH * 4];
+        for (int i = 0; i < ROW_BYTES; i++) {
+            uint8_t even = (uint8_t)((row[i] >> 4) * 17);
+            uint8_t odd = (uint8_t)((row[i] & 0x0F) * 17);
+            out[0] = out[1] = out[2] = even;
+            out[3] = 255;
+            out[4] = out[5] = out[6] = odd;
+            out[7] = 255;
+            out += 8;
+        }
+    }
+    uploaded = true;
+    if (!changed) return;
+
+    // One sub-image update per run of changed rows. The renderer takes the
+    // whole image and offsets into it itself.
+    NVGparams* params = nvgInternalParams(context);
+    for (int y = 0; y < HEIGHT; ) {
+        if (!(changed & (1ull << y))) {
+            y++;
+            continue;
+        }
+        int end = y;
+        while (end < HEIGHT && (changed & (1ull << end))) end++;
+        params->renderUpdateTexture(params->userPtr, image, 0, y, WIDTH, end - y, rgba);
+        uploadedRows += end - y;
+        y = end;
+    }
+
+    glowUploaded = false;   // Rebuilt on the next bloom draw
+    uploadCount++;
+}
+
+void OLEDTexture::uploadGlow() {
+    // Box filter: each glow texel is the mean of a GLOW_SCALE square of pixels
+    for (int gy = 0; gy < GLOW_HEIGHT; gy++) {
+        for (int gx = 0; gx < GLOW_WIDTH; gx++) {
+            int sum = 0;
+            for (int y = gy * GLOW_SCALE; y < (gy + 1) * GLOW_SCALE; y++) {
+                const uint8_t* row = &rgba[(y * WIDTH + gx * GLOW_SCALE) * 4];
+                for (int x = 0; x < GLOW_SCALE; x++) {
+                    sum += row[x * 4];
+                }
+            }
+            uint8_t* texel = &glowRgba[(gy * GLOW_WIDTH + gx) * 4];
+            texel[0] = texel[1] = texel[2] = (uint8_t)(sum / (GLOW_SCALE * GLOW_SCALE));
+            texel[3] = 255;
+        }
+    }
+    nvgUpdateImage(context, glowImage, glowRgba);
+    glowUploaded = true;
+}
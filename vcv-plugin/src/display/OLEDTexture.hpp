@@ -0,0 +1,75 @@
+#pragma once
+#include <rack.hpp>
+#include <cstdint>
+
+using namespace rack;
+
+// How the OLED image is presented
+enum class OLEDLook {
+    PLAIN,
+    PIXEL_GRID,     // Dark gaps between pixels, like the panel up close
+    BLOOM,          // Soft glow around lit pixels
+    NUM_LOOKS
+};
+
+/**
+ * OLEDTexture - The 256x64 4-bit display as a single NanoVG image
+ *
+ * The frame is expanded to RGBA and drawn as one nearest-filtered quad
+ * instead of a path per lit pixel. Only rows whose packed pixels differ
+ * from the last upload are converted and sent to the GPU, through the
+ * renderer's sub-rectangle update (as NanoVG does for its font atlas).
+ * Callers that know which rows changed pass them as a hint so the rest
+ * aren't even compared.
+ *
+ * NanoVG has no custom shaders, so each look is one more quad: a repeating
+ * mask for the pixel grid, or a box-filtered quarter-size copy drawn
+ * additively with linear filtering for bloom.
+ *
+ * Images belong to the NanoVG context that created them, and Rack renders
+ * framebuffers with a different context from the window, so the texture
+ * is rebuilt whenever it is drawn with a new context. Call reset() when
+ * the context is destroyed.
+ */
+class OLEDTexture {
+public:
+    static constexpr int WIDTH = 256;
+    static constexpr int HEIGHT = 64;
+    static constexpr int ROW_BYTES = WIDTH / 2;
+    static constexpr int PACKED_BYTES = ROW_BYTES * HEIGHT;   // NT_screen layout
+    static constexpr uint64_t ALL_ROWS = ~0ull;
+    static constexpr int GLOW_SCALE = 4;
+
+    OLEDTexture();
+    ~OLEDTexture();
+
+    // Draws `packed` over (0,0)-(WIDTH,HEIGHT) in the current transform,
+    // first uploading any of the rows in `rows` (bit y = row y) that changed
+    // since the previous draw()
+    void draw(NVGcontext* vg, const uint8_t* packed, OLEDLook look, uint64_t rows = ALL_ROWS);
+
+    // Forgets all images without deleting them (their context is gone)
+    void reset();
+
+    uint32_t getUploadCount() const { return uploadCount; }
+    uint32_t getUploadedRows() const { return uploadedRows; }
+
+private:
+    NVGcontext* context = nullptr;
+    int image = -1;
+    int glowImage = -1;
+    int gridImage = -1;
+    bool uploaded = false;
+    bool glowUploaded = false;
+    uint32_t uploadCount = 0;      // Frames that changed
+    uint32_t uploadedRows = 0;
+
+    uint8_t lastPacked[PACKED_BYTES];
+    uint8_t rgba[WIDTH * HEIGHT * 4];
+    uint8_t glowRgba[(WIDTH / GLOW_SCALE) * (HEIGHT / GLOW_SCALE) * 4];
+
+    bool createImages(NVGcontext* vg);
+    void release();
+    void upload(const uint8_t* packed, uint64_t rows);
+    void uploadGlow();
+};
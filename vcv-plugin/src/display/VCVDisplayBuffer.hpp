@@ -0,0 +1,77 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// Display buffer for 256x64 OLED
+struct VCVDisplayBuffer {
+    std::array<uint8_t, (256 * 64) / 2> pixels{};  // 4-bit grayscale, 2 pixels per byte
+    bool dirty = true;
+    
+    void clear() {
+        pixels.fill(0);
+        dirty = true;
+    }
+    
+    // Legacy method for backwards compatibility (threshold at 8)
+    void setPixel(int x, int y, bool on) {
+        setPixelGray(x, y, on ? 15 : 0);
+    }
+    
+    // New method for 4-bit grayscale (0-15)
+    void setPixelGray(int x, int y, uint8_t gray_value) {
+        if (x < 0 || x >= 256 || y < 0 || y >= 64) return;
+        
+        int byte_idx = y * 128 + x / 2;
+        gray_value = gray_value & 0x0F;  // Ensure 4-bit value
+        
+        if (x & 1) {
+            // Odd x: low nibble
+            pixels[byte_idx] = (pixels[byte_idx] & 0xF0) | gray_value;
+        } else {
+            // Even x: high nibble
+            pixels[byte_idx] = (pixels[byte_idx] & 0x0F) | (gray_value << 4);
+        }
+        dirty = true;
+    }
+    
+    // Legacy method for backwards compatibility
+    bool getPixel(int x, int y) const {
+        return getPixelGray(x, y) > 7;  // Threshold at 8
+    }
+    
+    // New method to get 4-bit grayscale value
+    uint8_t getPixelGray(int x, int y) const {
+        if (x < 0 || x >= 256 || y < 0 || y >= 64) return 0;
+        
+        int byte_idx = y * 128 + x / 2;
+        
+        if (x & 1) {
+            // Odd x: low nibble
+            return pixels[byte_idx] & 0x0F;
+        } else {
+            // Even x: high nibble
+            return (pixels[byte_idx] >> 4) & 0x0F;
+        }
+    }
+
+    // Copy a frame in NT_screen layout (128 bytes per row, high nibble = even x)
+    void loadNTScreen(const uint8_t* screen) {
+        for (int y = 0; y < 64; y++) {
+            for (int x = 0; x < 256; x += 2) {
+                int byte_idx = y * 128 + x / 2;
+                uint8_t byte_val = screen[byte_idx];
+                
+                // Extract high nibble (even x coordinate)
+                uint8_t pixel_even = (byte_val >> 4) & 0x0F;
+                // Extract low nibble (odd x coordinate)  
+                uint8_t pixel_odd = byte_val & 0x0F;
+                
+                // Store full 4-bit grayscale values (0-15)
+                setPixelGray(x, y, pixel_even);
+                if (x + 1 < 256) {
+                    setPixelGray(x + 1, y, pixel_odd);
+                }
+            }
+        }
+    }
+};
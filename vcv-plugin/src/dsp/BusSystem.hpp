@@ -8,11 +8,31 @@ using namespace rack;
 struct EmulatorModule;
 
 class BusSystem {
+public:
+    static constexpr int NUM_BUSES = 28;
+    static constexpr int MIN_BLOCK_FRAMES = 4;
+    static constexpr int MAX_BLOCK_FRAMES = 64;
+
 private:
-    // 28 buses, each with 4 samples for block processing
-    // Layout: [Bus0_S0-S3][Bus1_S0-S3]...[Bus27_S0-S3] for plugin compatibility
-    alignas(16) float buses[28 * 4];
+    // 28 buses, each holding one block of samples for step()
+    // Layout: [Bus0_S0..Sn][Bus1_S0..Sn]...[Bus27_S0..Sn] for plugin compatibility,
+    // where n = blockFrames - 1 (the stride changes with the block size)
+    alignas(16) float buses[NUM_BUSES * MAX_BLOCK_FRAMES];
+    int blockFrames = MIN_BLOCK_FRAMES;
     int sampleIndex = 0;
+
+    static constexpr int NUM_INPUT_BUSES = 12;
+    static constexpr int NUM_OUTPUT_JACKS = 8;
+
+    // All-ones for patched inputs 0-11, zero otherwise; refreshed once per block
+    uint32_t inputMask[NUM_INPUT_BUSES] = {};
+
+    template<typename ModuleType>
+    void cacheInputConnectivity(ModuleType* module) {
+        for (int i = 0; i < NUM_INPUT_BUSES; i++) {
+            inputMask[i] = module->inputs[ModuleType::AUDIO_INPUT_1 + i].isConnected() ? ~0u : 0u;
+        }
+    }
     
 public:
     void init() {
@@ -21,48 +41,77 @@ public:
     
     void clear() {
         memset(buses, 0, sizeof(buses));
+        memset(inputMask, 0, sizeof(inputMask));
+        sampleIndex = 0;
+    }
+
+    // Change the number of frames buffered per step() call (multiple of 4, 4-64).
+    // Resets the bus contents, so only call this at a block boundary.
+    void setBlockFrames(int frames) {
+        frames = clamp(frames, MIN_BLOCK_FRAMES, MAX_BLOCK_FRAMES) & ~3;
+        if (frames == blockFrames) return;
+        blockFrames = frames;
+        clear();
+    }
+
+    int getBlockFrames() const {
+        return blockFrames;
+    }
+
+    // Value passed as numFramesBy4 to step()
+    int getNumFramesBy4() const {
+        return blockFrames / 4;
+    }
+
+    bool isLastSampleOfBlock() const {
+        return sampleIndex == blockFrames - 1;
     }
 
     void clearOutputBuses() {
         // Clear only buses 12-27 (internal processing and outputs)
         // Keep buses 0-11 (inputs) intact
-        memset(buses + 12 * 4, 0, 16 * 4 * sizeof(float));
+        memset(buses + 12 * blockFrames, 0, 16 * blockFrames * sizeof(float));
     }
 
     float* getBuses() {
         return buses;
     }
     
+    // Write one input sample straight into buses 0-11 at the current frame.
+    // Port connectivity is sampled once per block; unpatched inputs read 0.
+    // (Staging rows and 4x4 SIMD transposes were measured slower than these
+    // strided scalar stores, see tests/bench_bus_routing.cpp.)
     template<typename ModuleType>
     void routeInputs(ModuleType* module) {
         if (!module) return;
         
-        int currentSample = getCurrentSampleIndex();
+        if (sampleIndex == 0) {
+            cacheInputConnectivity(module);
+        }
         
-        // Route 12 inputs to buses 0-11 (0-based indexing)
-        for (int i = 0; i < 12; i++) {
-            if (module->inputs[ModuleType::AUDIO_INPUT_1 + i].isConnected()) {
-                float voltage = module->inputs[ModuleType::AUDIO_INPUT_1 + i].getVoltage();
-                setBus(i, currentSample, voltage);  // Use 0-based bus indexing
-            } else {
-                setBus(i, currentSample, 0.0f);
-            }
+        float* dst = buses + sampleIndex;
+        const int stride = blockFrames;
+        for (int i = 0; i < NUM_INPUT_BUSES; i++) {
+            float voltage = module->inputs[ModuleType::AUDIO_INPUT_1 + i].getVoltage();
+            uint32_t bits;
+            memcpy(&bits, &voltage, sizeof(bits));
+            bits &= inputMask[i];
+            memcpy(dst + i * stride, &bits, sizeof(bits));
         }
         
         // Buses 12-27 are used for internal algorithm processing
         // They will be populated by the algorithms themselves
     }
     
+    // Play one sample of the previous block's output from buses 12-19. They
+    // stay intact until clearOutputBuses() just before the next step().
     template<typename ModuleType>
     void routeOutputs(ModuleType* module) {
         if (!module) return;
         
-        int currentSample = getCurrentSampleIndex();
-        
-        // Route buses 12-19 to 8 outputs
-        for (int i = 0; i < 8; i++) {
-            float busValue = getBus(12 + i, currentSample);
-            module->outputs[ModuleType::AUDIO_OUTPUT_1 + i].setVoltage(busValue);
+        const float* src = buses + 12 * blockFrames + sampleIndex;
+        for (int i = 0; i < NUM_OUTPUT_JACKS; i++) {
+            module->outputs[ModuleType::AUDIO_OUTPUT_1 + i].setVoltage(src[i * blockFrames]);
         }
         
         // Advance to next sample in the block
@@ -71,27 +120,27 @@ public:
     
     // Get specific bus for reading
     float getBus(int busIndex, int sampleOffset = 0) {
-        if (busIndex >= 0 && busIndex < 28 && sampleOffset >= 0 && sampleOffset < 4) {
-            // Data layout: [Bus0_S0-S3][Bus1_S0-S3]...[Bus27_S0-S3]
-            return buses[busIndex * 4 + sampleOffset];
+        if (busIndex >= 0 && busIndex < NUM_BUSES && sampleOffset >= 0 && sampleOffset < blockFrames) {
+            return buses[busIndex * blockFrames + sampleOffset];
         }
         return 0.0f;
     }
     
     // Set specific bus value
     void setBus(int busIndex, int sampleOffset, float value) {
-        if (busIndex >= 0 && busIndex < 28 && sampleOffset >= 0 && sampleOffset < 4) {
-            // Data layout: [Bus0_S0-S3][Bus1_S0-S3]...[Bus27_S0-S3]
-            buses[busIndex * 4 + sampleOffset] = value;
+        if (busIndex >= 0 && busIndex < NUM_BUSES && sampleOffset >= 0 && sampleOffset < blockFrames) {
+            buses[busIndex * blockFrames + sampleOffset] = value;
         }
     }
     
     // Increment sample index (for block processing)
     void nextSample() {
-        sampleIndex = (sampleIndex + 1) % 4;
+        if (++sampleIndex >= blockFrames) {
+            sampleIndex = 0;
+        }
     }
     
     int getCurrentSampleIndex() const {
         return sampleIndex;
     }
-};
\ No newline at end of file
+};
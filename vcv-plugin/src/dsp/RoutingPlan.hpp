@@ -0,0 +1,116 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+// Flat I/O routing table compiled from the plugin's routing parameters.
+// Plain arrays only, so it can be copied and read without heap traffic.
+struct RoutingPlan {
+    static constexpr int MAX_ROUTES = 64;
+    static constexpr int NUM_BUSES = 28;
+    static constexpr int NUM_INPUT_JACKS = 12;    // Jacks 1-12 feed buses 0-11
+    static constexpr int NUM_OUTPUT_JACKS = 8;    // Buses 12-19 feed jacks 1-8
+    static constexpr int FIRST_OUTPUT_BUS = 12;
+
+    struct InputRoute {
+        int16_t paramIndex;     // Parameter that selects the bus
+        int8_t busIndex;        // Source bus (0-27), -1 when set to None
+        bool isCV;
+    };
+
+    struct OutputRoute {
+        int16_t paramIndex;     // Parameter that selects the bus
+        int8_t busIndex;        // Destination bus (0-27), -1 when set to None
+        bool isCV;
+        int16_t modeParamIndex; // Output mode parameter, -1 if none
+        bool replace;           // Output mode: replace (true) or add (false)
+    };
+
+    InputRoute inputs[MAX_ROUTES];
+    OutputRoute outputs[MAX_ROUTES];
+    int numInputs = 0;
+    int numOutputs = 0;
+
+    // Per-jack lookups derived from the routes
+    bool inputJackRouted[NUM_INPUT_JACKS];
+    bool outputJackRouted[NUM_OUTPUT_JACKS];
+    int16_t outputJackParam[NUM_OUTPUT_JACKS];   // First parameter writing the jack's bus, -1 if none
+
+    RoutingPlan() {
+        clear();
+    }
+
+    void clear() {
+        numInputs = 0;
+        numOutputs = 0;
+        memset(inputJackRouted, 0, sizeof(inputJackRouted));
+        memset(outputJackRouted, 0, sizeof(outputJackRouted));
+        for (int i = 0; i < NUM_OUTPUT_JACKS; i++) {
+            outputJackParam[i] = -1;
+        }
+    }
+
+    void addInput(int paramIndex, int busIndex, bool isCV) {
+        if (numInputs >= MAX_ROUTES) return;
+        inputs[numInputs++] = {(int16_t)paramIndex, (int8_t)busIndex, isCV};
+        if (busIndex >= 0 && busIndex < NUM_INPUT_JACKS) {
+            inputJackRouted[busIndex] = true;
+        }
+    }
+
+    void addOutput(int paramIndex, int busIndex, bool isCV, int modeParamIndex, bool replace) {
+        if (numOutputs >= MAX_ROUTES) return;
+        outputs[numOutputs++] = {(int16_t)paramIndex, (int8_t)busIndex, isCV, (int16_t)modeParamIndex, replace};
+        int jack = busIndex - FIRST_OUTPUT_BUS;
+        if (jack >= 0 && jack < NUM_OUTPUT_JACKS) {
+            outputJackRouted[jack] = true;
+            if (outputJackParam[jack] < 0) {
+                outputJackParam[jack] = (int16_t)paramIndex;
+            }
+        }
+    }
+};
+
+// Publishes RoutingPlans from the UI thread to the engine thread (RCU style).
+// Three slots: the published plan, the plan the engine is reading, and one
+// free slot for the writer, so neither side ever waits on the other.
+class RoutingPlanPublisher {
+public:
+    // Writer side (UI thread): fill the returned plan, then publish() it
+    RoutingPlan& beginWrite() {
+        int published = publishedIndex.load();
+        int inUse = inUseIndex.load();
+        writeIndex = 0;
+        while (writeIndex == published || writeIndex == inUse) {
+            writeIndex++;
+        }
+        plans[writeIndex].clear();
+        return plans[writeIndex];
+    }
+
+    void publish() {
+        publishedIndex.store(writeIndex);
+    }
+
+    // Latest published plan, for the writer thread (tooltips, menus)
+    const RoutingPlan& getPublished() const {
+        return plans[publishedIndex.load()];
+    }
+
+    // Reader side (engine thread): call at a block boundary, then use the
+    // returned plan until the next acquire()
+    const RoutingPlan& acquire() {
+        int index;
+        do {
+            index = publishedIndex.load();
+            inUseIndex.store(index);
+        } while (publishedIndex.load() != index);
+        return plans[index];
+    }
+
+private:
+    RoutingPlan plans[3];
+    std::atomic<int> publishedIndex{0};
+    std::atomic<int> inUseIndex{0};
+    int writeIndex = 1;
+};
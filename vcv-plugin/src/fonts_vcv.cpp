@@ -4,6 +4,7 @@
 #include "../../fonts/tom_thumb_4x6.h"
 #include "../../fonts/pixelmix_baseline.h"
 #include "../../fonts/selawik_aa.h"  // Anti-aliased Selawik with 4-bit grayscale
+#include "api/NTGlyphAtlas.hpp"
 
 // VCV plugin specific implementation that uses NT_screen directly
 extern "C" uint8_t NT_screen[128 * 64];
@@ -56,99 +57,117 @@ FontMetrics getFontMetrics(FontType type) {
     return {nullptr, nullptr, 0, 0, 0, 0, 0, 0};
 }
 
-void setPixel(int x, int y, int color) {
-    if (x < 0 || x >= 256 || y < 0 || y >= 64) return;
-    
-    int byte_idx = y * 128 + x / 2;
-    if (byte_idx < 0 || byte_idx >= (128 * 64)) return;  // Extra bounds check
-    
-    color = color & 0x0F;  // Ensure 4-bit value
-    
-    if (x % 2 == 0) {
-        // Even x: high nibble (bits 4-7)
-        NT_screen[byte_idx] = (NT_screen[byte_idx] & 0x0F) | (color << 4);
-    } else {
-        // Odd x: low nibble (bits 0-3)
-        NT_screen[byte_idx] = (NT_screen[byte_idx] & 0xF0) | color;
-    }
-}
-
-void drawChar(int x, int y, char c, FontType font, int color = 15) {
-    // Safety checks
-    if (x < -20 || x > 300 || y < -20 || y > 100) return;  // Reasonable bounds
-    if (color < 0 || color > 15) color = 15;  // Clamp color
+namespace {
 
-    FontMetrics metrics = getFontMetrics(font);
-    if (!metrics.data) return;
-    if (metrics.height <= 0 || metrics.height > 50) return;  // Sanity check
+// Each font decoded once into a pre-packed atlas (see NTGlyphAtlas)
+struct FontAtlas {
+    NTGlyphAtlas atlas;
+    int xOffset;        // Left bearing added to the draw position
 
-    int char_index = c - metrics.first_char;
-    if (char_index < 0 || char_index > (metrics.last_char - metrics.first_char)) return;
+    FontAtlas(int width, int height, int xOffset)
+        : atlas(GLYPH_COUNT, width, height), xOffset(xOffset) {}
 
-    // Convert baseline y to top-left y (y is baseline, subtract ascent to get top)
-    int top_y = y - metrics.ascent;
+    static constexpr int GLYPH_COUNT = 95;     // ' ' to '~' in every font
+};
 
-    // Character width is handled by the caller (drawText)
+FontAtlas* buildAtlas(FontType font) {
+    FontMetrics metrics = getFontMetrics(font);
+    if (!metrics.data) return nullptr;
 
     if (font == FontType::TINY) {
-        // Tom Thumb 4x6: uses MSB ordering, render full bitmap but advance by character width
-        // Add 2px left offset to match other fonts' left bearing
+        // Tom Thumb 4x6: MSB first, drawn 2px right to match the other fonts' bearing
+        FontAtlas* result = new FontAtlas(4, metrics.height, 2);
         const uint8_t (*font_data)[6] = reinterpret_cast<const uint8_t (*)[6]>(metrics.data);
-        for (int row = 0; row < metrics.height; row++) {
-            uint8_t bitmap_row = font_data[char_index][row];
-            for (int col = 0; col < 4; col++) {  // Full 4-pixel bitmap
-                if (bitmap_row & (0x80 >> col)) {  // MSB: Start from bit 7, move right
-                    setPixel(x + col + 2, top_y + row, color);  // +2 for left bearing
+        uint8_t coverage[4 * 6];
+        for (int i = 0; i <= metrics.last_char - metrics.first_char; i++) {
+            for (int row = 0; row < metrics.height; row++) {
+                for (int col = 0; col < 4; col++) {
+                    coverage[row * 4 + col] = (font_data[i][row] & (0x80 >> col)) ? 15 : 0;
                 }
             }
+            result->atlas.setGlyph(i, coverage);
         }
+        return result;
     } else if (font == FontType::NORMAL) {
-        // PixelMix baseline: uses MSB ordering, render full bitmap but advance by character width
+        // PixelMix baseline: MSB first, full 8-bit rows
+        FontAtlas* result = new FontAtlas(8, metrics.height, 0);
         const uint8_t (*font_data)[10] = reinterpret_cast<const uint8_t (*)[10]>(metrics.data);
-        for (int row = 0; row < metrics.height; row++) {
-            uint8_t bitmap_row = font_data[char_index][row];
-            for (int col = 0; col < 8; col++) {  // Full 8-bit bitmap data
-                if (bitmap_row & (0x80 >> col)) {  // MSB: Start from bit 7, move right
-                    setPixel(x + col, top_y + row, color);
+        uint8_t coverage[8 * 10];
+        for (int i = 0; i <= metrics.last_char - metrics.first_char; i++) {
+            for (int row = 0; row < metrics.height; row++) {
+                for (int col = 0; col < 8; col++) {
+                    coverage[row * 8 + col] = (font_data[i][row] & (0x80 >> col)) ? 15 : 0;
                 }
             }
+            result->atlas.setGlyph(i, coverage);
         }
+        return result;
     } else {
-        // Selawik AA: anti-aliased with 1 byte per pixel (grayscale 0-15)
-        constexpr int SELAWIK_AA_BITMAP_WIDTH = fonts::SELAWIK_AA_WIDTH;
-        const uint8_t (*font_data)[SELAWIK_AA_BITMAP_WIDTH * fonts::SELAWIK_AA_HEIGHT] =
-            reinterpret_cast<const uint8_t (*)[SELAWIK_AA_BITMAP_WIDTH * fonts::SELAWIK_AA_HEIGHT]>(metrics.data);
-        for (int row = 0; row < metrics.height; row++) {
-            for (int col = 0; col < SELAWIK_AA_BITMAP_WIDTH; col++) {
-                int grayscale = font_data[char_index][row * SELAWIK_AA_BITMAP_WIDTH + col];
-                if (grayscale > 0) {
-                    // Scale grayscale by the requested color intensity
-                    int pixel_color = (grayscale * color + 7) / 15;  // Round to nearest
-                    setPixel(x + col, top_y + row, pixel_color);
-                }
-            }
+        // Selawik AA: already one 4-bit grayscale byte per pixel
+        constexpr int SELAWIK_AA_GLYPH_BYTES = fonts::SELAWIK_AA_WIDTH * fonts::SELAWIK_AA_HEIGHT;
+        FontAtlas* result = new FontAtlas(fonts::SELAWIK_AA_WIDTH, fonts::SELAWIK_AA_HEIGHT, 0);
+        for (int i = 0; i <= metrics.last_char - metrics.first_char; i++) {
+            result->atlas.setGlyph(i, metrics.data + i * SELAWIK_AA_GLYPH_BYTES);
         }
+        return result;
     }
 }
 
+const FontAtlas* getAtlas(FontType font) {
+    // Built on first use, from whichever thread draws first; never freed
+    static const FontAtlas* tiny = buildAtlas(FontType::TINY);
+    static const FontAtlas* normal = buildAtlas(FontType::NORMAL);
+    static const FontAtlas* large = buildAtlas(FontType::LARGE);
+    switch (font) {
+    case FontType::TINY: return tiny;
+    case FontType::NORMAL: return normal;
+    case FontType::LARGE: return large;
+    }
+    return nullptr;
+}
+
+inline int charWidth(const FontMetrics& metrics, char c) {
+    if (metrics.widths) {
+        int char_index = c - metrics.first_char;
+        if (char_index >= 0 && char_index <= (metrics.last_char - metrics.first_char)) {
+            return metrics.widths[char_index];
+        }
+    }
+    return metrics.width;
+}
+
+}  // namespace
+
+void drawChar(int x, int y, char c, FontType font, int color = 15) {
+    // Safety checks
+    if (x < -20 || x > 300 || y < -20 || y > 100) return;  // Reasonable bounds
+    if (color < 0 || color > 15) color = 15;  // Clamp color
+
+    const FontAtlas* atlas = getAtlas(font);
+    if (!atlas) return;
+    FontMetrics metrics = getFontMetrics(font);
+
+    // Convert baseline y to top-left y (y is baseline, subtract ascent to get top)
+    atlas->atlas.draw(NT_screen, x + atlas->xOffset, y - metrics.ascent, c - metrics.first_char, color);
+}
+
 void drawText(int x, int y, const char* text, FontType font, int color = 15) {
     if (!text) return;
 
+    const FontAtlas* atlas = getAtlas(font);
+    if (!atlas) return;
+    if (color < 0 || color > 15) color = 15;
+
     FontMetrics metrics = getFontMetrics(font);
+    int top_y = y - metrics.ascent;
     int current_x = x;
 
     while (*text) {
-        drawChar(current_x, y, *text, font, color);
-
-        int char_width = metrics.width;
-        if (metrics.widths) {
-            int char_index = *text - metrics.first_char;
-            if (char_index >= 0 && char_index <= (metrics.last_char - metrics.first_char)) {
-                char_width = metrics.widths[char_index];
-            }
+        // Same per-character bounds as drawChar
+        if (current_x >= -20 && current_x <= 300 && y >= -20 && y <= 100) {
+            atlas->atlas.draw(NT_screen, current_x + atlas->xOffset, top_y, *text - metrics.first_char, color);
         }
-
-        current_x += char_width + metrics.spacing;
+        current_x += charWidth(metrics, *text) + metrics.spacing;
         text++;
     }
 }
@@ -160,15 +179,7 @@ int getTextWidth(const char* text, FontType font) {
     int width = 0;
 
     while (*text) {
-        int char_width = metrics.width;
-        if (metrics.widths) {
-            int char_index = *text - metrics.first_char;
-            if (char_index >= 0 && char_index <= (metrics.last_char - metrics.first_char)) {
-                char_width = metrics.widths[char_index];
-            }
-        }
-
-        width += char_width + metrics.spacing;
+        width += charWidth(metrics, *text) + metrics.spacing;
         text++;
     }
     
@@ -0,0 +1,137 @@
+#include "RtLog.hpp"
+#include <rack.hpp>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+
+using namespace rack;
+
+// Hot-path chatter is off by default; errors still get through
+std::atomic<int> RtLog::verbosity[(int)RtLogCategory::Count] = {
+    {(int)RtLogLevel::Warn},    // Audio
+    {(int)RtLogLevel::Info},    // Plugin
+    {(int)RtLogLevel::Warn}     // Midi
+};
+
+RtLog& RtLog::getInstance() {
+    // Leaked on purpose: no static destructor joins or logs during unload
+    static RtLog* instance = new RtLog();
+    return *instance;
+}
+
+void RtLog::startDrain() {
+    RtLog& log = getInstance();
+    std::lock_guard<std::mutex> lock(log.drainMutex);
+    if (log.drainUsers++ == 0) {
+        log.running.store(true);
+        log.drainThread = std::thread(&RtLog::drainLoop, &log);
+    }
+}
+
+void RtLog::stopDrain() {
+    RtLog& log = getInstance();
+    std::lock_guard<std::mutex> lock(log.drainMutex);
+    if (log.drainUsers == 0 || --log.drainUsers > 0) return;
+    log.running.store(false);
+    if (log.drainThread.joinable()) {
+        log.drainThread.join();
+    }
+}
+
+RtLog::RtLog() {
+    // Vyukov-style bounded queue: slot i is free for the producer whose
+    // position equals its sequence number
+    for (uint32_t i = 0; i < CAPACITY; i++) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+void RtLog::setVerbosity(RtLogCategory category, RtLogLevel level) {
+    verbosity[(int)category].store((int)level, std::memory_order_relaxed);
+}
+
+RtLogLevel RtLog::getVerbosity(RtLogCategory category) {
+    return (RtLogLevel)verbosity[(int)category].load(std::memory_order_relaxed);
+}
+
+const char* RtLog::getCategoryName(RtLogCategory category) {
+    switch (category) {
+        case RtLogCategory::Audio: return "Audio";
+        case RtLogCategory::Plugin: return "Plugin";
+        case RtLogCategory::Midi: return "MIDI";
+        default: return "?";
+    }
+}
+
+const char* RtLog::getLevelName(RtLogLevel level) {
+    switch (level) {
+        case RtLogLevel::Off: return "Off";
+        case RtLogLevel::Warn: return "Warnings";
+        case RtLogLevel::Info: return "Info";
+        case RtLogLevel::Debug: return "Debug";
+        default: return "?";
+    }
+}
+
+void RtLog::write(RtLogCategory category, RtLogLevel level, const char* format, ...) {
+    uint32_t pos = writePos.load(std::memory_order_relaxed);
+    Record* record;
+    for (;;) {
+        record = &ring[pos & (CAPACITY - 1)];
+        uint32_t seq = record->sequence.load(std::memory_order_acquire);
+        int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            if (writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Ring full - drop rather than wait for the drain thread
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = writePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->category = category;
+    record->level = level;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(record->text, TEXT_SIZE, format, args);
+    va_end(args);
+
+    record->sequence.store(pos + 1, std::memory_order_release);
+}
+
+void RtLog::drain() {
+    for (;;) {
+        Record& record = ring[readPos & (CAPACITY - 1)];
+        if (record.sequence.load(std::memory_order_acquire) != readPos + 1) {
+            break;
+        }
+
+        const char* name = getCategoryName(record.category);
+        if (record.level == RtLogLevel::Warn) {
+            WARN("[%s] %s", name, record.text);
+        } else {
+            INFO("[%s] %s", name, record.text);
+        }
+
+        record.sequence.store(readPos + CAPACITY, std::memory_order_release);
+        readPos++;
+    }
+
+    uint32_t droppedNow = dropped.load(std::memory_order_relaxed);
+    if (droppedNow != droppedReported) {
+        WARN("RtLog: dropped %u records (ring full)", droppedNow - droppedReported);
+        droppedReported = droppedNow;
+    }
+}
+
+void RtLog::drainLoop() {
+    while (running.load()) {
+        drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    drain();
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/**
+ * RtLog - Real-time safe logging for the audio and MIDI paths
+ *
+ * Engine threads format a record into a fixed-size lock-free ring (multiple
+ * producers, one consumer) and return immediately. A drain thread forwards
+ * the records to Rack's logger. When the ring is full records are dropped
+ * and counted rather than blocking the caller.
+ *
+ * The drain runs while at least one module holds it (startDrain() in the
+ * module constructor, stopDrain() in its destructor), so it is never
+ * started from an engine thread nor left running into library unload.
+ *
+ * Use the RT_WARN / RT_INFO / RT_DEBUG macros: they check the category's
+ * verbosity before formatting, so disabled log sites cost one relaxed load.
+ */
+
+enum class RtLogCategory : uint8_t {
+    Audio,      // process() and block scheduling
+    Plugin,     // plugin step/draw/parameter errors
+    Midi,       // MIDI input/output traffic
+    Count
+};
+
+enum class RtLogLevel : uint8_t {
+    Off,
+    Warn,
+    Info,
+    Debug
+};
+
+class RtLog {
+public:
+    static constexpr int CAPACITY = 512;     // Must be a power of two
+    static constexpr int TEXT_SIZE = 120;
+
+    static RtLog& getInstance();
+
+    // Reference counted; the last stopDrain() joins the thread after
+    // forwarding whatever is still queued
+    static void startDrain();
+    static void stopDrain();
+
+    RtLog(const RtLog&) = delete;
+    RtLog& operator=(const RtLog&) = delete;
+
+    // Per-category verbosity (shared by all module instances)
+    static bool isEnabled(RtLogCategory category, RtLogLevel level) {
+        return level != RtLogLevel::Off &&
+               (int)level <= verbosity[(int)category].load(std::memory_order_relaxed);
+    }
+    static void setVerbosity(RtLogCategory category, RtLogLevel level);
+    static RtLogLevel getVerbosity(RtLogCategory category);
+    static const char* getCategoryName(RtLogCategory category);
+    static const char* getLevelName(RtLogLevel level);
+
+    // Format and enqueue a record. Never blocks or allocates.
+    void write(RtLogCategory category, RtLogLevel level, const char* format, ...)
+        __attribute__((format(printf, 4, 5)));
+
+    uint32_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    RtLog();
+    ~RtLog() = default;     // Never runs: the instance outlives library unload
+
+    struct Record {
+        std::atomic<uint32_t> sequence;
+        RtLogCategory category;
+        RtLogLevel level;
+        char text[TEXT_SIZE];
+    };
+
+    Record ring[CAPACITY];
+    alignas(64) std::atomic<uint32_t> writePos{0};
+    alignas(64) uint32_t readPos = 0;
+    std::atomic<uint32_t> dropped{0};
+    uint32_t droppedReported = 0;
+
+    std::thread drainThread;
+    std::atomic<bool> running{false};
+    std::mutex drainMutex;      // Guards drainUsers and the thread's lifetime
+    int drainUsers = 0;
+
+    static std::atomic<int> verbosity[(int)RtLogCategory::Count];
+
+    void drainLoop();
+    void drain();
+};
+
+#define RT_LOG(category, level, ...) \
+    do { \
+        if (RtLog::isEnabled(category, level)) { \
+            RtLog::getInstance().write(category, level, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define RT_WARN(category, ...) RT_LOG(RtLogCategory::category, RtLogLevel::Warn, __VA_ARGS__)
+#define RT_INFO(category, ...) RT_LOG(RtLogCategory::category, RtLogLevel::Info, __VA_ARGS__)
+#define RT_DEBUG(category, ...) RT_LOG(RtLogCategory::category, RtLogLevel::Debug, __VA_ARGS__)
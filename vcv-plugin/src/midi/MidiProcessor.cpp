@@ -1,5 +1,6 @@
 #include "MidiProcessor.hpp"
 #include "../plugin/PluginExecutor.hpp"
+#include "../log/RtLog.hpp"
 #include <rack.hpp>
 #include <algorithm>
 
@@ -26,19 +27,21 @@ void MidiProcessor::processInputMessages(const Module::ProcessArgs& args) {
 
 void MidiProcessor::sendOutputMessage(const midi::Message& msg) {
     if (!isValidMidiMessage(msg)) {
-        INFO("MidiProcessor: Invalid MIDI message, size=%d", (int)msg.bytes.size());
+        RT_WARN(Midi, "MidiProcessor: Invalid MIDI message, size=%d", (int)msg.bytes.size());
         return;
     }
     
     // Debug: Log MIDI output messages
-    if (msg.bytes.size() >= 3) {
-        INFO("MidiProcessor: Sending MIDI message: %02X %02X %02X", 
-             msg.bytes[0], msg.bytes[1], msg.bytes[2]);
-    } else if (msg.bytes.size() == 2) {
-        INFO("MidiProcessor: Sending MIDI message: %02X %02X", 
-             msg.bytes[0], msg.bytes[1]);
-    } else if (msg.bytes.size() == 1) {
-        INFO("MidiProcessor: Sending MIDI message: %02X", msg.bytes[0]);
+    if (RtLog::isEnabled(RtLogCategory::Midi, RtLogLevel::Debug)) {
+        if (msg.bytes.size() >= 3) {
+            RT_DEBUG(Midi, "MidiProcessor: Sending MIDI message: %02X %02X %02X",
+                     msg.bytes[0], msg.bytes[1], msg.bytes[2]);
+        } else if (msg.bytes.size() == 2) {
+            RT_DEBUG(Midi, "MidiProcessor: Sending MIDI message: %02X %02X",
+                     msg.bytes[0], msg.bytes[1]);
+        } else if (msg.bytes.size() == 1) {
+            RT_DEBUG(Midi, "MidiProcessor: Sending MIDI message: %02X", msg.bytes[0]);
+        }
     }
     
     midiOutput.sendMessage(msg);
@@ -46,7 +49,7 @@ void MidiProcessor::sendOutputMessage(const midi::Message& msg) {
     triggerOutputLight();
     notifyOutputSent(msg);
     
-    INFO("MidiProcessor: MIDI message sent, total sent: %d, output light triggered", stats.messagesSent);
+    RT_DEBUG(Midi, "MidiProcessor: MIDI message sent, total sent: %d", stats.messagesSent);
 }
 
 void MidiProcessor::updateActivityLights(float deltaTime) {
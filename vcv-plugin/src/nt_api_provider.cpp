@@ -1,27 +1,17 @@
 #include "nt_api_interface.h"
+#include "api/NTApiContext.hpp"
+#include "api/CycleCounter.hpp"
 #include <distingnt/api.h>
 #include <cstring>
 #include <cstdio>
 #include <atomic>
 
-// External NT_screen buffer (defined in DistingNT.cpp)
+// External NT_screen buffer (defined in api/NTApiContext.cpp)
 extern uint8_t NT_screen[128 * 64];
 
-// Global NT_globals structure (we need to populate this)
-static _NT_globals g_nt_globals = {
-    .sampleRate = 48000,
-    .maxFramesPerStep = 256,
-    .workBuffer = nullptr,
-    .workBufferSizeBytes = 0
-};
-
 // Thread-safe access flag for display buffer
 static std::atomic<bool> displayDirty{false};
 
-// External reference to current module (forward declared)
-struct EmulatorModule;
-extern EmulatorModule* g_currentModule;
-
 // Forward declarations of API implementation functions
 extern "C" {
     // These are already implemented in DistingNT.cpp
@@ -65,19 +55,19 @@ static int api_floatToString(char* buffer, float value, int decimalPlaces) {
 
 // Stub implementations for parameter/MIDI functions (to be implemented when needed)
 static int32_t api_algorithmIndex(const _NT_algorithm* algorithm) {
-    // TODO: Implement actual algorithm index lookup
-    return -1;
+    return NTApi::getCurrentAlgorithmIndex();
 }
 
+// Forward declarations
+extern "C" void emulatorHandleSetParameterFromUi(uint32_t algorithmIndex, uint32_t parameter, int16_t value);
+extern "C" void emulatorHandleSetParameterFromAudio(uint32_t algorithmIndex, uint32_t parameter, int16_t value);
+
 static void api_setParameterFromAudio(uint32_t algorithmIndex, uint32_t parameter, int16_t value) {
-    // TODO: Connect to VCV parameter system
+    emulatorHandleSetParameterFromAudio(algorithmIndex, parameter, value);
 }
 
-// Forward declaration
-extern "C" void emulatorHandleSetParameterFromUi(uint32_t parameter, int16_t value);
-
 static void api_setParameterFromUi(uint32_t algorithmIndex, uint32_t parameter, int16_t value) {
-    emulatorHandleSetParameterFromUi(parameter, value);
+    emulatorHandleSetParameterFromUi(algorithmIndex, parameter, value);
 }
 
 static uint32_t api_parameterOffset(void) {
@@ -110,8 +100,7 @@ static void api_sendMidiSysEx(uint32_t destination, const uint8_t* data, uint32_
 }
 
 static uint32_t api_getCpuCycleCount(void) {
-    // TODO: Implement CPU cycle counting for profiling
-    return 0;
+    return (uint32_t)NTApi::readCycleCounter();
 }
 
 static void api_setParameterRange(_NT_parameter* ptr, float init, float min, float max, float step) {
@@ -166,26 +155,38 @@ static NT_API_Interface g_api_interface = {
     .getCpuCycleCount = api_getCpuCycleCount,
     .setParameterRange = api_setParameterRange,
     
-    // Global data access
-    .globals = &g_nt_globals
+    // Global data access (per-instance copies point at NTApiContext::globals)
+    .globals = &NT_globals
 };
 
 // Main API provider function
 extern "C" __attribute__((visibility("default"))) const NT_API_Interface* getNT_API(void) {
+    // Called from inside a plugin call: hand out the calling module's table
+    NTApiContext* context = NTApi::getCurrentContext();
+    if (context && context->apiInterface.version != 0) {
+        return &context->apiInterface;
+    }
     return &g_api_interface;
 }
 
+void NTApi::initApiInterface(NTApiContext* context) {
+    context->apiInterface = g_api_interface;
+    context->apiInterface.globals = &context->globals;
+}
+
 // Function to check if display needs updating (can be called from VCV render loop)
 extern "C" bool NT_isDisplayDirty(void) {
     return displayDirty.exchange(false);
 }
 
-// Function to update globals (called from VCV module)
+// Function to update globals of the module whose context is installed
 extern "C" void NT_updateGlobals(uint32_t sampleRate, uint32_t maxFrames, float* workBuffer, uint32_t workBufferSize) {
-    g_nt_globals.sampleRate = sampleRate;
-    g_nt_globals.maxFramesPerStep = maxFrames;
-    g_nt_globals.workBuffer = workBuffer;
-    g_nt_globals.workBufferSizeBytes = workBufferSize;
+    NTApiContext* context = NTApi::getCurrentContext();
+    if (!context) return;
+    context->globals.sampleRate = sampleRate;
+    context->globals.maxFramesPerStep = maxFrames;
+    context->globals.workBuffer = workBuffer;
+    context->globals.workBufferSizeBytes = workBufferSize;
 }
 
-// No module registry needed - using simple global approach
\ No newline at end of file
+// Per-module state lives in NTApiContext, installed around each plugin call
\ No newline at end of file
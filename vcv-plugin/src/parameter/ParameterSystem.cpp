@@ -11,7 +11,7 @@ ParameterSystem::ParameterSystem(PluginManager* manager) : pluginManager(manager
     currentParamIndex = 0;
 }
 
-void ParameterSystem::extractParameterData() {
+void ParameterSystem::extractParameterData(bool keepValues) {
     if (!pluginManager || !pluginManager->isLoaded()) {
         WARN("ParameterSystem: Cannot extract parameters - plugin not loaded");
         return;
@@ -26,6 +26,8 @@ void ParameterSystem::extractParameterData() {
     }
     
     // Clear existing data first
+    int previousPage = currentPageIndex;
+    int previousParam = currentParamIndex;
     clearParameters();
     
     try {
@@ -96,11 +98,11 @@ void ParameterSystem::extractParameterData() {
                 // Extract each parameter safely
                 for (uint32_t i = 0; i < reqs.numParameters; i++) {
                     const _NT_parameter* param = &parametersPtr[i];
-                    if (extractSingleParameter(param, i)) {
-                        // Set default value in routing matrix
-                        if (i < routingMatrix.size()) {
-                            routingMatrix[i] = parameters.back().def;
-                        }
+                    if (extractSingleParameter(param, i) && i < routingMatrix.size()) {
+                        // Set default value in routing matrix, or keep the current one in range
+                        const _NT_parameter& extracted = parameters.back();
+                        routingMatrix[i] = keepValues ? clamp(routingMatrix[i], extracted.min, extracted.max) : extracted.def;
+                        touchValues();
                     }
                 }
             }
@@ -138,12 +140,13 @@ void ParameterSystem::extractParameterData() {
             WARN("ParameterSystem: Failed to set algorithm routing matrix pointer");
         }
         
-        // Reset navigation to first page/param
-        currentPageIndex = 0;
-        currentParamIndex = 0;
+        if (keepValues) {
+            if (previousPage < (int)parameterPages.size()) currentPageIndex = previousPage;
+            if (previousParam < (int)parameters.size()) currentParamIndex = previousParam;
+        }
         
         // Initialize all parameters by calling parameterChanged
-        if (factory && factory->parameterChanged && algorithm) {
+        if (!keepValues && factory && factory->parameterChanged && algorithm) {
             for (size_t i = 0; i < parameters.size(); i++) {
                 try {
                     factory->parameterChanged(algorithm, i);
@@ -171,6 +174,7 @@ void ParameterSystem::clearParameters() {
     currentPageIndex = 0;
     currentParamIndex = 0;
     grayedOut.fill(false);
+    touchLayout();
 }
 
 void ParameterSystem::setCurrentPage(int pageIndex) {
@@ -199,6 +203,7 @@ void ParameterSystem::setParameterValue(int paramIdx, int16_t value) {
     
     if (paramIdx < (int)routingMatrix.size()) {
         routingMatrix[paramIdx] = clampedValue;
+        touchValues();
         notifyParameterChanged(paramIdx, clampedValue);
     }
 }
@@ -222,6 +227,7 @@ void ParameterSystem::resetParametersToDefaults() {
     for (size_t i = 0; i < parameters.size() && i < routingMatrix.size(); i++) {
         routingMatrix[i] = parameters[i].def;
     }
+    touchValues();
 }
 
 void ParameterSystem::clampParameterValues() {
@@ -229,6 +235,7 @@ void ParameterSystem::clampParameterValues() {
         const _NT_parameter& param = parameters[i];
         routingMatrix[i] = clamp(routingMatrix[i], param.min, param.max);
     }
+    touchValues();
 }
 
 bool ParameterSystem::canNavigateToNextPage() const {
@@ -381,7 +388,9 @@ void ParameterSystem::updateParameterDefinition(uint32_t parameterIndex) {
     if (parameterIndex < routingMatrix.size()) {
         int16_t val = routingMatrix[parameterIndex];
         routingMatrix[parameterIndex] = clamp(val, liveParam->min, liveParam->max);
+        touchValues();
     }
+    touchLayout();
 }
 
 void ParameterSystem::reExtractParameterPages() {
@@ -394,6 +403,7 @@ void ParameterSystem::reExtractParameterPages() {
 
     // Clear existing pages and re-extract from the live plugin.
     parameterPages.clear();
+    touchLayout();
 
     try {
         uint32_t numPages = parameterPagesPtr->numPages;
@@ -468,6 +478,7 @@ void ParameterSystem::removeObserver(IParameterObserver* observer) {
 void ParameterSystem::setRoutingMatrixValue(int index, int16_t value) {
     if (index >= 0 && index < (int)routingMatrix.size()) {
         routingMatrix[index] = value;
+        touchValues();
         notifyParameterChanged(index, value);
     }
 }
@@ -510,6 +521,7 @@ void ParameterSystem::loadParameterState(json_t* rootJ) {
                 routingMatrix[i] = (int16_t)json_integer_value(valueJ);
             }
         }
+        touchValues();
         
         // Notify plugin about parameter changes after loading saved values
         if (pluginManager && pluginManager->getFactory() && pluginManager->getFactory()->parameterChanged && pluginManager->getAlgorithm()) {
@@ -527,6 +539,116 @@ void ParameterSystem::loadParameterState(json_t* rootJ) {
     }
 }
 
+void ParameterSystem::extractSlotParameters(int slot, AlgorithmSlot& algorithmSlot) {
+    if (slot < 1 || !algorithmSlot.algorithm) {
+        WARN("ParameterSystem: Cannot extract parameters - no algorithm in slot %d", slot);
+        return;
+    }
+    
+    if ((int)slotParameters.size() < slot) {
+        slotParameters.resize(slot);
+    }
+    if (!slotParameters[slot - 1]) {
+        slotParameters[slot - 1].reset(new SlotParameters());
+    }
+    SlotParameters& slotParams = *slotParameters[slot - 1];
+    slotParams.parameters.clear();
+    slotParams.values.fill(0);
+    
+    _NT_algorithm* algorithm = algorithmSlot.algorithm;
+    const _NT_parameter* parametersPtr = algorithm->parameters;
+    uint32_t numParameters = std::min<uint32_t>(algorithmSlot.numParameters, slotParams.values.size());
+    if (numParameters > 0 && isValidPointer((void*)parametersPtr)) {
+        for (uint32_t i = 0; i < numParameters; i++) {
+            slotParams.parameters.push_back(parametersPtr[i]);
+            slotParams.values[i] = parametersPtr[i].def;
+        }
+    }
+    algorithm->v = slotParams.values.data();
+    
+    if (algorithmSlot.factory && algorithmSlot.factory->parameterChanged) {
+        for (size_t i = 0; i < slotParams.parameters.size(); i++) {
+            try {
+                algorithmSlot.factory->parameterChanged(algorithm, i);
+            } catch (...) {
+                WARN("Failed to initialize parameter %zu of slot %d", i, slot);
+            }
+        }
+    }
+    
+    INFO("ParameterSystem: Extracted %zu parameters for slot %d", slotParams.parameters.size(), slot);
+}
+
+void ParameterSystem::removeSlotParameters(int slot) {
+    if (slot >= 1 && slot <= (int)slotParameters.size()) {
+        slotParameters.erase(slotParameters.begin() + (slot - 1));
+    }
+}
+
+void ParameterSystem::clearSlotParameters() {
+    slotParameters.clear();
+}
+
+size_t ParameterSystem::getSlotParameterCount(int slot) const {
+    SlotParameters* slotParams = findSlotParameters(slot);
+    return slotParams ? slotParams->parameters.size() : 0;
+}
+
+const _NT_parameter* ParameterSystem::getSlotParameterInfo(int slot, int paramIdx) const {
+    SlotParameters* slotParams = findSlotParameters(slot);
+    if (!slotParams || paramIdx < 0 || paramIdx >= (int)slotParams->parameters.size()) return nullptr;
+    return &slotParams->parameters[paramIdx];
+}
+
+int16_t ParameterSystem::getSlotParameterValue(int slot, int paramIdx) const {
+    SlotParameters* slotParams = findSlotParameters(slot);
+    if (!slotParams || paramIdx < 0 || paramIdx >= (int)slotParams->values.size()) return 0;
+    return slotParams->values[paramIdx];
+}
+
+void ParameterSystem::setSlotParameterValue(int slot, int paramIdx, int16_t value) {
+    const _NT_parameter* param = getSlotParameterInfo(slot, paramIdx);
+    if (!param) return;
+    
+    int16_t clampedValue = clamp(value, param->min, param->max);
+    findSlotParameters(slot)->values[paramIdx] = clampedValue;
+    for (auto* observer : observers) {
+        observer->onSlotParameterChanged(slot, paramIdx, clampedValue);
+    }
+}
+
+void ParameterSystem::writeSlotParameterValue(int slot, int paramIdx, int16_t value) {
+    SlotParameters* slotParams = findSlotParameters(slot);
+    if (slotParams && paramIdx >= 0 && paramIdx < (int)slotParams->values.size()) {
+        slotParams->values[paramIdx] = value;
+    }
+}
+
+json_t* ParameterSystem::saveSlotParameterState(int slot) const {
+    json_t* valuesJ = json_array();
+    SlotParameters* slotParams = findSlotParameters(slot);
+    if (slotParams) {
+        for (size_t i = 0; i < slotParams->parameters.size(); i++) {
+            json_array_append_new(valuesJ, json_integer(slotParams->values[i]));
+        }
+    }
+    return valuesJ;
+}
+
+void ParameterSystem::loadSlotParameterState(int slot, json_t* valuesJ) {
+    if (!valuesJ || !json_is_array(valuesJ)) return;
+    
+    size_t arraySize = json_array_size(valuesJ);
+    for (size_t i = 0; i < arraySize && i < getSlotParameterCount(slot); i++) {
+        setSlotParameterValue(slot, i, (int16_t)json_integer_value(json_array_get(valuesJ, i)));
+    }
+}
+
+ParameterSystem::SlotParameters* ParameterSystem::findSlotParameters(int slot) const {
+    if (slot < 1 || slot > (int)slotParameters.size()) return nullptr;
+    return slotParameters[slot - 1].get();
+}
+
 void ParameterSystem::notifyParameterChanged(int index, int16_t value) {
     for (auto* observer : observers) {
         observer->onParameterChanged(index, value);
@@ -595,6 +717,7 @@ bool ParameterSystem::extractSingleParameter(const _NT_parameter* param, uint32_
         paramCopy.enumStrings = param->enumStrings;
         
         parameters.push_back(paramCopy);
+        touchLayout();
         INFO("ParameterSystem: Extracted parameter %u: '%s' [%d-%d, def=%d]", 
              index, param->name, param->min, param->max, param->def);
         
@@ -621,6 +744,7 @@ bool ParameterSystem::extractSinglePage(const _NT_parameterPage* page, uint32_t
         pageCopy.params = page->params; // Keep pointer reference
         
         parameterPages.push_back(pageCopy);
+        touchLayout();
         INFO("ParameterSystem: Extracted page %u: '%s' (%u params)", 
              index, page->name, page->numParams);
         
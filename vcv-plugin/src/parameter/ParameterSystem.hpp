@@ -2,7 +2,9 @@
 #include <rack.hpp>
 #include <vector>
 #include <array>
+#include <atomic>
 #include <functional>
+#include <memory>
 #include "../nt_api_interface.h"
 
 using namespace rack;
@@ -10,6 +12,7 @@ using namespace rack;
 // Forward declarations
 class PluginManager;
 class IParameterObserver;
+struct AlgorithmSlot;
 
 // Observer interface for parameter changes
 class IParameterObserver {
@@ -18,6 +21,7 @@ public:
     virtual void onParameterChanged(int index, int16_t value) = 0;
     virtual void onParameterPageChanged(int pageIndex) = 0;
     virtual void onParametersExtracted() = 0;
+    virtual void onSlotParameterChanged(int slot, int index, int16_t value) {}
 };
 
 // Parameter management system
@@ -27,7 +31,10 @@ public:
     ~ParameterSystem() = default;
     
     // Parameter extraction and management
-    void extractParameterData();
+    // With keepValues the routing matrix and menu position are left alone and
+    // parameterChanged() is not replayed (used after a hot swap, where the new
+    // build was already given the current values)
+    void extractParameterData(bool keepValues = false);
     void clearParameters();
     
     // Parameter pages
@@ -90,6 +97,13 @@ public:
     void addObserver(IParameterObserver* observer);
     void removeObserver(IParameterObserver* observer);
     
+    // Change counters for views that cache what they show (the OLED menu).
+    // The layout generation moves when parameter definitions or pages
+    // change, the value generation when a value is written through this
+    // class. Writes through the non-const getRoutingMatrix() aren't counted.
+    uint32_t getLayoutGeneration() const { return layoutGeneration.load(std::memory_order_relaxed); }
+    uint32_t getValueGeneration() const { return valueGeneration.load(std::memory_order_relaxed); }
+    
     // Routing matrix access (parameter values storage)
     const std::array<int16_t, 256>& getRoutingMatrix() const { return routingMatrix; }
     std::array<int16_t, 256>& getRoutingMatrix() { return routingMatrix; }
@@ -99,6 +113,21 @@ public:
     json_t* saveParameterState();
     void loadParameterState(json_t* rootJ);
     
+    // Parameters of chained algorithm slots (see PluginManager::addSlot).
+    // Everything above belongs to slot 0; each chained slot keeps its own
+    // definitions and value array, which its algorithm->v points at.
+    // extractSlotParameters() runs before the slot is published at `slot`.
+    void extractSlotParameters(int slot, AlgorithmSlot& algorithmSlot);
+    void removeSlotParameters(int slot);
+    void clearSlotParameters();
+    size_t getSlotParameterCount(int slot) const;
+    const _NT_parameter* getSlotParameterInfo(int slot, int paramIdx) const;
+    int16_t getSlotParameterValue(int slot, int paramIdx) const;
+    void setSlotParameterValue(int slot, int paramIdx, int16_t value);
+    void writeSlotParameterValue(int slot, int paramIdx, int16_t value);  // No notification
+    json_t* saveSlotParameterState(int slot) const;
+    void loadSlotParameterState(int slot, json_t* valuesJ);
+    
 private:
     PluginManager* pluginManager;
     
@@ -115,6 +144,19 @@ private:
 
     // Grayed out state (API v10)
     std::array<bool, 256> grayedOut{};
+    
+    std::atomic<uint32_t> layoutGeneration{0};
+    std::atomic<uint32_t> valueGeneration{0};
+    void touchLayout() { layoutGeneration.fetch_add(1, std::memory_order_relaxed); }
+    void touchValues() { valueGeneration.fetch_add(1, std::memory_order_relaxed); }
+    
+    // Chained slot parameters, index = slot - 1
+    struct SlotParameters {
+        std::vector<_NT_parameter> parameters;
+        std::array<int16_t, 256> values{};
+    };
+    std::vector<std::unique_ptr<SlotParameters>> slotParameters;
+    SlotParameters* findSlotParameters(int slot) const;
 
     // Observers
     std::vector<IParameterObserver*> observers;
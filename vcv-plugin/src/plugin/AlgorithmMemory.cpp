@@ -0,0 +1,150 @@
+#include "AlgorithmMemory.hpp"
+#include "MemoryGuard.hpp"
+#include <cstring>
+#include <utility>
+
+#ifndef ARCH_WIN
+#include <sys/mman.h>
+#endif
+
+namespace {
+    // Physical sizes on the NT's Cortex-M7. The tightly-coupled memories are
+    // shared with the firmware, so these are upper bounds for one algorithm.
+    const uint32_t REGION_LIMITS[(int)MemoryRegion::Count] = {
+        512 * 1024,             // SRAM
+        32 * 1024 * 1024,       // DRAM (SDRAM)
+        128 * 1024,             // DTC
+        64 * 1024,              // ITC
+    };
+
+    const char* const REGION_NAMES[(int)MemoryRegion::Count] = {
+        "SRAM", "DRAM", "DTC", "ITC"
+    };
+
+    size_t roundUp(size_t size, size_t alignment) {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+}
+
+bool AlgorithmMemory::allocate(const _NT_algorithmRequirements& reqs, std::string& error,
+                               const char* owner, bool useGuard) {
+    release();
+
+    if (useGuard && !MemoryGuard::isSupported()) {
+        error = "Guarded memory is not supported on this platform";
+        return false;
+    }
+    guarded = useGuard;
+
+    for (int r = 0; r < (int)MemoryRegion::Count; r++) {
+        MemoryRegion region = (MemoryRegion)r;
+        uint32_t size = getRequested(reqs, region);
+        if (size == 0) continue;
+
+        MemoryArena::Block& block = blocks[r];
+        if (guarded) {
+            block.data = MemoryGuard::getInstance().allocate(size, CACHE_LINE_SIZE, owner, REGION_NAMES[r]);
+            if (!block.data) {
+                error = std::string("Failed to map guarded ") + REGION_NAMES[r] + " (" + std::to_string(size) + " bytes)";
+                release();
+                return false;
+            }
+            sizes[r] = size;
+            continue;
+        }
+
+        size_t alignment = CACHE_LINE_SIZE;
+        bool huge = false;
+        if (region == MemoryRegion::DRAM) {
+            alignment = HOST_PAGE_SIZE;
+            #if !defined(ARCH_WIN) && defined(MADV_HUGEPAGE)
+                huge = size >= HUGE_PAGE_SIZE;
+                if (huge) alignment = HUGE_PAGE_SIZE;
+            #endif
+        }
+
+        size_t capacity = roundUp(size, alignment);
+        if (!arena || !arena->acquire(capacity, alignment, block)) {
+            block.data = MemoryArena::allocateAligned(capacity, alignment);
+            if (!block.data) {
+                error = std::string("Failed to allocate ") + REGION_NAMES[r] + " (" + std::to_string(size) + " bytes)";
+                release();
+                return false;
+            }
+            block.capacity = capacity;
+            block.alignment = alignment;
+            block.hugePages = false;
+
+            #if !defined(ARCH_WIN) && defined(MADV_HUGEPAGE)
+                // Advise before the memset below so the first touch faults in huge pages
+                if (huge && madvise(block.data, capacity, MADV_HUGEPAGE) == 0) {
+                    block.hugePages = true;
+                }
+            #endif
+        }
+        (void)huge;
+
+        // Recycled blocks may hold the previous instance's state
+        std::memset(block.data, 0, capacity);
+        sizes[r] = size;
+        hugePages |= block.hugePages;
+    }
+    return true;
+}
+
+void AlgorithmMemory::release() {
+    for (int r = 0; r < (int)MemoryRegion::Count; r++) {
+        MemoryArena::Block& block = blocks[r];
+        if (block.data) {
+            if (guarded) {
+                MemoryGuard::getInstance().release(block.data);
+            } else if (arena) {
+                arena->recycle(block);
+            } else {
+                MemoryArena::freeAligned(block.data);
+            }
+        }
+        block = MemoryArena::Block();
+        sizes[r] = 0;
+    }
+    hugePages = false;
+    guarded = false;
+}
+
+void AlgorithmMemory::swap(AlgorithmMemory& other) {
+    for (int r = 0; r < (int)MemoryRegion::Count; r++) {
+        std::swap(blocks[r], other.blocks[r]);
+        std::swap(sizes[r], other.sizes[r]);
+    }
+    std::swap(hugePages, other.hugePages);
+    std::swap(guarded, other.guarded);
+}
+
+_NT_algorithmMemoryPtrs AlgorithmMemory::getPointers() const {
+    _NT_algorithmMemoryPtrs ptrs;
+    ptrs.sram = (uint8_t*)blocks[(int)MemoryRegion::SRAM].data;
+    ptrs.dram = (uint8_t*)blocks[(int)MemoryRegion::DRAM].data;
+    ptrs.dtc = (uint8_t*)blocks[(int)MemoryRegion::DTC].data;
+    ptrs.itc = (uint8_t*)blocks[(int)MemoryRegion::ITC].data;
+    return ptrs;
+}
+
+const char* AlgorithmMemory::getRegionName(MemoryRegion region) {
+    if (region < MemoryRegion::SRAM || region >= MemoryRegion::Count) return "Unknown";
+    return REGION_NAMES[(int)region];
+}
+
+uint32_t AlgorithmMemory::getRegionLimit(MemoryRegion region) {
+    if (region < MemoryRegion::SRAM || region >= MemoryRegion::Count) return 0;
+    return REGION_LIMITS[(int)region];
+}
+
+uint32_t AlgorithmMemory::getRequested(const _NT_algorithmRequirements& reqs, MemoryRegion region) {
+    switch (region) {
+        case MemoryRegion::SRAM: return reqs.sram;
+        case MemoryRegion::DRAM: return reqs.dram;
+        case MemoryRegion::DTC: return reqs.dtc;
+        case MemoryRegion::ITC: return reqs.itc;
+        default: return 0;
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "../nt_api_interface.h"
+#include "MemoryArena.hpp"
+
+// The four memory classes an algorithm asks for in calculateRequirements()
+enum class MemoryRegion {
+    SRAM,
+    DRAM,
+    DTC,
+    ITC,
+    Count
+};
+
+/**
+ * AlgorithmMemory - Instance memory for one algorithm, one block per region
+ *
+ * Each region is allocated and zeroed separately, as on the hardware where
+ * they are different memories, so a plugin that overruns one region does
+ * not silently scribble into the next. SRAM, DTC and ITC are cache-line
+ * aligned; DRAM is page aligned, and large DRAM requests (sample buffers,
+ * delay lines) are placed on 2 MB boundaries and advised for transparent
+ * huge pages where the host supports it, so TLB behaviour while profiling
+ * is closer to the device's flat SDRAM mapping.
+ *
+ * With an arena set, blocks are taken from and returned to it, so a
+ * reconstructed algorithm reuses the previous instance's memory. In guarded
+ * mode every region comes from MemoryGuard instead, bracketed by
+ * inaccessible pages so the first out-of-bounds access traps with a report.
+ */
+class AlgorithmMemory {
+public:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    static constexpr size_t HOST_PAGE_SIZE = 4096;
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    AlgorithmMemory() = default;
+    ~AlgorithmMemory() { release(); }
+
+    AlgorithmMemory(const AlgorithmMemory&) = delete;
+    AlgorithmMemory& operator=(const AlgorithmMemory&) = delete;
+
+    // Must outlive this object (or be unset before it goes)
+    void setArena(MemoryArena* memoryArena) { arena = memoryArena; }
+
+    // Frees any previous allocation first; on failure nothing stays allocated.
+    // `owner` names the algorithm in guard-page fault reports.
+    bool allocate(const _NT_algorithmRequirements& reqs, std::string& error,
+                  const char* owner = nullptr, bool guarded = false);
+    void release();
+
+    // Exchanges the allocations (not the arenas); no allocation, so the
+    // audio thread can use it to switch instances
+    void swap(AlgorithmMemory& other);
+
+    _NT_algorithmMemoryPtrs getPointers() const;
+    uint32_t getSize(MemoryRegion region) const { return sizes[(int)region]; }
+    bool isHugePageBacked() const { return hugePages; }
+    bool isGuarded() const { return guarded; }
+
+    static const char* getRegionName(MemoryRegion region);
+
+    // Bytes of each region available to algorithms on the disting NT
+    static uint32_t getRegionLimit(MemoryRegion region);
+    static uint32_t getRequested(const _NT_algorithmRequirements& reqs, MemoryRegion region);
+
+private:
+    MemoryArena::Block blocks[(int)MemoryRegion::Count];
+    uint32_t sizes[(int)MemoryRegion::Count] = {};
+    MemoryArena* arena = nullptr;
+    bool hugePages = false;
+    bool guarded = false;
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include "../nt_api_interface.h"
+#include "AlgorithmMemory.hpp"
+
+// One algorithm in a module's chain. Slot 0 is the primary plugin owned
+// directly by PluginManager; chained slots 1..N are stepped after it on
+// the same bus buffer, in order, like the algorithm list on the hardware.
+struct AlgorithmSlot {
+    void* handle = nullptr;
+    _NT_factory* factory = nullptr;
+    _NT_algorithm* algorithm = nullptr;
+    AlgorithmMemory memory;
+    std::string path;
+    std::vector<int32_t> specifications;
+    uint32_t numParameters = 0;
+    uint32_t id = 0;    // Stable across removals of earlier slots; set by addSlot()
+
+    // Set by the audio thread when the slot throws; it is skipped afterwards
+    std::atomic<bool> faulted{false};
+
+    const char* getName() const {
+        return (factory && factory->name) ? factory->name : "Unknown";
+    }
+};
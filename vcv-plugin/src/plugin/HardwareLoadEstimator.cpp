@@ -0,0 +1,161 @@
+#include "HardwareLoadEstimator.hpp"
+#include "../api/CycleCounter.hpp"
+#include <cmath>
+#include <algorithm>
+#include <memory>
+
+namespace {
+    constexpr int KERNEL_FRAMES = 1024;
+    constexpr int KERNEL_PASSES = 64;    // Per timed run
+    constexpr int KERNEL_RUNS = 7;       // Fastest run is kept
+
+    struct KernelBuffers {
+        float input[KERNEL_FRAMES];
+        float output[KERNEL_FRAMES];
+        float table[257];
+    };
+
+    // Reference kernels. Cycle costs are for the Cortex-M7 with data in DTC
+    // and code in ITC, counted from its dual-issue FPU schedule; they stand
+    // for the kind of inner loops NT plugins are made of.
+
+    // Direct form I biquad: serial FMA chain through the feedback path (~12 cycles)
+    __attribute__((noinline)) float kernelBiquad(KernelBuffers& b) {
+        float x1 = 0.f, x2 = 0.f, y1 = 0.f, y2 = 0.f;
+        const float b0 = 0.2f, b1 = 0.4f, b2 = 0.2f, a1 = -0.3f, a2 = 0.1f;
+        for (int i = 0; i < KERNEL_FRAMES; i++) {
+            float x = b.input[i];
+            float y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+            x2 = x1; x1 = x;
+            y2 = y1; y1 = y;
+            b.output[i] = y;
+        }
+        return y1;
+    }
+
+    // Gain and accumulate onto a bus: load, load, multiply-add, store (~3 cycles)
+    __attribute__((noinline)) float kernelGain(KernelBuffers& b) {
+        const float gain = 0.7f;
+        for (int i = 0; i < KERNEL_FRAMES; i++) {
+            b.output[i] += b.input[i] * gain;
+        }
+        return b.output[KERNEL_FRAMES - 1];
+    }
+
+    // Wavetable oscillator with linear interpolation (~14 cycles)
+    __attribute__((noinline)) float kernelInterpolate(KernelBuffers& b) {
+        float phase = 0.f;
+        const float increment = 0.013f;
+        for (int i = 0; i < KERNEL_FRAMES; i++) {
+            float position = phase * 256.f;
+            int index = (int)position;
+            float fraction = position - index;
+            b.output[i] = b.table[index] + (b.table[index + 1] - b.table[index]) * fraction;
+            phase += increment;
+            if (phase >= 1.f) phase -= 1.f;
+        }
+        return phase;
+    }
+
+    // Rational tanh saturator; dominated by the 14-cycle VDIV (~24 cycles)
+    __attribute__((noinline)) float kernelSaturate(KernelBuffers& b) {
+        for (int i = 0; i < KERNEL_FRAMES; i++) {
+            float x = b.input[i] * 3.f;
+            float x2 = x * x;
+            b.output[i] = x * (27.f + x2) / (27.f + 9.f * x2);
+        }
+        return b.output[KERNEL_FRAMES - 1];
+    }
+
+    struct KernelDef {
+        const char* name;
+        float targetCyclesPerSample;
+        float (*run)(KernelBuffers&);
+    };
+
+    const KernelDef KERNEL_DEFS[HardwareLoadEstimator::NUM_KERNELS] = {
+        {"biquad", 12.f, kernelBiquad},
+        {"gain", 3.f, kernelGain},
+        {"interpolate", 14.f, kernelInterpolate},
+        {"saturate", 24.f, kernelSaturate},
+    };
+
+    volatile float g_kernelSink = 0.f;
+}
+
+HardwareLoadEstimator& HardwareLoadEstimator::getInstance() {
+    static HardwareLoadEstimator instance;
+    return instance;
+}
+
+HardwareLoadEstimator::HardwareLoadEstimator() {
+    for (int k = 0; k < NUM_KERNELS; k++) {
+        kernels[k] = {KERNEL_DEFS[k].name, KERNEL_DEFS[k].targetCyclesPerSample, 0.f, 1.f};
+    }
+}
+
+HardwareLoadEstimator::~HardwareLoadEstimator() {
+    if (calibrationThread.joinable()) {
+        calibrationThread.join();
+    }
+}
+
+void HardwareLoadEstimator::requestCalibration() {
+    bool expected = false;
+    if (isCalibrated() || !calibrating.compare_exchange_strong(expected, true)) {
+        return;
+    }
+    calibrationThread = std::thread(&HardwareLoadEstimator::calibrate, this);
+}
+
+void HardwareLoadEstimator::calibrate() {
+    std::unique_ptr<KernelBuffers> buffers(new KernelBuffers());
+    for (int i = 0; i < KERNEL_FRAMES; i++) {
+        buffers->input[i] = std::sin(i * 0.05f) * 0.8f;
+        buffers->output[i] = 0.f;
+    }
+    for (int i = 0; i <= 256; i++) {
+        buffers->table[i] = std::sin(2.f * (float)M_PI * i / 256.f);
+    }
+
+    double logScaleSum = 0.0;
+    float lowest = INFINITY;
+    float highest = 0.f;
+
+    for (int k = 0; k < NUM_KERNELS; k++) {
+        uint64_t fastestNs = UINT64_MAX;
+        for (int run = 0; run < KERNEL_RUNS; run++) {
+            uint64_t start = NTApi::readNanoseconds();
+            for (int pass = 0; pass < KERNEL_PASSES; pass++) {
+                g_kernelSink = KERNEL_DEFS[k].run(*buffers);
+            }
+            fastestNs = std::min(fastestNs, NTApi::readNanoseconds() - start);
+        }
+
+        KernelResult& result = kernels[k];
+        result.hostNsPerSample = std::max(1e-3f, (float)fastestNs / (KERNEL_PASSES * KERNEL_FRAMES));
+        float targetNsPerSample = (float)(result.targetCyclesPerSample / TARGET_CLOCK_HZ * 1e9);
+        result.scale = targetNsPerSample / result.hostNsPerSample;
+
+        logScaleSum += std::log(result.scale);
+        lowest = std::min(lowest, result.scale);
+        highest = std::max(highest, result.scale);
+        INFO("HardwareLoadEstimator: %s %.2f ns/sample on host, scale %.2f",
+             result.name, result.hostNsPerSample, result.scale);
+    }
+
+    scale = (float)std::exp(logScaleSum / NUM_KERNELS);
+    minScale = lowest;
+    maxScale = highest;
+    INFO("HardwareLoadEstimator: host-to-NT scale %.2f (%.2f - %.2f)", scale, minScale, maxScale);
+
+    calibrated.store(true, std::memory_order_release);
+    calibrating.store(false, std::memory_order_relaxed);
+}
+
+float HardwareLoadEstimator::estimatePercent(double hostNs, int numFrames, float sampleRate) const {
+    if (!isCalibrated() || numFrames <= 0 || sampleRate <= 0.f) return 0.f;
+
+    double budgetNs = numFrames * 1e9 / sampleRate;
+    return (float)(hostNs * scale / budgetNs * 100.0);
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <rack.hpp>
+#include <atomic>
+#include <thread>
+
+using namespace rack;
+
+/**
+ * HardwareLoadEstimator - Predicts disting NT CPU load from host step timings
+ *
+ * A small suite of reference DSP kernels is timed once on the host. Each
+ * kernel has a known cost on the NT's 600 MHz Cortex-M7, so the ratio gives
+ * a host-to-target scale factor; the geometric mean over the suite is
+ * applied to measured step() times to estimate the share of the per-block
+ * budget the plugin would use on the device.
+ *
+ * Calibration runs on a background thread the first time it is requested
+ * and is shared by all module instances.
+ */
+class HardwareLoadEstimator {
+public:
+    static constexpr double TARGET_CLOCK_HZ = 600e6;
+
+    struct KernelResult {
+        const char* name;
+        float targetCyclesPerSample;   // Reference cost on the Cortex-M7
+        float hostNsPerSample;         // Measured here
+        float scale;                   // Target ns / host ns
+    };
+    static constexpr int NUM_KERNELS = 4;
+
+    static HardwareLoadEstimator& getInstance();
+
+    // Starts calibration if it has not run yet; returns immediately
+    void requestCalibration();
+    bool isCalibrated() const { return calibrated.load(std::memory_order_acquire); }
+    bool isCalibrating() const { return calibrating.load(std::memory_order_relaxed); }
+
+    // Host-to-target time scale (geometric mean, and the suite's spread)
+    float getScale() const { return scale; }
+    float getMinScale() const { return minScale; }
+    float getMaxScale() const { return maxScale; }
+    const KernelResult& getKernelResult(int index) const { return kernels[index]; }
+
+    // Estimated percent of the NT block budget used by hostNs of step time
+    float estimatePercent(double hostNs, int numFrames, float sampleRate) const;
+
+private:
+    HardwareLoadEstimator();
+    ~HardwareLoadEstimator();
+    HardwareLoadEstimator(const HardwareLoadEstimator&) = delete;
+    HardwareLoadEstimator& operator=(const HardwareLoadEstimator&) = delete;
+
+    void calibrate();
+
+    std::thread calibrationThread;
+    std::atomic<bool> calibrating{false};
+    std::atomic<bool> calibrated{false};
+
+    // Written by the calibration thread before calibrated is released
+    KernelResult kernels[NUM_KERNELS];
+    float scale = 1.f;
+    float minScale = 1.f;
+    float maxScale = 1.f;
+};
@@ -0,0 +1,63 @@
+#include "MemoryArena.hpp"
+#include <cstdlib>
+
+#ifdef ARCH_WIN
+#include <malloc.h>
+#endif
+
+bool MemoryArena::acquire(size_t size, size_t alignment, Block& block) {
+    // Best fit among blocks that would be at least half used
+    int best = -1;
+    for (int i = 0; i < (int)blocks.size(); i++) {
+        const Block& candidate = blocks[i];
+        if (candidate.alignment != alignment || candidate.capacity < size || candidate.capacity / 2 > size) continue;
+        if (best < 0 || candidate.capacity < blocks[best].capacity) best = i;
+    }
+    if (best < 0) {
+        misses++;
+        return false;
+    }
+
+    block = blocks[best];
+    blocks[best] = blocks.back();
+    blocks.pop_back();
+    retainedBytes -= block.capacity;
+    hits++;
+    return true;
+}
+
+void MemoryArena::recycle(const Block& block) {
+    if (!block.data) return;
+    if (retainedBytes + block.capacity > MAX_RETAINED_BYTES) {
+        freeAligned(block.data);
+        return;
+    }
+    blocks.push_back(block);
+    retainedBytes += block.capacity;
+}
+
+void MemoryArena::trim() {
+    for (const Block& block : blocks) {
+        freeAligned(block.data);
+    }
+    blocks.clear();
+    retainedBytes = 0;
+}
+
+void* MemoryArena::allocateAligned(size_t size, size_t alignment) {
+    #ifdef ARCH_WIN
+        return _aligned_malloc(size, alignment);
+    #else
+        void* ptr = nullptr;
+        if (posix_memalign(&ptr, alignment, size) != 0) return nullptr;
+        return ptr;
+    #endif
+}
+
+void MemoryArena::freeAligned(void* ptr) {
+    #ifdef ARCH_WIN
+        _aligned_free(ptr);
+    #else
+        std::free(ptr);
+    #endif
+}
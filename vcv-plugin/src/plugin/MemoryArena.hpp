@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * MemoryArena - Keeps released algorithm memory blocks for the next construct
+ *
+ * Reloading a plugin or changing its specifications frees and reallocates
+ * every region. Recycling the blocks instead skips the allocator and, for
+ * large DRAM regions, the page faults of touching fresh memory, which is
+ * most of the cost when sweeping specifications. A retained block is
+ * reused for any request with the same alignment that fits in it without
+ * wasting more than half of it; blocks beyond MAX_RETAINED_BYTES are freed.
+ *
+ * Owned by one PluginManager and only used from the thread that loads
+ * plugins, so it needs no locking.
+ */
+class MemoryArena {
+public:
+    static constexpr size_t MAX_RETAINED_BYTES = 96 * 1024 * 1024;
+
+    struct Block {
+        void* data = nullptr;
+        size_t capacity = 0;
+        size_t alignment = 0;
+        bool hugePages = false;
+    };
+
+    MemoryArena() = default;
+    ~MemoryArena() { trim(); }
+
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    // Takes a retained block that fits `size`; returns false if none does
+    bool acquire(size_t size, size_t alignment, Block& block);
+    // Keeps the block for reuse, or frees it when the arena is full
+    void recycle(const Block& block);
+    void trim();
+
+    size_t getRetainedBytes() const { return retainedBytes; }
+    uint32_t getHits() const { return hits; }
+    uint32_t getMisses() const { return misses; }
+
+    static void* allocateAligned(size_t size, size_t alignment);
+    static void freeAligned(void* ptr);
+
+private:
+    std::vector<Block> blocks;
+    size_t retainedBytes = 0;
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+};
@@ -0,0 +1,204 @@
+#include "MemoryGuard.hpp"
+#include <cstring>
+
+#ifndef ARCH_WIN
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifndef ARCH_WIN
+namespace {
+    struct sigaction previousSegv;
+    struct sigaction previousBus;
+
+    size_t pageSize() {
+        static const size_t size = (size_t)sysconf(_SC_PAGESIZE);
+        return size;
+    }
+
+    size_t roundUp(size_t size, size_t alignment) {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    // The signal handler cannot use snprintf; build the report by hand
+    struct ReportBuffer {
+        char text[256];
+        size_t length = 0;
+
+        void append(const char* s) {
+            while (*s && length < sizeof(text) - 1) text[length++] = *s++;
+        }
+
+        void appendNumber(uint64_t value, int base = 10) {
+            char digits[24];
+            int count = 0;
+            do {
+                digits[count++] = "0123456789abcdef"[value % base];
+                value /= base;
+            } while (value && count < (int)sizeof(digits));
+            if (base == 16) append("0x");
+            while (count > 0 && length < sizeof(text) - 1) text[length++] = digits[--count];
+        }
+    };
+
+    void forward(int signal, siginfo_t* info, void* context) {
+        struct sigaction* previous = signal == SIGBUS ? &previousBus : &previousSegv;
+        if ((previous->sa_flags & SA_SIGINFO) && previous->sa_sigaction) {
+            previous->sa_sigaction(signal, info, context);
+        } else if (previous->sa_handler != SIG_DFL && previous->sa_handler != SIG_IGN) {
+            previous->sa_handler(signal);
+        } else {
+            // Returning re-executes the faulting access under the default action
+            sigaction(signal, previous, nullptr);
+        }
+    }
+}
+#endif
+
+MemoryGuard& MemoryGuard::getInstance() {
+    static MemoryGuard instance;
+    return instance;
+}
+
+bool MemoryGuard::isSupported() {
+    #ifdef ARCH_WIN
+        return false;
+    #else
+        return true;
+    #endif
+}
+
+void MemoryGuard::setReportPath(const std::string& path) {
+    std::strncpy(reportPath, path.c_str(), sizeof(reportPath) - 1);
+}
+
+void* MemoryGuard::allocate(size_t size, size_t alignment, const char* owner, const char* region) {
+    #ifdef ARCH_WIN
+        (void)size; (void)alignment; (void)owner; (void)region;
+        return nullptr;
+    #else
+        if (size == 0 || alignment > pageSize()) return nullptr;
+
+        Block* block = nullptr;
+        for (Block& candidate : blocks) {
+            if (!candidate.active.load(std::memory_order_relaxed)) {
+                block = &candidate;
+                break;
+            }
+        }
+        if (!block) return nullptr;
+
+        // [guard][data pages][guard], anonymous mappings come back zeroed
+        size_t page = pageSize();
+        size_t dataPages = roundUp(size, page);
+        size_t mappingSize = dataPages + 2 * page;
+        void* mapping = mmap(nullptr, mappingSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) return nullptr;
+
+        uint8_t* base = (uint8_t*)mapping;
+        if (mprotect(base + page, dataPages, PROT_READ | PROT_WRITE) != 0) {
+            munmap(mapping, mappingSize);
+            return nullptr;
+        }
+
+        installHandler();
+
+        block->mapping = base;
+        block->mappingSize = mappingSize;
+        block->data = base + page + dataPages - roundUp(size, alignment);
+        block->size = size;
+        std::strncpy(block->owner, owner ? owner : "Unknown", sizeof(block->owner) - 1);
+        std::strncpy(block->region, region ? region : "?", sizeof(block->region) - 1);
+        block->active.store(true, std::memory_order_release);
+        return block->data;
+    #endif
+}
+
+void MemoryGuard::release(void* data) {
+    #ifndef ARCH_WIN
+        for (Block& block : blocks) {
+            if (block.active.load(std::memory_order_relaxed) && block.data == data) {
+                block.active.store(false, std::memory_order_release);
+                munmap(block.mapping, block.mappingSize);
+                return;
+            }
+        }
+    #else
+        (void)data;
+    #endif
+}
+
+void MemoryGuard::installHandler() {
+    #ifndef ARCH_WIN
+        if (handlerInstalled) return;
+        handlerInstalled = true;
+
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_sigaction = [](int signal, siginfo_t* info, void* context) {
+            MemoryGuard::handleSignal(signal, info, context);
+        };
+        action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGSEGV, &action, &previousSegv);
+        sigaction(SIGBUS, &action, &previousBus);
+    #endif
+}
+
+void MemoryGuard::handleSignal(int signal, void* info, void* context) {
+    #ifndef ARCH_WIN
+        siginfo_t* signalInfo = (siginfo_t*)info;
+        getInstance().report((uintptr_t)signalInfo->si_addr);
+        forward(signal, signalInfo, context);
+    #else
+        (void)signal; (void)info; (void)context;
+    #endif
+}
+
+bool MemoryGuard::report(uintptr_t address) const {
+    #ifndef ARCH_WIN
+        for (const Block& block : blocks) {
+            if (!block.active.load(std::memory_order_acquire)) continue;
+            uintptr_t start = (uintptr_t)block.mapping;
+            if (address < start || address >= start + block.mappingSize) continue;
+
+            uintptr_t data = (uintptr_t)block.data;
+            ReportBuffer buffer;
+            buffer.append("NtEmu guarded memory: ");
+            buffer.append(block.owner);
+            if (address >= data + block.size) {
+                buffer.append(" overran ");
+                buffer.append(block.region);
+                buffer.append(" at offset ");
+                buffer.appendNumber(address - data);
+                buffer.append(" (region size ");
+            } else {
+                buffer.append(" underran ");
+                buffer.append(block.region);
+                buffer.append(" by ");
+                buffer.appendNumber(data - address);
+                buffer.append(" bytes (region size ");
+            }
+            buffer.appendNumber(block.size);
+            buffer.append("), address ");
+            buffer.appendNumber(address, 16);
+            buffer.append("\n");
+
+            ssize_t written = write(STDERR_FILENO, buffer.text, buffer.length);
+            if (reportPath[0]) {
+                int fd = open(reportPath, O_WRONLY | O_CREAT | O_APPEND, 0644);
+                if (fd >= 0) {
+                    written = write(fd, buffer.text, buffer.length);
+                    close(fd);
+                }
+            }
+            (void)written;
+            return true;
+        }
+    #else
+        (void)address;
+    #endif
+    return false;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * MemoryGuard - Guard-page backed allocations for algorithm memory regions
+ *
+ * Each block gets its own mapping with an inaccessible page on either side.
+ * The block is placed against the trailing guard page, so running off the
+ * end of a region faults on the first byte past it (rounded up to the cache
+ * line) instead of corrupting whatever was allocated next. A SIGSEGV/SIGBUS
+ * handler recognises faults inside a guard page, reports the owning
+ * algorithm, region and offset to stderr and the report file, then hands
+ * the signal on to the previous handler so the host still crashes normally.
+ *
+ * Protection is done by the MMU, so guarded regions cost nothing on the
+ * audio path. POSIX only; on Windows allocate() always fails.
+ */
+class MemoryGuard {
+public:
+    static constexpr int MAX_BLOCKS = 64;
+
+    static MemoryGuard& getInstance();
+
+    static bool isSupported();
+
+    // Returns a zeroed block aligned to `alignment` (at most one page), or nullptr
+    void* allocate(size_t size, size_t alignment, const char* owner, const char* region);
+    void release(void* data);
+
+    // Reports are appended here as well as written to stderr
+    void setReportPath(const std::string& path);
+
+private:
+    struct Block {
+        std::atomic<bool> active{false};
+        uint8_t* mapping = nullptr;
+        size_t mappingSize = 0;
+        uint8_t* data = nullptr;
+        size_t size = 0;
+        char owner[48] = {};
+        char region[8] = {};
+    };
+
+    MemoryGuard() = default;
+    void installHandler();
+    static void handleSignal(int signal, void* info, void* context);
+    bool report(uintptr_t address) const;
+
+    Block blocks[MAX_BLOCKS];
+    char reportPath[512] = {};
+    bool handlerInstalled = false;
+};
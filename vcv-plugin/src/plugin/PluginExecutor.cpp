@@ -1,7 +1,12 @@
 #include "PluginExecutor.hpp"
 #include "PluginManager.hpp"
+#include "HardwareLoadEstimator.hpp"
+#include "../dsp/BusSystem.hpp"
+#include "../log/RtLog.hpp"
 #include <rack.hpp>
 #include <atomic>
+#include <algorithm>
+#include <cstring>
 
 using namespace rack;
 
@@ -17,12 +22,145 @@ void PluginExecutor::safeStep(float* buses, int numFrames) {
     
     if (!factory->step) return;
     
+    PluginProfiler::Scope timing(&profiler, 0, ProfileSite::Step);
     safeExecute("step", [&]() {
         factory->step(algorithm, buses, numFrames);
     });
 }
 
+void PluginExecutor::safeStepChain(float* buses, int numFrames) {
+    forEachChainSlot("step", ProfileSite::Step, [&](AlgorithmSlot& slot) {
+        if (slot.factory->step) {
+            slot.factory->step(slot.algorithm, buses, numFrames);
+        }
+    });
+}
+
+bool PluginExecutor::safeStepBlock(float* buses, int numFramesBy4, bool realtime) {
+    int numFloats = BusSystem::NUM_BUSES * numFramesBy4 * 4;
+    ExecutionTryLock lock(executionMutex, std::defer_lock);
+    if (!realtime) {
+        lock.lock();
+    } else if (!lock.try_lock()) {
+        // draw() or a UI call is inside the plugin: repeat the last block
+        // rather than stall the engine thread behind it
+        if (lastBlockFloats == numFloats) {
+            memcpy(buses, lastBlockBuses, numFloats * sizeof(float));
+        }
+        lockMisses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // A hot-swapped build takes over between blocks
+    if (pluginManager->getHotSwapState() == PluginManager::HOT_SWAP_READY) {
+        pluginManager->commitHotSwap();
+    }
+    PluginManager::Crossfade* crossfade = pluginManager->acquireCrossfade();
+    if (crossfade) {
+        // The outgoing build gets its own copy of the inputs
+        memcpy(crossfadeBuses, buses, numFloats * sizeof(float));
+    }
+    
+    // Only the plugin's own step() calls count towards the block's load: the
+    // swap commit and the outgoing build's crossfade step have no NT equivalent
+    uint64_t start = NTApi::readNanoseconds();
+    safeStep(buses, numFramesBy4);
+    uint64_t stepNs = NTApi::readNanoseconds() - start;
+    if (crossfade) {
+        stepCrossfade(*crossfade, buses, numFramesBy4);
+    }
+    pluginManager->releaseCrossfade();
+    start = NTApi::readNanoseconds();
+    safeStepChain(buses, numFramesBy4);
+    stepNs += NTApi::readNanoseconds() - start;
+    profiler.record(0, ProfileSite::BlockStep, stepNs);
+    blockCount.fetch_add(1, std::memory_order_relaxed);
+    
+    if (hardwareLoadEstimate.load(std::memory_order_relaxed)) {
+        trackHardwareLoad(stepNs, numFramesBy4 * 4);
+    }
+    
+    memcpy(lastBlockBuses, buses, numFloats * sizeof(float));
+    lastBlockFloats = numFloats;
+    return true;
+}
+
+void PluginExecutor::stepCrossfade(PluginManager::Crossfade& crossfade, float* buses, int numFramesBy4) {
+    int numFrames = numFramesBy4 * 4;
+    NTApi::ScopedContext apiScope(apiContext);
+    try {
+        crossfade.factory->step(crossfade.algorithm, crossfadeBuses, numFramesBy4);
+    } catch (...) {
+        // Nothing to fade from; the new build's output stands
+        RT_WARN(Plugin, "Outgoing build threw during the hot swap crossfade");
+        pluginManager->endCrossfade();
+        return;
+    }
+    
+    // Linear ramp from the old build's buses to the new one's, per frame
+    float step = 1.f / crossfade.length;
+    for (int bus = 0; bus < BusSystem::NUM_BUSES; bus++) {
+        float* incoming = buses + bus * numFrames;
+        const float* outgoing = crossfadeBuses + bus * numFrames;
+        float gain = crossfade.position * step;
+        for (int frame = 0; frame < numFrames; frame++) {
+            float g = std::min(gain, 1.f);
+            incoming[frame] = outgoing[frame] + (incoming[frame] - outgoing[frame]) * g;
+            gain += step;
+        }
+    }
+    
+    crossfade.position += numFrames;
+    if (crossfade.position >= crossfade.length) {
+        pluginManager->endCrossfade();
+    }
+}
+
+void PluginExecutor::setHardwareLoadEstimate(bool enabled) {
+    if (enabled) {
+        HardwareLoadEstimator::getInstance().requestCalibration();
+    }
+    hardwareLoadEstimate.store(enabled);
+}
+
+PluginExecutor::HardwareLoadStats PluginExecutor::getHardwareLoadStats() const {
+    HardwareLoadStats stats;
+    stats.lastPercent = lastLoadPercent.load(std::memory_order_relaxed);
+    stats.peakPercent = peakLoadPercent.load(std::memory_order_relaxed);
+    
+    const HardwareLoadEstimator& estimator = HardwareLoadEstimator::getInstance();
+    int numFrames = lastLoadFrames.load(std::memory_order_relaxed);
+    if (estimator.isCalibrated() && numFrames > 0) {
+        PluginProfiler::Summary summary = profiler.summarize(0, ProfileSite::BlockStep);
+        float sampleRate = apiContext ? (float)apiContext->globals.sampleRate : 48000.f;
+        stats.meanPercent = estimator.estimatePercent(summary.meanUs * 1e3, numFrames, sampleRate);
+        stats.p99Percent = estimator.estimatePercent(summary.p99Us * 1e3, numFrames, sampleRate);
+        stats.windowBlocks = summary.samples;
+    }
+    return stats;
+}
+
+void PluginExecutor::resetHardwareLoadStats() {
+    lastLoadPercent.store(0.f);
+    peakLoadPercent.store(0.f);
+}
+
+void PluginExecutor::trackHardwareLoad(uint64_t stepNs, int numFrames) {
+    const HardwareLoadEstimator& estimator = HardwareLoadEstimator::getInstance();
+    if (!estimator.isCalibrated()) return;
+    
+    // Single blocks are only reported; host preemption makes them too noisy
+    // to warn on. The warning comes from the window's p99 instead.
+    float sampleRate = apiContext ? (float)apiContext->globals.sampleRate : 48000.f;
+    float percent = estimator.estimatePercent((double)stepNs, numFrames, sampleRate);
+    lastLoadPercent.store(percent, std::memory_order_relaxed);
+    lastLoadFrames.store(numFrames, std::memory_order_relaxed);
+    if (percent > peakLoadPercent.load(std::memory_order_relaxed)) {
+        peakLoadPercent.store(percent, std::memory_order_relaxed);
+    }
+}
+
 void PluginExecutor::safeMidiMessage(uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    ExecutionLock lock(executionMutex);
     if (!checkPluginPointers()) return;
     
     _NT_factory* factory = pluginManager->getFactory();
@@ -30,12 +168,23 @@ void PluginExecutor::safeMidiMessage(uint8_t byte0, uint8_t byte1, uint8_t byte2
     
     if (!factory->midiMessage) return;
     
-    safeExecute("midiMessage", [&]() {
-        factory->midiMessage(algorithm, byte0, byte1, byte2);
+    {
+        PluginProfiler::Scope timing(&profiler, 0, ProfileSite::MidiMessage);
+        safeExecute("midiMessage", [&]() {
+            factory->midiMessage(algorithm, byte0, byte1, byte2);
+        });
+    }
+    
+    // Like the hardware, every algorithm in the chain sees incoming MIDI
+    forEachChainSlot("midiMessage", ProfileSite::MidiMessage, [&](AlgorithmSlot& slot) {
+        if (slot.factory->midiMessage) {
+            slot.factory->midiMessage(slot.algorithm, byte0, byte1, byte2);
+        }
     });
 }
 
 void PluginExecutor::safeMidiRealtime(uint8_t byte) {
+    ExecutionLock lock(executionMutex);
     if (!checkPluginPointers()) return;
     
     _NT_factory* factory = pluginManager->getFactory();
@@ -43,12 +192,22 @@ void PluginExecutor::safeMidiRealtime(uint8_t byte) {
     
     if (!factory->midiRealtime) return;
     
-    safeExecute("midiRealtime", [&]() {
-        factory->midiRealtime(algorithm, byte);
+    {
+        PluginProfiler::Scope timing(&profiler, 0, ProfileSite::MidiRealtime);
+        safeExecute("midiRealtime", [&]() {
+            factory->midiRealtime(algorithm, byte);
+        });
+    }
+    
+    forEachChainSlot("midiRealtime", ProfileSite::MidiRealtime, [&](AlgorithmSlot& slot) {
+        if (slot.factory->midiRealtime) {
+            slot.factory->midiRealtime(slot.algorithm, byte);
+        }
     });
 }
 
 void PluginExecutor::safeMidiSysEx(const uint8_t* data, uint32_t count) {
+    ExecutionLock lock(executionMutex);
     if (!checkPluginPointers() || !data || count == 0) return;
 
     _NT_factory* factory = pluginManager->getFactory();
@@ -61,6 +220,7 @@ void PluginExecutor::safeMidiSysEx(const uint8_t* data, uint32_t count) {
 }
 
 void PluginExecutor::safeParameterChanged(int paramIndex) {
+    ExecutionLock lock(executionMutex);
     if (!checkPluginPointers()) return;
     
     _NT_factory* factory = pluginManager->getFactory();
@@ -68,12 +228,38 @@ void PluginExecutor::safeParameterChanged(int paramIndex) {
     
     if (!factory->parameterChanged) return;
     
+    PluginProfiler::Scope timing(&profiler, 0, ProfileSite::ParameterChanged);
     safeExecute("parameterChanged", [&]() {
         factory->parameterChanged(algorithm, paramIndex);
     });
 }
 
+void PluginExecutor::safeSlotParameterChanged(int slot, int paramIndex) {
+    if (!isPluginValid()) return;
+    
+    // UI thread: wait for the audio thread rather than dropping the change.
+    // Calls made from inside a chained slot already hold the lock.
+    std::unique_lock<std::mutex> lock(pluginManager->getSlotMutex(), std::defer_lock);
+    if (NTApi::getCurrentAlgorithmIndex() == 0) {
+        lock.lock();
+    }
+    AlgorithmSlot* algorithmSlot = pluginManager->getSlot(slot);
+    if (!algorithmSlot || !algorithmSlot->algorithm || !algorithmSlot->factory->parameterChanged) return;
+    
+    NTApi::ScopedContext apiScope(apiContext);
+    NTApi::ScopedAlgorithmIndex indexScope(slot);
+    PluginProfiler::Scope timing(&profiler, slot, ProfileSite::ParameterChanged);
+    try {
+        algorithmSlot->factory->parameterChanged(algorithmSlot->algorithm, paramIndex);
+    } catch (const std::exception& e) {
+        handleSlotException("parameterChanged", slot, e.what());
+    } catch (...) {
+        handleSlotException("parameterChanged", slot, "unknown error");
+    }
+}
+
 bool PluginExecutor::safeDraw() {
+    ExecutionLock lock(executionMutex);
     if (!checkPluginPointers()) return false;
     
     _NT_factory* factory = pluginManager->getFactory();
@@ -81,6 +267,7 @@ bool PluginExecutor::safeDraw() {
     
     if (!factory->draw) return false;
     
+    PluginProfiler::Scope timing(&profiler, 0, ProfileSite::Draw);
     return safeExecuteWithReturn<bool>("draw", [&]() -> bool {
         return factory->draw(algorithm);
     }, false);
@@ -107,6 +294,10 @@ void PluginExecutor::updateErrorTimer(float deltaTime) {
     }
 }
 
+bool PluginExecutor::hasDraw() const {
+    return checkPluginPointers() && pluginManager->getFactory()->draw != nullptr;
+}
+
 bool PluginExecutor::isPluginValid() const {
     return pluginManager && pluginManager->isLoaded() && checkPluginPointers();
 }
@@ -134,6 +325,13 @@ void PluginExecutor::handleException(const char* context, const char* error) {
     }
 }
 
+void PluginExecutor::handleSlotException(const char* context, int slot, const char* error) {
+    // A failing chained slot is disabled rather than unloading the whole module
+    errorStats.totalErrors++;
+    incrementErrorCounter(context);
+    RT_WARN(Plugin, "Algorithm %d error in %s: %s (slot disabled)", slot, context, error);
+}
+
 void PluginExecutor::incrementErrorCounter(const char* context) {
     if (strcmp(context, "step") == 0) {
         errorStats.stepErrors++;
@@ -165,15 +363,14 @@ bool PluginExecutor::isAudioContext() const {
 }
 
 void PluginExecutor::rtSafeLog(const char* context, const char* error) {
-    // Real-time safe logging - use atomic operations where possible
-    // and avoid dynamic allocation
+    // Real-time safe logging - records go through the RtLog ring and are
+    // written to the Rack log by its drain thread
     
     static std::atomic<uint32_t> logCounter{0};
     uint32_t count = logCounter.fetch_add(1);
     
     // Only log first few errors to avoid spam
     if (count < 10) {
-        // VCV Rack's INFO should be relatively safe
-        INFO("Plugin RT error #%u in %s: %s", count, context, error);
+        RT_WARN(Plugin, "Plugin RT error #%u in %s: %s", count, context, error);
     }
 }
\ No newline at end of file
@@ -2,21 +2,41 @@
 #include <rack.hpp>
 #include <functional>
 #include "../nt_api_interface.h"
+#include "../api/NTApiContext.hpp"
+#include "PluginManager.hpp"
+#include "PluginProfiler.hpp"
+#include "../dsp/BusSystem.hpp"
+#include <atomic>
+#include <mutex>
 
 using namespace rack;
 
-// Forward declaration
-class PluginManager;
-
 // Safe plugin execution wrapper with comprehensive error handling
 class PluginExecutor {
 public:
     PluginExecutor(PluginManager* manager);
     ~PluginExecutor() = default;
     
+    // NT API context installed around every plugin call
+    void setApiContext(NTApiContext* context) { apiContext = context; }
+    
     // Audio processing - most critical, must be real-time safe
     void safeStep(float* buses, int numFrames);
     
+    // Steps chained slots 1..N in order on the same buses (after slot 0)
+    void safeStepChain(float* buses, int numFrames);
+    
+    // Whole block: slot 0, then the chain. Their combined step() time is
+    // recorded as ProfileSite::BlockStep and feeds the hardware load estimate.
+    // With realtime set (engine thread) it never waits for the execution
+    // lock: if draw() or a UI call holds it, the previous block's buses are
+    // repeated, the miss is counted and false is returned.
+    bool safeStepBlock(float* buses, int numFramesBy4, bool realtime);
+    // Blocks repeated because the execution lock was busy
+    uint32_t getLockMisses() const { return lockMisses.load(std::memory_order_relaxed); }
+    // safeStepBlock() calls so far, for lining display frames up with audio
+    uint64_t getBlockCount() const { return blockCount.load(std::memory_order_relaxed); }
+    
     // MIDI handling
     void safeMidiMessage(uint8_t byte0, uint8_t byte1, uint8_t byte2);
     void safeMidiRealtime(uint8_t byte);
@@ -24,9 +44,11 @@ public:
 
     // Parameter handling
     void safeParameterChanged(int paramIndex);
+    void safeSlotParameterChanged(int slot, int paramIndex);
     
-    // Display rendering
+    // Display rendering (called from the DisplayScheduler thread)
     bool safeDraw();
+    bool hasDraw() const;
     
     // State persistence
     bool safeSerialise(uint8_t* buffer, uint32_t bufferSize, uint32_t* bytesWritten);
@@ -39,6 +61,7 @@ public:
             return;
         }
         
+        NTApi::ScopedContext apiScope(apiContext);
         try {
             func();
         } catch (const std::exception& e) {
@@ -55,6 +78,7 @@ public:
             return defaultReturn;
         }
         
+        NTApi::ScopedContext apiScope(apiContext);
         try {
             return func();
         } catch (const std::exception& e) {
@@ -85,9 +109,56 @@ public:
     // Plugin validation
     bool isPluginValid() const;
     
+    // Held around step, draw, MIDI and parameterChanged so that draw() on the
+    // display thread never overlaps the others. Recursive because plugins call
+    // back into the emulator (NT_setParameterFromUi) from inside a callback.
+    // Take it around any other call into the plugin made off the UI thread.
+    // The engine thread must not wait on it: use ExecutionTryLock with
+    // std::try_to_lock there and skip the call when owns_lock() is false.
+    typedef std::lock_guard<std::recursive_mutex> ExecutionLock;
+    typedef std::unique_lock<std::recursive_mutex> ExecutionTryLock;
+    std::recursive_mutex& getExecutionMutex() { return executionMutex; }
+    
+    // Call timings for step/draw/parameterChanged/midiMessage per slot
+    PluginProfiler& getProfiler() { return profiler; }
+    
+    // Disting NT load estimate from the block's step() time (see HardwareLoadEstimator).
+    // mean and p99 cover the profiler's rolling window of blocks.
+    struct HardwareLoadStats {
+        float lastPercent = 0.f;
+        float peakPercent = 0.f;
+        float meanPercent = 0.f;
+        float p99Percent = 0.f;
+        uint32_t windowBlocks = 0;
+    };
+    void setHardwareLoadEstimate(bool enabled);
+    bool isHardwareLoadEstimate() const { return hardwareLoadEstimate.load(); }
+    HardwareLoadStats getHardwareLoadStats() const;
+    void resetHardwareLoadStats();
+    
 private:
     PluginManager* pluginManager;
+    NTApiContext* apiContext = nullptr;
+    std::recursive_mutex executionMutex;
     ErrorStats errorStats;
+    PluginProfiler profiler;
+    
+    // Hardware load tracking (written by the audio or worker thread)
+    std::atomic<bool> hardwareLoadEstimate{false};
+    std::atomic<float> lastLoadPercent{0.f};
+    std::atomic<float> peakLoadPercent{0.f};
+    std::atomic<int> lastLoadFrames{0};
+    std::atomic<uint64_t> blockCount{0};
+    std::atomic<uint32_t> lockMisses{0};
+    
+    // Last block's buses, replayed when the engine thread can't take the lock
+    alignas(16) float lastBlockBuses[BusSystem::NUM_BUSES * BusSystem::MAX_BLOCK_FRAMES];
+    int lastBlockFloats = 0;
+    void trackHardwareLoad(uint64_t stepNs, int numFrames);
+    
+    // Hot swap crossfade: the outgoing build runs on a copy of the buses
+    alignas(16) float crossfadeBuses[BusSystem::NUM_BUSES * BusSystem::MAX_BLOCK_FRAMES];
+    void stepCrossfade(PluginManager::Crossfade& crossfade, float* buses, int numFramesBy4);
     
     // Exception handling
     void handleException(const char* context, const char* error);
@@ -99,4 +170,33 @@ private:
     
     // Real-time safe logging (minimal allocation)
     void rtSafeLog(const char* context, const char* error);
+    
+    // Calls func(slot) for each healthy chained slot with NT_algorithmIndex
+    // set to its position. Skipped entirely while the UI edits the chain.
+    template<typename Func>
+    void forEachChainSlot(const char* context, ProfileSite site, Func&& func) {
+        if (!isPluginValid()) return;
+        
+        std::unique_lock<std::mutex> lock(pluginManager->getSlotMutex(), std::try_to_lock);
+        if (!lock.owns_lock() || pluginManager->getSlotCountLocked() < 2) return;
+        
+        NTApi::ScopedContext apiScope(apiContext);
+        for (int index = 1; index < pluginManager->getSlotCountLocked(); index++) {
+            AlgorithmSlot* slot = pluginManager->getSlot(index);
+            if (!slot || !slot->algorithm || slot->faulted.load(std::memory_order_relaxed)) continue;
+            
+            NTApi::ScopedAlgorithmIndex indexScope(index);
+            PluginProfiler::Scope timing(&profiler, index, site);
+            try {
+                func(*slot);
+            } catch (const std::exception& e) {
+                slot->faulted.store(true);
+                handleSlotException(context, index, e.what());
+            } catch (...) {
+                slot->faulted.store(true);
+                handleSlotException(context, index, "unknown error");
+            }
+        }
+    }
+    void handleSlotException(const char* context, int slot, const char* error);
 };
\ No newline at end of file
@@ -2,9 +2,11 @@
 #include "PluginManager.hpp"
 #include "../parameter/ParameterSystem.hpp"
 #include "../json_bridge.h"
+#include "MemoryGuard.hpp"
+#include "../api/NTApiContext.hpp"
 #include <rack.hpp>
-#include <thread>
 #include <chrono>
+#include <stdexcept>
 
 using namespace rack;
 
@@ -15,49 +17,25 @@ extern uint8_t NT_screen[128 * 64];
 #include "../json_bridge.h"
 
 PluginManager::PluginManager() {
+    MemoryGuard::getInstance().setReportPath(asset::user("nt_emu_memory_faults.txt"));
+    pluginMemory.setArena(&memoryArena);
     INFO("PluginManager initialized");
 }
 
 PluginManager::~PluginManager() {
+    clearSlots();
     unloadPlugin();
 }
 
 bool PluginManager::loadPlugin(const std::string& path) {
     INFO("PluginManager::loadPlugin called with path: %s", path.c_str());
+    auto loadStart = std::chrono::steady_clock::now();
     try {
         unloadPlugin();
         
-        // Platform-specific loading
-        #ifdef ARCH_WIN
-            pluginHandle = LoadLibraryA(path.c_str());
-        #else
-            // First, ensure our own symbols are globally available
-            // Get path to our own plugin
-            Dl_info info;
-            if (dladdr((void*)&NT_screen, &info) && info.dli_fname) {
-                INFO("Our plugin path: %s", info.dli_fname);
-                // Reopen our own plugin with RTLD_GLOBAL to export symbols
-                void* ourHandle = dlopen(info.dli_fname, RTLD_NOW | RTLD_GLOBAL);
-                INFO("Reopened our plugin with RTLD_GLOBAL: %p", ourHandle);
-            } else {
-                INFO("Could not determine our plugin path");
-            }
-            
-            // Check if we can find our own symbol now
-            void* testSymbol = dlsym(RTLD_DEFAULT, "_NT_screen");
-            INFO("Found _NT_screen symbol: %p", testSymbol);
-            
-            pluginHandle = dlopen(path.c_str(), RTLD_NOW | RTLD_GLOBAL);
-        #endif
-        
+        std::string error;
+        pluginHandle = openLibrary(path, error);
         if (!pluginHandle) {
-            std::string error;
-            #ifdef ARCH_WIN
-                error = "Windows error"; // GetLastError() formatting
-            #else
-                const char* dlerr = dlerror();
-                error = dlerr ? std::string(dlerr) : "Unknown error";
-            #endif
             WARN("Failed to load plugin from path '%s': %s", path.c_str(), error.c_str());
             loadingMessage = "Error: Failed to load plugin - " + error;
             loadingMessageTimer = 4.0f;
@@ -65,50 +43,15 @@ bool PluginManager::loadPlugin(const std::string& path) {
             return false;
         }
         
-        // Try new API first (pluginEntry)
-        typedef uintptr_t (*PluginEntryFunc)(_NT_selector selector, uint32_t data);
-        PluginEntryFunc pluginEntry;
-        #ifdef ARCH_WIN
-            pluginEntry = (PluginEntryFunc)GetProcAddress((HMODULE)pluginHandle, "pluginEntry");
-        #else
-            pluginEntry = (PluginEntryFunc)dlsym(pluginHandle, "pluginEntry");
-        #endif
-        
-        if (!pluginEntry) {
-            // Fall back to legacy API
-            typedef _NT_factory* (*LegacyFactoryFunc)();
-            LegacyFactoryFunc legacyFactory;
-            #ifdef ARCH_WIN
-                legacyFactory = (LegacyFactoryFunc)GetProcAddress((HMODULE)pluginHandle, "NT_factory");
-            #else
-                legacyFactory = (LegacyFactoryFunc)dlsym(pluginHandle, "NT_factory");
-            #endif
-            
-            if (!legacyFactory) {
-                WARN("Plugin '%s' does not export pluginEntry or NT_factory function", path.c_str());
-                loadingMessage = "Error: Plugin missing required functions";
-                loadingMessageTimer = 4.0f;
-                unloadPlugin();
-                notifyError("Plugin '" + path + "' does not export pluginEntry or NT_factory function");
-                return false;
-            }
-            
-            pluginFactory = legacyFactory();
-        } else {
-            // Check API version before proceeding
-            uint32_t pluginVersion = (uint32_t)pluginEntry(kNT_selector_version, 0);
-            INFO("PluginManager: Plugin API version: %u (emu supports up to %u)", pluginVersion, (uint32_t)kNT_apiVersionCurrent);
-            if (pluginVersion > (uint32_t)kNT_apiVersionCurrent) {
-                WARN("Plugin requires API v%u but emu only supports up to v%u", pluginVersion, (uint32_t)kNT_apiVersionCurrent);
-                loadingMessage = "Error: Plugin requires newer API (v" + std::to_string(pluginVersion) + ")";
-                loadingMessageTimer = 4.0f;
-                unloadPlugin();
-                notifyError("Plugin requires API v" + std::to_string(pluginVersion) + " but emu only supports up to v" + std::to_string((uint32_t)kNT_apiVersionCurrent));
-                return false;
-            }
-
-            // Use new API
-            pluginFactory = (_NT_factory*)pluginEntry(kNT_selector_factoryInfo, 0);
+        // A null factory with no error is left to validatePlugin()
+        pluginFactory = findFactory(pluginHandle, error);
+        if (!error.empty()) {
+            WARN("Plugin '%s': %s", path.c_str(), error.c_str());
+            loadingMessage = "Error: " + error;
+            loadingMessageTimer = 4.0f;
+            unloadPlugin();
+            notifyError("Plugin '" + path + "': " + error);
+            return false;
         }
 
         if (!validatePlugin()) {
@@ -122,14 +65,17 @@ bool PluginManager::loadPlugin(const std::string& path) {
         }
         
         pluginPath = path;
-        loadingMessage = "Plugin loaded successfully";
-        loadingMessageTimer = 2.0f;
         
         // NOTE: setupUi should only be called when exiting parameter menu or on initial load
         // The module (NtEmu) will handle calling setupUi with actual pot values after load completes
         
         notifyLoaded();
-        INFO("Successfully loaded plugin: %s", path.c_str());
+        
+        lastLoadMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+        loadingMessage = string::f("Plugin loaded (%.1f ms)", lastLoadMs);
+        loadingMessageTimer = 2.0f;
+        INFO("Successfully loaded plugin: %s in %.2f ms (arena %u hits, %u misses)", path.c_str(), lastLoadMs,
+             memoryArena.getHits(), memoryArena.getMisses());
         return true;
         
     } catch (const std::exception& e) {
@@ -172,20 +118,13 @@ bool PluginManager::loadPlugin(const std::string& path, const std::vector<int32_
 void PluginManager::unloadPlugin() {
     INFO("Unloading plugin");
     
+    cancelHotSwap();
     cleanupPlugin();
     
     pluginAlgorithm = nullptr;
     pluginFactory = nullptr;
     
-    if (pluginInstanceMemory) {
-        std::free(pluginInstanceMemory);
-        pluginInstanceMemory = nullptr;
-    }
-    
-    if (pluginSharedMemory) {
-        std::free(pluginSharedMemory);
-        pluginSharedMemory = nullptr;
-    }
+    pluginMemory.release();
     
     if (pluginHandle) {
         #ifdef ARCH_WIN
@@ -195,9 +134,14 @@ void PluginManager::unloadPlugin() {
         #endif
         pluginHandle = nullptr;
     }
+    if (!pluginShadowPath.empty()) {
+        system::remove(pluginShadowPath);
+        pluginShadowPath.clear();
+    }
     
     pluginPath.clear();
     pluginSpecifications.clear();
+    pluginNumParameters = 0;
     
     notifyUnloaded();
 }
@@ -211,27 +155,523 @@ void PluginManager::reloadPlugin() {
     std::string currentPath = pluginPath;
     std::vector<int32_t> currentSpecs = pluginSpecifications;
     
-    unloadPlugin();
-    
-    // Small delay to allow system to fully unload the library
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    
+    // loadPlugin() unloads the current instance first; dlclose() is synchronous,
+    // and the instance memory goes back to the arena for the new construct.
     // Reload with same specifications if they exist
     if (!currentSpecs.empty()) {
         if (loadPlugin(currentPath, currentSpecs)) {
-            INFO("Successfully reloaded plugin with specifications");
+            INFO("Successfully reloaded plugin with specifications in %.2f ms", lastLoadMs);
         } else {
             WARN("Failed to reload plugin with specifications");
         }
     } else {
         if (loadPlugin(currentPath)) {
-            INFO("Successfully reloaded plugin");
+            INFO("Successfully reloaded plugin in %.2f ms", lastLoadMs);
         } else {
             WARN("Failed to reload plugin");
         }
     }
 }
 
+bool PluginManager::beginHotSwap(NTApiContext* context, const int16_t* values, float crossfadeMs) {
+    if (!isLoaded() || pluginPath.empty() || getHotSwapState() != HOT_SWAP_IDLE) {
+        return false;
+    }
+    if (hotSwapThread.joinable()) {
+        hotSwapThread.join();
+    }
+    
+    staged.reset(new StagedPlugin());
+    staged->specifications = pluginSpecifications;
+    for (int r = 0; r < (int)MemoryRegion::Count; r++) {
+        // The running build's memory is replaced, not added to
+        MemoryRegion region = (MemoryRegion)r;
+        staged->regionUsage[r] = getRegionUsage(region) - pluginMemory.getSize(region);
+    }
+    
+    // A fresh file name so the loader maps the rebuilt library instead of
+    // returning the handle of the one already open at the same path
+    std::string directory = asset::user("nt_emu_hotswap");
+    system::createDirectories(directory);
+    staged->shadowPath = system::join(directory, string::f("%u-%s", ++hotSwapCount, system::getFilename(pluginPath).c_str()));
+    
+    float sampleRate = context ? (float)context->globals.sampleRate : 48000.f;
+    crossfadeFrames = (int)(crossfadeMs * sampleRate / 1000.f);
+    
+    INFO("PluginManager: Hot swapping %s via %s", pluginPath.c_str(), staged->shadowPath.c_str());
+    loadingMessage = "Hot swapping...";
+    loadingMessageTimer = 2.0f;
+    staged->values = values;
+    hotSwapState.store(HOT_SWAP_PREPARING, std::memory_order_release);
+    hotSwapThread = std::thread(&PluginManager::prepareHotSwap, this);
+    return true;
+}
+
+void PluginManager::prepareHotSwap() {
+    // Background thread: nothing here touches the running build or the
+    // module. The new build gets its parameter values here, so the audio
+    // thread only has to swap pointers in commitHotSwap().
+    auto prepareStart = std::chrono::steady_clock::now();
+    StagedPlugin& next = *staged;
+    
+    try {
+        if (!system::copy(pluginPath, next.shadowPath)) {
+            throw std::runtime_error("could not copy " + pluginPath);
+        }
+        
+        #ifdef ARCH_WIN
+            next.handle = LoadLibraryA(next.shadowPath.c_str());
+        #else
+            // Local, and bound to its own symbols first, so nothing in the new
+            // build resolves to the copy of it that is still running
+            int flags = RTLD_NOW | RTLD_LOCAL;
+            #ifdef RTLD_DEEPBIND
+                flags |= RTLD_DEEPBIND;
+            #endif
+            next.handle = dlopen(next.shadowPath.c_str(), flags);
+        #endif
+        if (!next.handle) {
+            #ifdef ARCH_WIN
+                throw std::runtime_error("failed to load the rebuilt plugin");
+            #else
+                const char* dlerr = dlerror();
+                throw std::runtime_error(dlerr ? dlerr : "failed to load the rebuilt plugin");
+            #endif
+        }
+        
+        std::string factoryError;
+        next.factory = findFactory(next.handle, factoryError);
+        if (!next.factory || !next.factory->construct) {
+            throw std::runtime_error(factoryError.empty() ? "rebuilt plugin has no usable factory" : factoryError);
+        }
+        
+        // Same specifications as the running instance; a different set means
+        // the preset no longer fits and needs a full reload
+        const int32_t* specs = nullptr;
+        if (next.factory->numSpecifications > 0 && next.factory->specifications) {
+            if (next.specifications.size() != next.factory->numSpecifications) {
+                next.layoutChanged = true;
+                throw std::runtime_error("specifications changed");
+            }
+            specs = next.specifications.data();
+        } else if (!next.specifications.empty()) {
+            next.layoutChanged = true;
+            throw std::runtime_error("specifications changed");
+        }
+        
+        _NT_algorithmRequirements reqs;
+        memset(&reqs, 0, sizeof(reqs));
+        if (next.factory->calculateRequirements) {
+            next.factory->calculateRequirements(reqs, specs);
+        }
+        if (reqs.numParameters != pluginNumParameters) {
+            next.layoutChanged = true;
+            throw std::runtime_error(string::f("parameter count changed (%u to %u)", pluginNumParameters, reqs.numParameters));
+        }
+        
+        std::string memoryError;
+        if (!allocateAlgorithmMemory(next.memory, reqs, next.factory->name ? next.factory->name : "Unknown",
+                                     memoryError, next.regionUsage)) {
+            throw std::runtime_error(memoryError);
+        }
+        
+        // No module context: callbacks made while constructing and setting
+        // up go nowhere, and the module re-reads the new build's parameter
+        // definitions once it has switched (onPluginHotSwapped)
+        NTApi::ScopedContext apiScope(nullptr);
+        next.algorithm = next.factory->construct(next.memory.getPointers(), reqs, specs);
+        if (!next.algorithm || !isValidPointer(next.algorithm)) {
+            next.algorithm = nullptr;
+            throw std::runtime_error("failed to construct algorithm");
+        }
+        next.numParameters = reqs.numParameters;
+        
+        // Carry the current parameter values over, as extractParameterData()
+        // does with the defaults on a cold load
+        next.algorithm->v = next.values;
+        if (next.factory->parameterChanged) {
+            try {
+                for (uint32_t i = 0; i < next.numParameters; i++) {
+                    next.factory->parameterChanged(next.algorithm, i);
+                }
+            } catch (...) {
+                throw std::runtime_error("rebuilt plugin threw in parameterChanged");
+            }
+        }
+    } catch (const std::exception& e) {
+        next.error = e.what();
+    } catch (...) {
+        next.error = "unknown exception while constructing the rebuilt plugin";
+    }
+    
+    next.prepareMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - prepareStart).count();
+    hotSwapState.store(next.error.empty() ? HOT_SWAP_READY : HOT_SWAP_FAILED, std::memory_order_release);
+}
+
+void PluginManager::commitHotSwap() {
+    // Audio thread: pointer swaps only. Claiming the switch first keeps a
+    // concurrent cancelHotSwap() from freeing the builds halfway through it.
+    int expected = HOT_SWAP_READY;
+    if (!hotSwapState.compare_exchange_strong(expected, HOT_SWAP_COMMITTING, std::memory_order_acq_rel)) {
+        return;
+    }
+    StagedPlugin& next = *staged;
+    
+    // `staged` holds the outgoing build from here on
+    std::swap(pluginHandle, next.handle);
+    std::swap(pluginFactory, next.factory);
+    std::swap(pluginAlgorithm, next.algorithm);
+    pluginMemory.swap(next.memory);
+    
+    if (crossfadeFrames > 0 && next.factory->step) {
+        crossfade.factory = next.factory;
+        crossfade.algorithm = next.algorithm;
+        crossfade.length = crossfadeFrames;
+        crossfade.position = 0;
+        hotSwapState.store(HOT_SWAP_CROSSFADING, std::memory_order_release);
+    } else {
+        hotSwapState.store(HOT_SWAP_DONE, std::memory_order_release);
+    }
+}
+
+PluginManager::HotSwapResult PluginManager::updateHotSwap() {
+    int state = getHotSwapState();
+    if (state != HOT_SWAP_DONE && state != HOT_SWAP_FAILED) {
+        return HotSwapResult::None;
+    }
+    if (hotSwapThread.joinable()) {
+        hotSwapThread.join();
+    }
+    
+    if (state == HOT_SWAP_FAILED) {
+        bool layoutChanged = staged->layoutChanged;
+        std::string error = staged->error;
+        releaseStaged();
+        hotSwapState.store(HOT_SWAP_IDLE, std::memory_order_release);
+        
+        if (layoutChanged) {
+            INFO("PluginManager: Hot swap needs a full reload: %s", error.c_str());
+            return HotSwapResult::NeedsColdReload;
+        }
+        WARN("PluginManager: Hot swap failed, keeping the running build: %s", error.c_str());
+        loadingMessage = "Error: Hot swap failed - " + error;
+        loadingMessageTimer = 4.0f;
+        notifyError("Hot swap of '" + pluginPath + "' failed: " + error);
+        return HotSwapResult::Failed;
+    }
+    
+    // DONE means no further block will reach the old build; wait out the
+    // one that may still be returning from its last crossfade step
+    waitForCrossfadeRelease();
+    
+    // The new build's shadow copy replaces the old one, which goes with it
+    std::swap(pluginShadowPath, staged->shadowPath);
+    lastLoadMs = staged->prepareMs;
+    
+    // Observers re-read parameter names and pages from the new build before
+    // the old one, which they still point into, is closed
+    notifyHotSwapped();
+    releaseStaged();
+    hotSwapState.store(HOT_SWAP_IDLE, std::memory_order_release);
+    
+    loadingMessage = string::f("Plugin hot-swapped (%.1f ms)", lastLoadMs);
+    loadingMessageTimer = 2.0f;
+    INFO("PluginManager: Hot swapped %s, prepared in %.2f ms", pluginPath.c_str(), lastLoadMs);
+    return HotSwapResult::Swapped;
+}
+
+void PluginManager::cancelHotSwap() {
+    if (!staged && !hotSwapThread.joinable()) return;
+    
+    if (hotSwapThread.joinable()) {
+        hotSwapThread.join();
+    }
+    
+    // Stop the audio thread switching to or fading from the staged build
+    // before it goes away: a switch in progress is waited out (pointer swaps
+    // only), then IDLE keeps any later block away from the staged build
+    int state = hotSwapState.load();
+    for (;;) {
+        if (state == HOT_SWAP_COMMITTING) {
+            std::this_thread::yield();
+            state = hotSwapState.load();
+        } else if (hotSwapState.compare_exchange_weak(state, HOT_SWAP_IDLE)) {
+            break;
+        }
+    }
+    waitForCrossfadeRelease();
+    releaseStaged();
+    INFO("PluginManager: Hot swap cancelled");
+}
+
+void PluginManager::waitForCrossfadeRelease() {
+    // At most one crossfade step; the audio thread never waits on us
+    while (crossfadeInUse.load()) {
+        std::this_thread::yield();
+    }
+}
+
+void PluginManager::releaseStaged() {
+    // UI thread, after the audio thread has let go (see updateHotSwap() and
+    // cancelHotSwap()): dlclose() and the frees take no lock it uses
+    if (!staged) return;
+    staged->algorithm = nullptr;
+    staged->factory = nullptr;
+    staged->memory.release();
+    if (staged->handle) {
+        #ifdef ARCH_WIN
+            FreeLibrary((HMODULE)staged->handle);
+        #else
+            dlclose(staged->handle);
+        #endif
+    }
+    if (!staged->shadowPath.empty()) {
+        system::remove(staged->shadowPath);
+    }
+    staged.reset();
+}
+
+std::unique_ptr<AlgorithmSlot> PluginManager::createSlot(const std::string& path, const std::vector<int32_t>& specifications) {
+    if (!isLoaded()) {
+        WARN("PluginManager: Load a primary plugin before chaining algorithms");
+        return nullptr;
+    }
+    if (getSlotCount() >= MAX_SLOTS) {
+        WARN("PluginManager: Algorithm chain is full (%d slots)", MAX_SLOTS);
+        return nullptr;
+    }
+    
+    std::unique_ptr<AlgorithmSlot> slot(new AlgorithmSlot());
+    slot->path = path;
+    slot->memory.setArena(&memoryArena);
+    
+    std::string error;
+    slot->handle = openLibrary(path, error);
+    if (!slot->handle) {
+        WARN("PluginManager: Failed to load chained algorithm '%s': %s", path.c_str(), error.c_str());
+        notifyError("Failed to load '" + path + "': " + error);
+        return nullptr;
+    }
+    
+    try {
+        slot->factory = findFactory(slot->handle, error);
+        if (!slot->factory || !slot->factory->construct) {
+            WARN("PluginManager: '%s' has no usable factory", path.c_str());
+            notifyError("Chained algorithm '" + path + "' has no usable factory" + (error.empty() ? "" : ": " + error));
+            destroySlot(slot.get());
+            return nullptr;
+        }
+        
+        const int32_t* specs = nullptr;
+        if (slot->factory->numSpecifications > 0 && slot->factory->specifications) {
+            slot->specifications = specifications;
+            slot->specifications.resize(slot->factory->numSpecifications);
+            for (uint32_t i = specifications.size(); i < slot->factory->numSpecifications; i++) {
+                slot->specifications[i] = slot->factory->specifications[i].def;
+            }
+            specs = slot->specifications.data();
+        }
+        
+        slot->algorithm = constructAlgorithm(slot->factory, specs, slot->memory, slot->numParameters, error);
+        if (!slot->algorithm) {
+            notifyError("Chained algorithm '" + path + "': " + error);
+            destroySlot(slot.get());
+            return nullptr;
+        }
+    } catch (...) {
+        WARN("PluginManager: Exception while constructing chained algorithm '%s'", path.c_str());
+        notifyError("Exception while constructing chained algorithm '" + path + "'");
+        destroySlot(slot.get());
+        return nullptr;
+    }
+    return slot;
+}
+
+int PluginManager::addSlot(std::unique_ptr<AlgorithmSlot> slot) {
+    std::lock_guard<std::mutex> lock(slotMutex);
+    if (!slot || 1 + (int)chainSlots.size() >= MAX_SLOTS) {
+        if (slot) destroySlot(slot.get());
+        return -1;
+    }
+    slot->id = ++nextSlotId;
+    chainSlots.push_back(std::move(slot));
+    int index = (int)chainSlots.size();
+    INFO("PluginManager: Chained '%s' as algorithm %d", chainSlots.back()->getName(), index);
+    return index;
+}
+
+void PluginManager::removeSlot(int slot) {
+    std::unique_ptr<AlgorithmSlot> removed;
+    {
+        std::lock_guard<std::mutex> lock(slotMutex);
+        if (slot < 1 || slot > (int)chainSlots.size()) return;
+        removed = std::move(chainSlots[slot - 1]);
+        chainSlots.erase(chainSlots.begin() + (slot - 1));
+    }
+    // The audio thread can no longer reach it; free outside the lock
+    INFO("PluginManager: Removing chained algorithm %d (%s)", slot, removed->getName());
+    destroySlot(removed.get());
+}
+
+void PluginManager::clearSlots() {
+    while (getSlotCount() > 1) {
+        removeSlot(getSlotCount() - 1);
+    }
+}
+
+int PluginManager::getSlotCount() const {
+    std::lock_guard<std::mutex> lock(slotMutex);
+    return 1 + (int)chainSlots.size();
+}
+
+int PluginManager::findSlot(uint32_t id) const {
+    std::lock_guard<std::mutex> lock(slotMutex);
+    for (size_t i = 0; i < chainSlots.size(); i++) {
+        if (chainSlots[i]->id == id) return (int)i + 1;
+    }
+    return -1;
+}
+
+AlgorithmSlot* PluginManager::getSlot(int slot) const {
+    if (slot < 1 || slot > (int)chainSlots.size()) return nullptr;
+    return chainSlots[slot - 1].get();
+}
+
+void PluginManager::destroySlot(AlgorithmSlot* slot) {
+    slot->algorithm = nullptr;
+    slot->factory = nullptr;
+    slot->memory.release();
+    if (slot->handle) {
+        #ifdef ARCH_WIN
+            FreeLibrary((HMODULE)slot->handle);
+        #else
+            dlclose(slot->handle);
+        #endif
+        slot->handle = nullptr;
+    }
+}
+
+void* PluginManager::openLibrary(const std::string& path, std::string& error) {
+    void* handle = nullptr;
+    #ifdef ARCH_WIN
+        handle = LoadLibraryA(path.c_str());
+        if (!handle) {
+            error = "Windows error"; // GetLastError() formatting
+        }
+    #else
+        // First, ensure our own symbols are globally available
+        Dl_info info;
+        if (dladdr((void*)&NT_screen, &info) && info.dli_fname) {
+            // Reopen our own plugin with RTLD_GLOBAL to export symbols
+            void* ourHandle = dlopen(info.dli_fname, RTLD_NOW | RTLD_GLOBAL);
+            INFO("Reopened our plugin (%s) with RTLD_GLOBAL: %p", info.dli_fname, ourHandle);
+        } else {
+            INFO("Could not determine our plugin path");
+        }
+        
+        handle = dlopen(path.c_str(), RTLD_NOW | RTLD_GLOBAL);
+        if (!handle) {
+            const char* dlerr = dlerror();
+            error = dlerr ? std::string(dlerr) : "Unknown error";
+        }
+    #endif
+    return handle;
+}
+
+_NT_factory* PluginManager::findFactory(void* handle, std::string& error) {
+    typedef uintptr_t (*PluginEntryFunc)(_NT_selector selector, uint32_t data);
+    typedef _NT_factory* (*LegacyFactoryFunc)();
+    #ifdef ARCH_WIN
+        PluginEntryFunc pluginEntry = (PluginEntryFunc)GetProcAddress((HMODULE)handle, "pluginEntry");
+        LegacyFactoryFunc legacyFactory = (LegacyFactoryFunc)GetProcAddress((HMODULE)handle, "NT_factory");
+    #else
+        PluginEntryFunc pluginEntry = (PluginEntryFunc)dlsym(handle, "pluginEntry");
+        LegacyFactoryFunc legacyFactory = (LegacyFactoryFunc)dlsym(handle, "NT_factory");
+    #endif
+    
+    if (pluginEntry) {
+        // Check API version before proceeding
+        uint32_t pluginVersion = (uint32_t)pluginEntry(kNT_selector_version, 0);
+        INFO("PluginManager: Plugin API version: %u (emu supports up to %u)", pluginVersion, (uint32_t)kNT_apiVersionCurrent);
+        if (pluginVersion > (uint32_t)kNT_apiVersionCurrent) {
+            error = "Plugin requires API v" + std::to_string(pluginVersion) + " but emu only supports up to v" +
+                    std::to_string((uint32_t)kNT_apiVersionCurrent);
+            return nullptr;
+        }
+        return (_NT_factory*)pluginEntry(kNT_selector_factoryInfo, 0);
+    }
+    if (!legacyFactory) {
+        error = "does not export pluginEntry or NT_factory function";
+        return nullptr;
+    }
+    return legacyFactory();
+}
+
+_NT_algorithm* PluginManager::constructAlgorithm(_NT_factory* factory, const int32_t* specs, AlgorithmMemory& memory,
+                                                 uint32_t& numParameters, std::string& error,
+                                                 const uint32_t* regionUsage) {
+    _NT_algorithmRequirements reqs;
+    memset(&reqs, 0, sizeof(reqs));
+    if (factory->calculateRequirements) {
+        factory->calculateRequirements(reqs, specs);
+    }
+    numParameters = reqs.numParameters;
+    
+    // Separate, aligned SRAM/DRAM/DTC/ITC blocks, checked against the NT's sizes
+    if (!allocateAlgorithmMemory(memory, reqs, factory->name ? factory->name : "Unknown", error, regionUsage)) {
+        return nullptr;
+    }
+    
+    _NT_algorithm* algorithm = factory->construct(memory.getPointers(), reqs, specs);
+    if (!algorithm || !isValidPointer(algorithm)) {
+        error = "Failed to construct algorithm";
+        return nullptr;
+    }
+    return algorithm;
+}
+
+uint32_t PluginManager::getRegionUsage(MemoryRegion region) const {
+    std::lock_guard<std::mutex> lock(slotMutex);
+    uint32_t total = pluginMemory.getSize(region);
+    for (const auto& slot : chainSlots) {
+        total += slot->memory.getSize(region);
+    }
+    return total;
+}
+
+bool PluginManager::allocateAlgorithmMemory(AlgorithmMemory& memory, const _NT_algorithmRequirements& reqs,
+                                            const std::string& name, std::string& error,
+                                            const uint32_t* regionUsage) {
+    // The regions are shared by every algorithm in the preset, as on the device
+    for (int r = 0; r < (int)MemoryRegion::Count; r++) {
+        MemoryRegion region = (MemoryRegion)r;
+        uint32_t requested = AlgorithmMemory::getRequested(reqs, region);
+        uint32_t limit = AlgorithmMemory::getRegionLimit(region);
+        uint32_t used = regionUsage ? regionUsage[r] : getRegionUsage(region);
+        if (requested == 0 || (uint64_t)used + requested <= limit) continue;
+        
+        error = string::f("%s needs %u bytes of %s but only %u of %u are free on the NT",
+                          name.c_str(), requested, AlgorithmMemory::getRegionName(region),
+                          used < limit ? limit - used : 0, limit);
+        if (enforceMemoryLimits) {
+            WARN("PluginManager: %s", error.c_str());
+            return false;
+        }
+        WARN("PluginManager: %s (limit not enforced)", error.c_str());
+    }
+    
+    if (!memory.allocate(reqs, error, name.c_str(), guardedMemory)) {
+        WARN("PluginManager: %s", error.c_str());
+        return false;
+    }
+    INFO("PluginManager: %s memory SRAM %u, DRAM %u%s, DTC %u, ITC %u bytes%s", name.c_str(),
+         memory.getSize(MemoryRegion::SRAM), memory.getSize(MemoryRegion::DRAM),
+         memory.isHugePageBacked() ? " (huge pages)" : "",
+         memory.getSize(MemoryRegion::DTC), memory.getSize(MemoryRegion::ITC),
+         memory.isGuarded() ? ", guarded" : "");
+    return true;
+}
+
 bool PluginManager::isLoaded() const {
     return pluginHandle && pluginFactory && pluginAlgorithm;
 }
@@ -274,12 +714,6 @@ bool PluginManager::validatePlugin() {
 
 bool PluginManager::initializePlugin() {
     try {
-        // Calculate memory requirements
-        _NT_staticRequirements staticReqs;
-        _NT_algorithmRequirements algorithmReqs;
-        memset(&staticReqs, 0, sizeof(staticReqs));
-        memset(&algorithmReqs, 0, sizeof(algorithmReqs));
-        
         // Get specifications for requirement calculation
         std::vector<int32_t> specValues;
         const int32_t* specifications = nullptr;
@@ -299,41 +733,12 @@ bool PluginManager::initializePlugin() {
             specifications = specValues.data();
         }
         
-        // Calculate requirements
-        if (pluginFactory->calculateRequirements) {
-            pluginFactory->calculateRequirements(algorithmReqs, specifications);
-        }
-        
-        // For now, create a simple memory allocation strategy
-        // In a full implementation, we'd allocate separate SRAM, DRAM, DTC, ITC regions
-        uint32_t totalMemoryNeeded = algorithmReqs.sram + algorithmReqs.dram + algorithmReqs.dtc + algorithmReqs.itc;
-        
-        if (totalMemoryNeeded > 0) {
-            pluginInstanceMemory = std::malloc(totalMemoryNeeded);
-            if (!pluginInstanceMemory) {
-                loadingMessage = "Error: Failed to allocate instance memory";
-                loadingMessageTimer = 4.0f;
-                notifyError("Failed to allocate instance memory");
-                return false;
-            }
-            memset(pluginInstanceMemory, 0, totalMemoryNeeded);
-            
-            // TODO: Implement proper memory region allocation for SRAM, DRAM, DTC, ITC
-        }
-        
-        // Construct algorithm with proper memory pointers structure
-        _NT_algorithmMemoryPtrs memoryPtrs;
-        uint8_t* basePtr = (uint8_t*)pluginInstanceMemory;
-        memoryPtrs.sram = basePtr;
-        memoryPtrs.dram = basePtr + algorithmReqs.sram;
-        memoryPtrs.dtc = basePtr + algorithmReqs.sram + algorithmReqs.dram; 
-        memoryPtrs.itc = basePtr + algorithmReqs.sram + algorithmReqs.dram + algorithmReqs.dtc;
-        
-        pluginAlgorithm = pluginFactory->construct(memoryPtrs, algorithmReqs, specifications);
-        if (!pluginAlgorithm || !isValidPointer(pluginAlgorithm)) {
-            loadingMessage = "Error: Failed to construct algorithm";
+        std::string error;
+        pluginAlgorithm = constructAlgorithm(pluginFactory, specifications, pluginMemory, pluginNumParameters, error);
+        if (!pluginAlgorithm) {
+            loadingMessage = "Error: " + error;
             loadingMessageTimer = 4.0f;
-            notifyError("Failed to construct algorithm");
+            notifyError(error);
             return false;
         }
         
@@ -385,6 +790,12 @@ void PluginManager::notifyError(const std::string& error) {
     }
 }
 
+void PluginManager::notifyHotSwapped() {
+    for (auto* observer : observers) {
+        observer->onPluginHotSwapped();
+    }
+}
+
 bool PluginManager::isValidPointer(void* ptr) const {
     if (!ptr) return false;
     
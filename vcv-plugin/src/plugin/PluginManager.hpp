@@ -3,7 +3,13 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
 #include "../nt_api_interface.h"
+#include "AlgorithmSlot.hpp"
+#include "AlgorithmMemory.hpp"
 
 #ifdef ARCH_WIN
 #include <windows.h>
@@ -20,8 +26,12 @@ public:
     virtual void onPluginLoaded(const std::string& path) = 0;
     virtual void onPluginUnloaded() = 0;
     virtual void onPluginError(const std::string& error) = 0;
+    // A rebuilt plugin replaced the running one; parameter values were kept
+    virtual void onPluginHotSwapped() {}
 };
 
+struct NTApiContext;
+
 // Plugin management system extracted from DistingNT
 class PluginManager {
 public:
@@ -38,11 +48,95 @@ public:
     // Plugin access
     _NT_factory* getFactory() const { return pluginFactory; }
     _NT_algorithm* getAlgorithm() const { return pluginAlgorithm; }
-    void* getSharedMemory() const { return pluginSharedMemory; }
-    void* getInstanceMemory() const { return pluginInstanceMemory; }
+    const AlgorithmMemory& getMemory() const { return pluginMemory; }
+    const MemoryArena& getMemoryArena() const { return memoryArena; }
     const std::string& getPluginPath() const { return pluginPath; }
     const std::vector<int32_t>& getSpecifications() const { return pluginSpecifications; }
     
+    // Algorithm chain. Slot 0 is the primary plugin above; slots 1..N are
+    // built with createSlot(), set up by the caller (parameter values), then
+    // published with addSlot() and stepped after it within the same block.
+    static constexpr int MAX_SLOTS = 8;
+    std::unique_ptr<AlgorithmSlot> createSlot(const std::string& path, const std::vector<int32_t>& specifications = {});
+    int addSlot(std::unique_ptr<AlgorithmSlot> slot);
+    void removeSlot(int slot);
+    void clearSlots();
+    int getSlotCount() const;
+    int getSlotCountLocked() const { return 1 + (int)chainSlots.size(); }  // Caller holds getSlotMutex()
+    AlgorithmSlot* getSlot(int slot) const;
+    int findSlot(uint32_t id) const;    // Current position of a slot, or -1 once removed
+    
+    // Held by the UI thread while the chain changes; the audio thread only
+    // try-locks it and skips the chained slots for that block if busy
+    std::mutex& getSlotMutex() { return slotMutex; }
+    
+    // Instance memory summed over every slot, against the NT's region sizes.
+    // Takes slotMutex, so never call it with the lock held.
+    // Over-limit requests are logged; when enforced they fail to load instead.
+    uint32_t getRegionUsage(MemoryRegion region) const;
+    void setEnforceMemoryLimits(bool enforce) { enforceMemoryLimits = enforce; }
+    bool isEnforceMemoryLimits() const { return enforceMemoryLimits; }
+    
+    // Guard pages around every region (see MemoryGuard); applies from the next load
+    void setGuardedMemory(bool enabled) { guardedMemory = enabled; }
+    bool isGuardedMemory() const { return guardedMemory; }
+    
+    // Hot swap. The rebuilt library is copied, opened and constructed on a
+    // background thread while the current build keeps running, and given the
+    // parameter values in `values` there. The audio thread switches builds at
+    // a block boundary with pointer swaps only, optionally crossfading from
+    // the old one for `crossfadeMs`, and updateHotSwap() unloads the old
+    // build on the UI thread once the audio thread has let go of it. No lock
+    // is shared with the audio thread; the handover is hotSwapState alone.
+    enum HotSwapState : int {
+        HOT_SWAP_IDLE,
+        HOT_SWAP_PREPARING,     // Background thread is building the new instance
+        HOT_SWAP_READY,         // Waiting for the audio thread to switch
+        HOT_SWAP_COMMITTING,    // Audio thread is switching
+        HOT_SWAP_CROSSFADING,   // Switched; the old build still runs for the fade
+        HOT_SWAP_DONE,          // Audio thread no longer uses the old build
+        HOT_SWAP_FAILED
+    };
+    enum class HotSwapResult {
+        None,
+        Swapped,
+        Failed,
+        NeedsColdReload         // Parameters or specifications changed shape
+    };
+    bool beginHotSwap(NTApiContext* context, const int16_t* values, float crossfadeMs);
+    int getHotSwapState() const { return hotSwapState.load(std::memory_order_acquire); }
+    bool isHotSwapping() const { return getHotSwapState() != HOT_SWAP_IDLE; }
+    HotSwapResult updateHotSwap();
+    
+    // Audio thread, between blocks
+    struct Crossfade {
+        _NT_factory* factory = nullptr;     // Outgoing build
+        _NT_algorithm* algorithm = nullptr;
+        int length = 0;                     // Frames
+        int position = 0;
+    };
+    void commitHotSwap();
+    // The outgoing build to fade from this block, or nullptr. Call
+    // releaseCrossfade() once the block is done with it; until then the UI
+    // thread won't free it.
+    Crossfade* acquireCrossfade() {
+        // Pairs with waitForCrossfadeRelease(): either the UI sees the flag
+        // or we see the state it left
+        crossfadeInUse.store(true);
+        if (hotSwapState.load() == HOT_SWAP_CROSSFADING) {
+            return &crossfade;
+        }
+        crossfadeInUse.store(false);
+        return nullptr;
+    }
+    void releaseCrossfade() {
+        crossfadeInUse.store(false);
+    }
+    void endCrossfade() {
+        int expected = HOT_SWAP_CROSSFADING;
+        hotSwapState.compare_exchange_strong(expected, HOT_SWAP_DONE, std::memory_order_acq_rel);
+    }
+    
     // Observer pattern
     void addObserver(IPluginStateObserver* observer);
     void removeObserver(IPluginStateObserver* observer);
@@ -52,6 +146,10 @@ public:
     float getLoadingMessageTimer() const { return loadingMessageTimer; }
     void updateLoadingTimer(float deltaTime);
     
+    // Wall time of the last successful load or reload, including unloading
+    // the previous instance and notifying observers
+    float getLastLoadMs() const { return lastLoadMs; }
+    
     // Safe execution wrapper
     template<typename Func>
     void safeExecute(Func&& func, const char* context) {
@@ -79,19 +177,53 @@ private:
     void* pluginHandle = nullptr;
     _NT_factory* pluginFactory = nullptr;
     _NT_algorithm* pluginAlgorithm = nullptr;
-    void* pluginSharedMemory = nullptr;
-    void* pluginInstanceMemory = nullptr;
+    MemoryArena memoryArena;   // Declared first so it outlives every AlgorithmMemory
+    AlgorithmMemory pluginMemory;
     std::string pluginPath;
+    std::string pluginShadowPath;   // Copy the running build was opened from after a hot swap
     std::string lastPluginFolder;
+    uint32_t pluginNumParameters = 0;
     
     // Plugin specifications
     std::vector<int32_t> currentSpecifications;
     bool useCustomSpecifications = false;
     std::vector<int32_t> pluginSpecifications;
     
+    // Chained algorithm slots (slot index = position + 1)
+    std::vector<std::unique_ptr<AlgorithmSlot>> chainSlots;
+    mutable std::mutex slotMutex;
+    uint32_t nextSlotId = 0;
+    bool enforceMemoryLimits = false;
+    bool guardedMemory = false;
+    
+    // Hot swap. `staged` holds the incoming build until the audio thread
+    // switches, then the outgoing one until updateHotSwap() releases it.
+    struct StagedPlugin {
+        void* handle = nullptr;
+        _NT_factory* factory = nullptr;
+        _NT_algorithm* algorithm = nullptr;
+        AlgorithmMemory memory;     // No arena: allocated off the UI thread
+        const int16_t* values = nullptr;
+        uint32_t numParameters = 0;
+        std::string shadowPath;
+        std::vector<int32_t> specifications;
+        uint32_t regionUsage[(int)MemoryRegion::Count] = {};   // Chained slots' usage
+        std::string error;
+        bool layoutChanged = false;
+        float prepareMs = 0.f;
+    };
+    std::unique_ptr<StagedPlugin> staged;
+    std::thread hotSwapThread;
+    std::atomic<int> hotSwapState{HOT_SWAP_IDLE};
+    Crossfade crossfade;
+    std::atomic<bool> crossfadeInUse{false};
+    int crossfadeFrames = 0;
+    uint32_t hotSwapCount = 0;
+    
     // Status
     std::string loadingMessage;
     float loadingMessageTimer = 0.f;
+    float lastLoadMs = 0.f;
     
     // Observers
     std::vector<IPluginStateObserver*> observers;
@@ -100,9 +232,23 @@ private:
     bool validatePlugin();
     bool initializePlugin();
     void cleanupPlugin();
+    void destroySlot(AlgorithmSlot* slot);
+    static void* openLibrary(const std::string& path, std::string& error);
+    static _NT_factory* findFactory(void* handle, std::string& error);
+    _NT_algorithm* constructAlgorithm(_NT_factory* factory, const int32_t* specs, AlgorithmMemory& memory,
+                                      uint32_t& numParameters, std::string& error,
+                                      const uint32_t* regionUsage = nullptr);
+    bool allocateAlgorithmMemory(AlgorithmMemory& memory, const _NT_algorithmRequirements& reqs,
+                                 const std::string& name, std::string& error,
+                                 const uint32_t* regionUsage = nullptr);
+    void prepareHotSwap();
+    void cancelHotSwap();
+    void waitForCrossfadeRelease();
+    void releaseStaged();
     void notifyLoaded();
     void notifyUnloaded();
     void notifyError(const std::string& error);
+    void notifyHotSwapped();
     
     // Pointer validation helper
     bool isValidPointer(void* ptr) const;
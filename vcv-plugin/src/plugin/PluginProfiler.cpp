@@ -0,0 +1,82 @@
+#include "PluginProfiler.hpp"
+#include <algorithm>
+
+void PluginProfiler::record(int slot, ProfileSite site, uint64_t elapsedNs) {
+    if (slot < 0 || slot >= MAX_SLOTS) return;
+
+    Window& window = windows[slot][(int)site];
+    uint32_t index = window.writeIndex.fetch_add(1, std::memory_order_relaxed);
+    window.durationsNs[index & (WINDOW - 1)].store(elapsedNs, std::memory_order_relaxed);
+}
+
+PluginProfiler::Summary PluginProfiler::summarize(int slot, ProfileSite site) const {
+    Summary summary;
+    if (slot < 0 || slot >= MAX_SLOTS) return summary;
+
+    const Window& window = windows[slot][(int)site];
+    summary.calls = window.writeIndex.load(std::memory_order_relaxed);
+    summary.samples = std::min<uint32_t>(summary.calls, WINDOW);
+    if (summary.samples == 0) return summary;
+
+    uint64_t snapshot[WINDOW];
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < summary.samples; i++) {
+        snapshot[i] = window.durationsNs[i].load(std::memory_order_relaxed);
+        total += snapshot[i];
+    }
+
+    uint64_t* end = snapshot + summary.samples;
+    uint64_t* p99 = snapshot + (summary.samples - 1) * 99 / 100;
+    std::nth_element(snapshot, p99, end);
+
+    summary.minUs = *std::min_element(snapshot, end) * 1e-3f;
+    summary.maxUs = *std::max_element(snapshot, end) * 1e-3f;
+    summary.meanUs = (float)total / summary.samples * 1e-3f;
+    summary.p99Us = *p99 * 1e-3f;
+    return summary;
+}
+
+void PluginProfiler::reset() {
+    for (auto& slotWindows : windows) {
+        for (Window& window : slotWindows) {
+            window.writeIndex.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+json_t* PluginProfiler::toJson() const {
+    json_t* sitesJ = json_array();
+    for (int slot = 0; slot < MAX_SLOTS; slot++) {
+        for (int s = 0; s < (int)ProfileSite::Count; s++) {
+            Summary summary = summarize(slot, (ProfileSite)s);
+            if (summary.samples == 0) continue;
+
+            json_t* siteJ = json_object();
+            json_object_set_new(siteJ, "slot", json_integer(slot));
+            json_object_set_new(siteJ, "site", json_string(getSiteName((ProfileSite)s)));
+            json_object_set_new(siteJ, "calls", json_integer(summary.calls));
+            json_object_set_new(siteJ, "window", json_integer(summary.samples));
+            json_object_set_new(siteJ, "minUs", json_real(summary.minUs));
+            json_object_set_new(siteJ, "meanUs", json_real(summary.meanUs));
+            json_object_set_new(siteJ, "p99Us", json_real(summary.p99Us));
+            json_object_set_new(siteJ, "maxUs", json_real(summary.maxUs));
+            json_array_append_new(sitesJ, siteJ);
+        }
+    }
+
+    json_t* rootJ = json_object();
+    json_object_set_new(rootJ, "sites", sitesJ);
+    return rootJ;
+}
+
+const char* PluginProfiler::getSiteName(ProfileSite site) {
+    switch (site) {
+        case ProfileSite::Step: return "step";
+        case ProfileSite::Draw: return "draw";
+        case ProfileSite::ParameterChanged: return "parameterChanged";
+        case ProfileSite::MidiMessage: return "midiMessage";
+        case ProfileSite::MidiRealtime: return "midiRealtime";
+        case ProfileSite::BlockStep: return "blockStep";
+        default: return "unknown";
+    }
+}
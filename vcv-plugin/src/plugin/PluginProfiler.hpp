@@ -0,0 +1,80 @@
+#pragma once
+#include <rack.hpp>
+#include <atomic>
+#include <cstdint>
+#include "../api/CycleCounter.hpp"
+#include "PluginManager.hpp"
+
+using namespace rack;
+
+// Plugin entry points timed by PluginExecutor
+enum class ProfileSite {
+    Step,
+    Draw,
+    ParameterChanged,
+    MidiMessage,
+    MidiRealtime,
+    BlockStep,      // step() over the whole chain for one block, recorded on slot 0
+    Count
+};
+
+/**
+ * PluginProfiler - Rolling call timings per algorithm slot and entry point
+ *
+ * Each (slot, site) pair keeps the last WINDOW durations in a ring that any
+ * thread may append to without locking. Statistics are computed on demand
+ * from a snapshot of the ring, so the audio thread only pays for two clock
+ * reads and one store per call.
+ */
+class PluginProfiler {
+public:
+    static constexpr int WINDOW = 512;  // Power of two
+    static constexpr int MAX_SLOTS = PluginManager::MAX_SLOTS;
+
+    struct Summary {
+        uint32_t calls = 0;     // Total since reset
+        uint32_t samples = 0;   // In the rolling window
+        float minUs = 0.f;
+        float meanUs = 0.f;
+        float p99Us = 0.f;
+        float maxUs = 0.f;
+    };
+
+    // Times one call; records on destruction
+    class Scope {
+    public:
+        Scope(PluginProfiler* profiler, int slot, ProfileSite site)
+            : profiler(profiler), slot(slot), site(site), start(NTApi::readNanoseconds()) {}
+        ~Scope() {
+            if (profiler) {
+                profiler->record(slot, site, NTApi::readNanoseconds() - start);
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        PluginProfiler* profiler;
+        int slot;
+        ProfileSite site;
+        uint64_t start;
+    };
+
+    void record(int slot, ProfileSite site, uint64_t elapsedNs);
+    Summary summarize(int slot, ProfileSite site) const;
+    void reset();
+
+    // {"sites": [{"slot", "site", "calls", "minUs", "meanUs", "p99Us", "maxUs"}, ...]}
+    json_t* toJson() const;
+
+    static const char* getSiteName(ProfileSite site);
+
+private:
+    struct Window {
+        std::atomic<uint32_t> writeIndex{0};
+        std::atomic<uint64_t> durationsNs[WINDOW] = {};
+    };
+
+    Window windows[MAX_SLOTS][(int)ProfileSite::Count];
+};
@@ -0,0 +1,201 @@
+#include "PluginWorker.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+float elapsedUs(Clock::time_point since) {
+    return std::chrono::duration<float, std::micro>(Clock::now() - since).count();
+}
+
+void accumulate(std::atomic<float>& mean, std::atomic<float>& max, float value) {
+    // Exponential moving average keeps the stats allocation-free
+    float m = mean.load(std::memory_order_relaxed);
+    mean.store(m + 0.01f * (value - m), std::memory_order_relaxed);
+    if (value > max.load(std::memory_order_relaxed)) {
+        max.store(value, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+PluginWorker::PluginWorker(StepFunc func, void* context) : stepFunc(func), stepContext(context) {
+    memset(blocks, 0, sizeof(blocks));
+}
+
+PluginWorker::~PluginWorker() {
+    stop();
+}
+
+void PluginWorker::start() {
+    if (running.load()) return;
+    running.store(true);
+    thread = std::thread(&PluginWorker::workerLoop, this);
+}
+
+void PluginWorker::stop() {
+    if (!running.exchange(false)) return;
+    wake();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void PluginWorker::pause() {
+    // Claim the state word; a pending job is dropped, a running one finishes first
+    int current = state.load();
+    while (current != PAUSED) {
+        if (current == RUNNING) {
+            std::this_thread::yield();
+            current = state.load();
+        } else {
+            state.compare_exchange_weak(current, PAUSED);
+        }
+    }
+}
+
+void PluginWorker::resume() {
+    int expected = PAUSED;
+    state.compare_exchange_strong(expected, IDLE);
+    wake();
+}
+
+void PluginWorker::wake() {
+    // Passing through the mutex orders this notify after the worker's
+    // predicate check, so it cannot be lost. The worker only holds the mutex
+    // while checking the predicate, never across step().
+    { std::lock_guard<std::mutex> lock(wakeMutex); }
+    wakeCondition.notify_one();
+}
+
+PluginWorker::Stats PluginWorker::getStats() const {
+    Stats snapshot;
+    snapshot.blocks = stats.blocks.load(std::memory_order_relaxed);
+    snapshot.inlineFallbacks = stats.inlineFallbacks.load(std::memory_order_relaxed);
+    snapshot.missedDeadlines = stats.missedDeadlines.load(std::memory_order_relaxed);
+    snapshot.meanWaitUs = stats.meanWaitUs.load(std::memory_order_relaxed);
+    snapshot.maxWaitUs = stats.maxWaitUs.load(std::memory_order_relaxed);
+    snapshot.meanStepUs = stats.meanStepUs.load(std::memory_order_relaxed);
+    snapshot.maxStepUs = stats.maxStepUs.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+void PluginWorker::resetStats() {
+    stats.blocks.store(0);
+    stats.inlineFallbacks.store(0);
+    stats.missedDeadlines.store(0);
+    stats.meanWaitUs.store(0.f);
+    stats.maxWaitUs.store(0.f);
+    stats.meanStepUs.store(0.f);
+    stats.maxStepUs.store(0.f);
+}
+
+bool PluginWorker::finishPrevious() {
+    Clock::time_point start = Clock::now();
+
+    missed = false;
+    int expected = PENDING;
+    if (state.compare_exchange_strong(expected, RUNNING)) {
+        // Worker never picked the job up - run it here instead. Never while
+        // paused: pause() has taken the state word away from PENDING.
+        stats.inlineFallbacks.fetch_add(1, std::memory_order_relaxed);
+        runJob();
+    } else if (expected == RUNNING) {
+        // Still inside step(): don't wait for it, exchange() covers the block
+        stats.missedDeadlines.fetch_add(1, std::memory_order_relaxed);
+        missed = true;
+    }
+
+    accumulate(stats.meanWaitUs, stats.maxWaitUs, elapsedUs(start));
+    return !missed;
+}
+
+void PluginWorker::resetPipeline() {
+    hasResult = false;
+    canRepeat = false;
+    missed = false;
+}
+
+void PluginWorker::exchange(float* buses, int numFloats, int numFramesBy4) {
+    numFloats = std::min(numFloats, (int)MAX_BLOCK_FLOATS);
+
+    // Paused: nothing is submitted, and whatever was in flight was dropped
+    if (state.load(std::memory_order_acquire) == PAUSED) {
+        int blockFrames = numFloats / 28;
+        memset(buses + 12 * blockFrames, 0, 16 * blockFrames * sizeof(float));
+        hasResult = false;
+        canRepeat = false;
+        missed = false;
+        return;
+    }
+
+    // The worker still owns the job buffer: repeat the last output block and
+    // drop this input block. The late result is collected at the next boundary.
+    if (missed) {
+        missed = false;
+        int blockFrames = numFloats / 28;
+        if (canRepeat && jobFloats == numFloats) {
+            memcpy(buses + 12 * blockFrames, blocks[1 - jobBlock] + 12 * blockFrames,
+                   16 * blockFrames * sizeof(float));
+        } else {
+            memset(buses + 12 * blockFrames, 0, 16 * blockFrames * sizeof(float));
+        }
+        return;
+    }
+
+    // Hand the new input block to the worker in the free buffer
+    int resultBlock = jobBlock;
+    int nextBlock = 1 - jobBlock;
+    memcpy(blocks[nextBlock], buses, numFloats * sizeof(float));
+
+    // Return the previous block's output (silence until the pipeline has filled,
+    // or if the block size changed since it was submitted)
+    canRepeat = hasResult && jobFloats == numFloats;
+    if (canRepeat) {
+        memcpy(buses, blocks[resultBlock], numFloats * sizeof(float));
+    } else {
+        int blockFrames = numFloats / 28;
+        memset(buses + 12 * blockFrames, 0, 16 * blockFrames * sizeof(float));
+    }
+
+    jobBlock = nextBlock;
+    jobFloats = numFloats;
+    jobFramesBy4 = numFramesBy4;
+    hasResult = true;
+    stats.blocks.fetch_add(1, std::memory_order_relaxed);
+
+    // Only from IDLE: if pause() got in since the check above, the job is
+    // simply never run and the next block comes back silent
+    int expected = IDLE;
+    if (state.compare_exchange_strong(expected, PENDING, std::memory_order_release)) {
+        wake();
+    } else {
+        hasResult = false;
+    }
+}
+
+void PluginWorker::runJob() {
+    Clock::time_point start = Clock::now();
+    stepFunc(stepContext, blocks[jobBlock], jobFramesBy4);
+    accumulate(stats.meanStepUs, stats.maxStepUs, elapsedUs(start));
+    state.store(IDLE, std::memory_order_release);
+}
+
+void PluginWorker::workerLoop() {
+    while (running.load()) {
+        int expected = PENDING;
+        if (state.compare_exchange_strong(expected, RUNNING, std::memory_order_acquire)) {
+            runJob();
+            continue;
+        }
+
+        // Sleeps until wake(); no timeout, so no polling latency
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait(lock, [this]() {
+            return !running.load() || state.load() == PENDING;
+        });
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// Per-module worker thread that runs the plugin's step() one block behind
+// the engine thread (pipelined mode).
+//
+// At each block boundary the engine calls finishPrevious() and then
+// exchange(): the freshly routed input block goes to the worker and the
+// block the worker finished during the previous period comes back, so
+// outputs are delayed by exactly one block.
+//
+// Handoff is a single atomic state word. If the worker has not picked up its
+// job by the next boundary the engine claims it back and runs it inline. If
+// the worker is still mid-step the engine never waits: exchange() repeats the
+// last output block (or outputs silence), drops the new input block and the
+// late result comes back at the following boundary. Both cases are counted.
+//
+// pause() moves the state word to PAUSED itself (waiting out a running step
+// first), so once it returns neither thread can start step() until resume().
+// A job still pending at that point is dropped and its block comes back silent.
+class PluginWorker {
+public:
+    using StepFunc = void (*)(void* context, float* buses, int numFramesBy4);
+
+    static constexpr int MAX_BLOCK_FLOATS = 28 * 64;
+
+    struct Stats {
+        uint32_t blocks = 0;            // Blocks handed to the worker
+        uint32_t inlineFallbacks = 0;   // Jobs the engine reclaimed and ran inline
+        uint32_t missedDeadlines = 0;   // Boundaries where step() was still running; output repeated
+        float meanWaitUs = 0.f;         // Engine time spent in finishPrevious() (smoothed)
+        float maxWaitUs = 0.f;
+        float meanStepUs = 0.f;         // step() duration on whichever thread ran it (smoothed)
+        float maxStepUs = 0.f;
+    };
+
+    PluginWorker(StepFunc func, void* context);
+    ~PluginWorker();
+
+    // UI thread
+    void start();
+    void stop();
+    bool isRunning() const { return running.load(); }
+
+    // Keep both threads out of step() (e.g. while the plugin is unloaded).
+    // Returns once any step in progress has finished.
+    void pause();
+    void resume();
+
+    // Engine thread, at a block boundary. Returns false if the worker is
+    // still inside step() (the deadline was missed); exchange() then repeats
+    // the last output instead of submitting a new job.
+    bool finishPrevious();
+    void exchange(float* buses, int numFloats, int numFramesBy4);
+    void resetPipeline();   // Forget the in-flight result when (re)entering pipelined mode
+
+    // Snapshot of the counters written by the engine and worker threads
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    enum State : int { IDLE, PENDING, RUNNING, PAUSED };
+
+    // Only one thread updates these at a time (whichever owns the job), but
+    // the UI reads and resets them concurrently
+    struct Counters {
+        std::atomic<uint32_t> blocks{0};
+        std::atomic<uint32_t> inlineFallbacks{0};
+        std::atomic<uint32_t> missedDeadlines{0};
+        std::atomic<float> meanWaitUs{0.f};
+        std::atomic<float> maxWaitUs{0.f};
+        std::atomic<float> meanStepUs{0.f};
+        std::atomic<float> maxStepUs{0.f};
+    };
+
+    StepFunc stepFunc;
+    void* stepContext;
+
+    // Double-buffered bus blocks: one owned by the worker, one holding the last result
+    alignas(16) float blocks[2][MAX_BLOCK_FLOATS];
+    int jobBlock = 0;
+    int jobFloats = 0;
+    int jobFramesBy4 = 0;
+    bool hasResult = false;
+    bool canRepeat = false;     // The other buffer holds the last output returned
+    bool missed = false;        // finishPrevious() found the worker still running
+
+    std::atomic<int> state{IDLE};
+    std::atomic<bool> running{false};
+
+    std::thread thread;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+
+    Counters stats;
+
+    void workerLoop();
+    void runJob();
+    void wake();
+};
@@ -77,13 +77,14 @@ _NT_factory factory = {
 };
 
 // Plugin entry point
-extern "C" _NT_algorithmFactory* pluginEntry() {
-    static _NT_algorithmFactory factory = {
-        .apiVersion = 1,
-        .construct = []() -> _NT_algorithm* { return new DrawTest(); },
-        .name = "Draw Test",
-        .uuid = {0xD4, 0x4A, 0x77, 0x01, 0x22, 0x33, 0x44, 0x55,
-                 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD}
-    };
-    return &factory;
-}
\ No newline at end of file
+uintptr_t pluginEntry(_NT_selector selector, uint32_t data) {
+    switch (selector) {
+        case kNT_selector_version:
+            return kNT_apiVersionCurrent;
+        case kNT_selector_numFactories:
+            return 1;
+        case kNT_selector_factoryInfo:
+            return (uintptr_t)((data == 0) ? &factory : NULL);
+    }
+    return 0;
+}
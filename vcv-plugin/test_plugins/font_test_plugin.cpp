@@ -1,4 +1,5 @@
 #include <cstdint>
+#include <cstring>
 #include "../../emulator/src/core/fonts.h"
 
 // VCV plugin specific implementation that uses NT_screen directly
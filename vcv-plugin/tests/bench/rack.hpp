@@ -0,0 +1,111 @@
+#pragma once
+/*
+ * Minimal Rack SDK stand-in for the hot-path benchmarks
+ *
+ * Covers only what the benchmarked sources use: the logging macros,
+ * simd::float_4, engine ports and a few system:: helpers. Log calls still
+ * format their message so their cost shows up in the timings; the text is
+ * discarded instead of written to log.txt.
+ */
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace rack {
+
+namespace logger {
+    inline void log(const char* format, ...) {
+        static thread_local char sink[1024];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(sink, sizeof(sink), format, args);
+        va_end(args);
+    }
+}
+
+#define DEBUG(format, ...) rack::logger::log(format, ##__VA_ARGS__)
+#define INFO(format, ...) rack::logger::log(format, ##__VA_ARGS__)
+#define WARN(format, ...) rack::logger::log(format, ##__VA_ARGS__)
+#define FATAL(format, ...) rack::logger::log(format, ##__VA_ARGS__)
+
+namespace math {
+    template <typename T>
+    T clamp(T x, T a, T b) {
+        return std::max(std::min(x, b), a);
+    }
+}
+using math::clamp;
+
+namespace simd {
+    struct float_4 {
+        __m128 v;
+
+        float_4() = default;
+        float_4(__m128 v) : v(v) {}
+
+        static float_4 zero() { return _mm_setzero_ps(); }
+        static float_4 load(const float* p) { return _mm_loadu_ps(p); }
+        void store(float* p) const { _mm_storeu_ps(p, v); }
+    };
+
+    inline float_4 operator&(float_4 a, float_4 b) {
+        return _mm_and_ps(a.v, b.v);
+    }
+
+    template <typename T>
+    T movemaskInverse(int mask);
+
+    template <>
+    inline float_4 movemaskInverse<float_4>(int mask) {
+        __m128i bits = _mm_set_epi32(-((mask >> 3) & 1), -((mask >> 2) & 1), -((mask >> 1) & 1), -(mask & 1));
+        return _mm_castsi128_ps(bits);
+    }
+}
+
+namespace engine {
+    struct Port {
+        float voltages[16] = {};
+        uint8_t channels = 0;
+
+        float getVoltage(int channel = 0) const { return voltages[channel]; }
+        void setVoltage(float voltage, int channel = 0) { voltages[channel] = voltage; }
+        bool isConnected() const { return channels > 0; }
+    };
+
+    struct Input : Port {};
+    struct Output : Port {};
+}
+
+namespace system {
+    inline bool isDirectory(const std::string& path) {
+        std::error_code ec;
+        return std::filesystem::is_directory(path, ec);
+    }
+
+    inline std::vector<std::string> getEntries(const std::string& dirPath) {
+        std::vector<std::string> entries;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(dirPath, ec)) {
+            entries.push_back(entry.path().string());
+        }
+        return entries;
+    }
+
+    inline std::string getFilename(const std::string& path) {
+        return std::filesystem::path(path).filename().string();
+    }
+
+    inline std::string getExtension(const std::string& path) {
+        return std::filesystem::path(path).extension().string();
+    }
+}
+
+}  // namespace rack
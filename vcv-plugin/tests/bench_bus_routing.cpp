@@ -0,0 +1,149 @@
+/*
+ * BusSystem routing micro-benchmark
+ *
+ * Measures the per-frame cost of moving 12 inputs into the [bus][frame]
+ * layout and 8 outputs back out, comparing the original per-sample path
+ * (bounds-checked setBus/getBus, isConnected() on every sample) with the
+ * block path in src/dsp/BusSystem.hpp (connectivity cached per block,
+ * direct strided stores) at each step block size.
+ *
+ * Build and run with: make -f Makefile.bench run-bus-routing
+ */
+
+#include "../src/dsp/BusSystem.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Minimal stand-in for EmulatorModule's port layout
+struct BenchModule {
+    enum InputIds { AUDIO_INPUT_1, NUM_INPUTS = 12 };
+    enum OutputIds { AUDIO_OUTPUT_1, NUM_OUTPUTS = 8 };
+    engine::Input inputs[NUM_INPUTS];
+    engine::Output outputs[NUM_OUTPUTS];
+};
+
+// The routing path as it was before the staged engine, kept for comparison
+struct LegacyBusSystem {
+    alignas(16) float buses[28 * 4];
+    int sampleIndex = 0;
+
+    float getBus(int busIndex, int sampleOffset) {
+        if (busIndex >= 0 && busIndex < 28 && sampleOffset >= 0 && sampleOffset < 4) {
+            return buses[busIndex * 4 + sampleOffset];
+        }
+        return 0.0f;
+    }
+
+    void setBus(int busIndex, int sampleOffset, float value) {
+        if (busIndex >= 0 && busIndex < 28 && sampleOffset >= 0 && sampleOffset < 4) {
+            buses[busIndex * 4 + sampleOffset] = value;
+        }
+    }
+
+    void routeInputs(BenchModule* module) {
+        for (int i = 0; i < 12; i++) {
+            if (module->inputs[BenchModule::AUDIO_INPUT_1 + i].isConnected()) {
+                setBus(i, sampleIndex, module->inputs[BenchModule::AUDIO_INPUT_1 + i].getVoltage());
+            } else {
+                setBus(i, sampleIndex, 0.0f);
+            }
+        }
+    }
+
+    void routeOutputs(BenchModule* module) {
+        for (int i = 0; i < 8; i++) {
+            module->outputs[BenchModule::AUDIO_OUTPUT_1 + i].setVoltage(getBus(12 + i, sampleIndex));
+        }
+        sampleIndex = (sampleIndex + 1) % 4;
+    }
+};
+
+static inline uint64_t readCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static const char* cycleUnit() {
+#if defined(__x86_64__) || defined(__i386__)
+    return "cycles";
+#else
+    return "ns";
+#endif
+}
+
+static const int NUM_FRAMES = 1 << 22;
+
+// Stands in for Rack's engine reading and writing the ports between frames,
+// so the compiler can't fold the constant voltages or drop the port stores
+static inline void clobberPorts(BenchModule& module) {
+#if defined(__GNUC__)
+    __asm__ volatile("" : : "r"(&module) : "memory");
+#endif
+}
+
+static void setupModule(BenchModule& module) {
+    for (int i = 0; i < BenchModule::NUM_INPUTS; i++) {
+        // Patch every other input so the connectivity masks matter
+        module.inputs[i].channels = (i % 2 == 0) ? 1 : 0;
+        module.inputs[i].setVoltage(0.1f * i);
+    }
+}
+
+static double benchLegacy() {
+    BenchModule module;
+    setupModule(module);
+    LegacyBusSystem bus = {};
+
+    uint64_t start = readCycles();
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        clobberPorts(module);
+        bus.routeInputs(&module);
+        bool processBlock = (bus.sampleIndex == 3);
+        bus.routeOutputs(&module);
+        if (processBlock) {
+            memset(bus.buses + 12 * 4, 0, 16 * 4 * sizeof(float));
+        }
+    }
+    uint64_t end = readCycles();
+    return (double)(end - start) / NUM_FRAMES;
+}
+
+static double benchStaged(int blockFrames) {
+    BenchModule module;
+    setupModule(module);
+    static BusSystem bus;
+    bus.init();
+    bus.setBlockFrames(blockFrames);
+
+    uint64_t start = readCycles();
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        clobberPorts(module);
+        bus.routeInputs(&module);
+        bool processBlock = bus.isLastSampleOfBlock();
+        bus.routeOutputs(&module);
+        if (processBlock) {
+            bus.clearOutputBuses();
+        }
+    }
+    uint64_t end = readCycles();
+    return (double)(end - start) / NUM_FRAMES;
+}
+
+int main() {
+    printf("BusSystem routing benchmark (%d frames, %s per frame)\n", NUM_FRAMES, cycleUnit());
+    printf("  legacy per-sample (4 frames): %8.2f\n", benchLegacy());
+
+    const int blockSizes[] = {4, 16, 32, 64};
+    for (int frames : blockSizes) {
+        printf("  block path (%2d frames):       %8.2f\n", frames, benchStaged(frames));
+    }
+    return 0;
+}
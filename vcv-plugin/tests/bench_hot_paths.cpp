@@ -0,0 +1,609 @@
+/*
+ * Hot-path micro-benchmark suite
+ *
+ * Times the emulator code that runs per sample, per block or per frame:
+ * - BusSystem routing (per-sample jack <-> bus transfer)
+ * - OLED frame capture with dirty-row tracking (NTApi::captureScreen)
+ * - NT_drawText / NT_drawShapeI
+ * - VirtualSdCard::convertSamples
+ * - the JSON stream/parse bridges
+ * - step() of any plugins named on the command line
+ *
+ * Builds against tests/bench/rack.hpp instead of the Rack SDK, so it runs on
+ * machines without Rack or an audio device. Results are written as JSON for
+ * tracking between releases; a previous run can be passed with --compare to
+ * flag regressions.
+ *
+ * Build and run with: make -f Makefile.bench run
+ *
+ * Usage: bench_hot_paths [--json out.json] [--filter text] [--min-ms N]
+ *                        [--compare baseline.json] [--tolerance percent]
+ *                        [plugin.dylib ...]
+ */
+
+#include "../src/dsp/BusSystem.hpp"
+#include "../src/display/VCVDisplayBuffer.hpp"
+#include "../src/api/VirtualSdCard.hpp"
+#include "../src/api/NTApiContext.hpp"
+#include "../src/json_bridge.h"
+#include "../src/plugin/AlgorithmMemory.hpp"
+#include <distingnt/api.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using json = nlohmann::json;
+
+extern uint8_t NT_screen[128 * 64];
+
+// Parameter callbacks normally provided by NtEmu.cpp
+extern "C" {
+    void emulatorHandleSetParameterFromUi(uint32_t, uint32_t, int16_t) {}
+    void emulatorHandleSetParameterFromAudio(uint32_t, uint32_t, int16_t) {}
+    void emulatorHandleSetParameterGrayedOut(uint32_t, bool) {}
+    void emulatorHandleUpdateParameterDefinition(uint32_t) {}
+    void emulatorHandleUpdateParameterPages() {}
+}
+
+namespace {
+
+struct Options {
+    std::string jsonPath;
+    std::string filter;
+    std::string comparePath;
+    double tolerancePercent = 10.0;
+    double minMs = 50.0;                 // Minimum time per repetition
+    std::vector<std::string> plugins;
+};
+
+struct Result {
+    std::string name;
+    std::string unit;                    // What one "item" is
+    double itemsPerOp = 1.0;
+    uint64_t iterations = 0;
+    double medianNsPerOp = 0.0;
+    double minNsPerOp = 0.0;
+};
+
+Options g_options;
+std::vector<Result> g_results;
+
+volatile float g_sink = 0.f;
+
+static const int REPETITIONS = 7;
+
+double nowNs() {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Runs body() enough times to fill minMs, REPETITIONS times, and keeps the
+// median and fastest repetition
+template <typename F>
+void bench(const std::string& name, const std::string& unit, double itemsPerOp, F&& body) {
+    if (!g_options.filter.empty() && name.find(g_options.filter) == std::string::npos) return;
+
+    uint64_t iterations = 1;
+    for (;;) {
+        double start = nowNs();
+        for (uint64_t i = 0; i < iterations; i++) body();
+        double elapsedMs = (nowNs() - start) * 1e-6;
+        if (elapsedMs >= g_options.minMs * 0.5 || iterations >= (1ull << 32)) {
+            double scale = g_options.minMs / std::max(elapsedMs, 1e-3);
+            iterations = std::max<uint64_t>(1, (uint64_t)(iterations * scale));
+            break;
+        }
+        iterations *= 2;
+    }
+
+    std::vector<double> perOp(REPETITIONS);
+    for (int r = 0; r < REPETITIONS; r++) {
+        double start = nowNs();
+        for (uint64_t i = 0; i < iterations; i++) body();
+        perOp[r] = (nowNs() - start) / iterations;
+    }
+    std::sort(perOp.begin(), perOp.end());
+
+    Result result;
+    result.name = name;
+    result.unit = unit;
+    result.itemsPerOp = itemsPerOp;
+    result.iterations = iterations;
+    result.medianNsPerOp = perOp[REPETITIONS / 2];
+    result.minNsPerOp = perOp[0];
+    g_results.push_back(result);
+
+    fprintf(stderr, "  %-40s %12.1f ns/op %10.2f ns/%s\n",
+            name.c_str(), result.medianNsPerOp, result.medianNsPerOp / itemsPerOp, unit.c_str());
+}
+
+// --- BusSystem -------------------------------------------------------------
+
+struct BenchModule {
+    enum InputIds { AUDIO_INPUT_1, NUM_INPUTS = 12 };
+    enum OutputIds { AUDIO_OUTPUT_1, NUM_OUTPUTS = 8 };
+    engine::Input inputs[NUM_INPUTS];
+    engine::Output outputs[NUM_OUTPUTS];
+};
+
+void benchBusSystem() {
+    static BenchModule module;
+    for (int i = 0; i < BenchModule::NUM_INPUTS; i++) {
+        // Patch every other input so the connectivity masks matter
+        module.inputs[i].channels = (i % 2 == 0) ? 1 : 0;
+        module.inputs[i].setVoltage(0.1f * i);
+    }
+
+    static BusSystem bus;
+    const int blockSizes[] = {4, 16, 64};
+    for (int frames : blockSizes) {
+        bus.init();
+        bus.setBlockFrames(frames);
+        // One op = one block of per-sample routing
+        bench("bus/route_block" + std::to_string(frames), "frame", frames, [&] {
+            for (int f = 0; f < frames; f++) {
+                bus.routeInputs(&module);
+                bool processBlock = bus.isLastSampleOfBlock();
+                bus.routeOutputs(&module);
+                if (processBlock) {
+                    bus.clearOutputBuses();
+                }
+            }
+        });
+    }
+}
+
+// --- Display ---------------------------------------------------------------
+
+void fillTestPattern(uint8_t* screen) {
+    for (int i = 0; i < 128 * 64; i++) {
+        screen[i] = (uint8_t)(i * 37 + (i >> 7));
+    }
+}
+
+void benchDisplay() {
+    static uint8_t screen[128 * 64];
+    fillTestPattern(screen);
+    static NTApiContext context;
+
+    // A plugin redrawing the same frame: nothing to copy or upload
+    bench("oled/capture_unchanged", "frame", 1, [&] {
+        NTApi::beginScreenFrame();
+        memcpy(NT_screen, screen, sizeof(screen));
+        NTApi::captureScreen(&context);
+        g_sink = (uint8_t)context.dirtyRows;
+        context.dirtyRows = 0;
+    });
+
+    // Every row differs from the previous frame
+    static uint8_t frame = 0;
+    bench("oled/capture_changed", "frame", 1, [&] {
+        NTApi::beginScreenFrame();
+        memset(NT_screen, ++frame, sizeof(screen));
+        NTApi::captureScreen(&context);
+        g_sink = (uint8_t)context.dirtyRows;
+        context.dirtyRows = 0;
+    });
+
+    const char* text = "Frequency 440.0 Hz";
+    bench("draw/text_tiny", "call", 1, [&] {
+        NT_drawText(10, 20, text, 15, kNT_textLeft, kNT_textTiny);
+    });
+    bench("draw/text_normal", "call", 1, [&] {
+        NT_drawText(128, 30, text, 15, kNT_textCentre, kNT_textNormal);
+    });
+    bench("draw/text_large", "call", 1, [&] {
+        NT_drawText(250, 50, text, 15, kNT_textRight, kNT_textLarge);
+    });
+
+    bench("draw/shape_line", "call", 1, [&] {
+        NT_drawShapeI(kNT_line, 0, 0, 255, 63, 15);
+    });
+    bench("draw/shape_box", "call", 1, [&] {
+        NT_drawShapeI(kNT_box, 10, 10, 200, 50, 8);
+    });
+    bench("draw/shape_rectangle_fullscreen", "pixel", 256 * 64, [&] {
+        NT_drawShapeI(kNT_rectangle, 0, 0, 255, 63, 0);
+    });
+    // Odd left and even right edges: partial bytes on every row
+    bench("draw/shape_rectangle_odd_edges", "pixel", 238 * 40, [&] {
+        NT_drawShapeI(kNT_rectangle, 11, 12, 248, 51, 5);
+    });
+    // A typical widget: a small filled bar
+    bench("draw/shape_rectangle_small", "pixel", 24 * 6, [&] {
+        NT_drawShapeI(kNT_rectangle, 101, 30, 124, 35, 12);
+    });
+    g_sink = NT_screen[0];
+}
+
+// --- Sample conversion -----------------------------------------------------
+
+void benchConvertSamples() {
+    const uint32_t frames = 4096;
+    static std::vector<uint8_t> src(frames * 2 * 4);
+    static std::vector<uint8_t> dst(frames * 2 * 4);
+    std::mt19937 rng(1);
+    for (uint8_t& b : src) b = (uint8_t)rng();
+
+    struct Case {
+        const char* name;
+        _NT_wavChannels srcChannels, dstChannels;
+        _NT_wavBits srcBits, dstBits;
+    };
+    const Case cases[] = {
+        {"sdcard/convert_16s_to_16s", kNT_WavStereo, kNT_WavStereo, kNT_WavBits16, kNT_WavBits16},
+        {"sdcard/convert_16s_to_32s", kNT_WavStereo, kNT_WavStereo, kNT_WavBits16, kNT_WavBits32},
+        {"sdcard/convert_24m_to_32s", kNT_WavMono, kNT_WavStereo, kNT_WavBits24, kNT_WavBits32},
+        {"sdcard/convert_16s_to_16m", kNT_WavStereo, kNT_WavMono, kNT_WavBits16, kNT_WavBits16},
+    };
+    for (const Case& c : cases) {
+        bench(c.name, "frame", frames, [&] {
+            VirtualSdCard::convertSamples(src.data(), dst.data(), frames,
+                                          c.srcChannels, c.dstChannels, c.srcBits, c.dstBits);
+        });
+    }
+    g_sink = dst[0];
+}
+
+// --- JSON bridges ----------------------------------------------------------
+
+// Shaped like a typical preset: a few scalars, an array of step values and
+// an array of small objects
+const int JSON_STEPS = 256;
+const int JSON_VOICES = 16;
+
+void writePreset(JsonStreamBridge& stream) {
+    stream.addMemberName("version");
+    stream.addNumber(3);
+    stream.addMemberName("name");
+    stream.addString("Benchmark preset");
+    stream.addMemberName("steps");
+    stream.openArray();
+    for (int i = 0; i < JSON_STEPS; i++) {
+        stream.addNumber(i * 0.25f);
+    }
+    stream.closeArray();
+    stream.addMemberName("voices");
+    stream.openArray();
+    for (int i = 0; i < JSON_VOICES; i++) {
+        stream.openObject();
+        stream.addMemberName("note");
+        stream.addNumber(36 + i);
+        stream.addMemberName("active");
+        stream.addBoolean(i % 3 != 0);
+        stream.closeObject();
+    }
+    stream.closeArray();
+}
+
+bool readPreset(JsonParseBridge& parse) {
+    int members = 0;
+    if (!parse.numberOfObjectMembers(members)) return false;
+
+    float sum = 0.f;
+    for (int m = 0; m < members; m++) {
+        if (parse.matchName("version")) {
+            int version;
+            if (!parse.number(version)) return false;
+        } else if (parse.matchName("name")) {
+            const char* name;
+            if (!parse.string(name)) return false;
+        } else if (parse.matchName("steps")) {
+            int count;
+            if (!parse.numberOfArrayElements(count)) return false;
+            for (int i = 0; i < count; i++) {
+                float value;
+                if (!parse.number(value)) return false;
+                sum += value;
+            }
+        } else if (parse.matchName("voices")) {
+            int count;
+            if (!parse.numberOfArrayElements(count)) return false;
+            for (int i = 0; i < count; i++) {
+                int fields;
+                if (!parse.numberOfObjectMembers(fields)) return false;
+                for (int f = 0; f < fields; f++) {
+                    int note;
+                    bool active;
+                    if (parse.matchName("note")) {
+                        if (!parse.number(note)) return false;
+                    } else if (parse.matchName("active")) {
+                        if (!parse.boolean(active)) return false;
+                    } else if (!parse.skipMember()) {
+                        return false;
+                    }
+                }
+            }
+        } else if (!parse.skipMember()) {
+            return false;
+        }
+    }
+    g_sink = sum;
+    return true;
+}
+
+void benchJsonBridges() {
+    bench("json/stream_preset", "call", 1, [&] {
+        JsonStreamBridge stream;
+        writePreset(stream);
+        g_sink = (float)stream.getJson().size();
+    });
+
+    JsonStreamBridge stream;
+    writePreset(stream);
+    const json preset = stream.getJson();
+    bench("json/parse_preset", "call", 1, [&] {
+        JsonParseBridge parse(preset);
+        readPreset(parse);
+    });
+}
+
+// --- Plugin step() ---------------------------------------------------------
+
+typedef uintptr_t (*PluginEntryFunc)(_NT_selector, uint32_t);
+
+struct LoadedPlugin {
+    void* handle = nullptr;
+    _NT_factory* factory = nullptr;
+    _NT_algorithm* algorithm = nullptr;
+    std::vector<int16_t> values;
+    AlgorithmMemory memory;
+    std::vector<void*> allocations;
+
+    void* allocate(size_t bytes) {
+        if (bytes == 0) return nullptr;
+        void* memory = nullptr;
+        if (posix_memalign(&memory, 16, bytes) != 0) return nullptr;
+        memset(memory, 0, bytes);
+        allocations.push_back(memory);
+        return memory;
+    }
+
+    ~LoadedPlugin() {
+        for (void* memory : allocations) free(memory);
+        if (handle) dlclose(handle);
+    }
+};
+
+// Same construction sequence as PluginManager, minus the UI plumbing
+bool loadPlugin(const std::string& path, LoadedPlugin& plugin) {
+    plugin.handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!plugin.handle) {
+        fprintf(stderr, "  %s: %s\n", path.c_str(), dlerror());
+        return false;
+    }
+
+    PluginEntryFunc pluginEntry = (PluginEntryFunc)dlsym(plugin.handle, "pluginEntry");
+    if (!pluginEntry || pluginEntry(kNT_selector_numFactories, 0) < 1) {
+        fprintf(stderr, "  %s: no pluginEntry or factories\n", path.c_str());
+        return false;
+    }
+    plugin.factory = (_NT_factory*)pluginEntry(kNT_selector_factoryInfo, 0);
+    _NT_factory* factory = plugin.factory;
+    if (!factory || !factory->calculateRequirements || !factory->construct || !factory->step) {
+        fprintf(stderr, "  %s: incomplete factory\n", path.c_str());
+        return false;
+    }
+
+    std::vector<int32_t> specifications;
+    for (uint32_t i = 0; i < factory->numSpecifications; i++) {
+        specifications.push_back(factory->specifications[i].def);
+    }
+    const int32_t* specs = specifications.empty() ? nullptr : specifications.data();
+
+    if (factory->calculateStaticRequirements) {
+        _NT_staticRequirements staticReqs = {};
+        factory->calculateStaticRequirements(staticReqs);
+        _NT_staticMemoryPtrs staticPtrs = {};
+        staticPtrs.dram = (uint8_t*)plugin.allocate(staticReqs.dram);
+        if (factory->initialise) {
+            factory->initialise(staticPtrs, staticReqs);
+        }
+    }
+
+    _NT_algorithmRequirements reqs = {};
+    factory->calculateRequirements(reqs, specs);
+
+    std::string error;
+    if (!plugin.memory.allocate(reqs, error)) {
+        fprintf(stderr, "  %s: %s\n", path.c_str(), error.c_str());
+        return false;
+    }
+
+    plugin.algorithm = factory->construct(plugin.memory.getPointers(), reqs, specs);
+    if (!plugin.algorithm) {
+        fprintf(stderr, "  %s: construct failed\n", path.c_str());
+        return false;
+    }
+
+    plugin.values.assign(reqs.numParameters, 0);
+    for (uint32_t i = 0; i < reqs.numParameters && plugin.algorithm->parameters; i++) {
+        plugin.values[i] = plugin.algorithm->parameters[i].def;
+    }
+    plugin.algorithm->v = plugin.values.data();
+    plugin.algorithm->vIncludingCommon = plugin.values.data();
+
+    if (factory->parameterChanged) {
+        for (uint32_t i = 0; i < reqs.numParameters; i++) {
+            factory->parameterChanged(plugin.algorithm, (int)i);
+        }
+    }
+    return true;
+}
+
+std::string pluginName(const std::string& path) {
+    std::string name = path.substr(path.find_last_of('/') + 1);
+    return name.substr(0, name.find('.'));
+}
+
+void benchPlugins() {
+    static NTApiContext context;
+    context.globals = NT_globals;
+    NTApi::ScopedContext scope(&context);
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> noise(-5.f, 5.f);
+
+    for (const std::string& path : g_options.plugins) {
+        LoadedPlugin plugin;
+        if (!loadPlugin(path, plugin)) continue;
+
+        const int blockSizes[] = {4, 32};
+        for (int frames : blockSizes) {
+            std::vector<float> input(BusSystem::NUM_BUSES * frames);
+            for (float& sample : input) sample = noise(rng);
+            std::vector<float> buses(input.size());
+
+            // Inputs are refreshed each call so plugins that accumulate onto
+            // buses don't drift towards denormals or infinity
+            bench("step/" + pluginName(path) + "_block" + std::to_string(frames), "frame", frames, [&] {
+                std::memcpy(buses.data(), input.data(), buses.size() * sizeof(float));
+                plugin.factory->step(plugin.algorithm, buses.data(), frames / 4);
+            });
+            g_sink = buses[12 * frames];
+        }
+    }
+}
+
+// --- Output ----------------------------------------------------------------
+
+json resultsToJson() {
+    json results = json::array();
+    for (const Result& r : g_results) {
+        results.push_back({
+            {"name", r.name},
+            {"unit", r.unit},
+            {"itemsPerOp", r.itemsPerOp},
+            {"iterations", r.iterations},
+            {"medianNsPerOp", r.medianNsPerOp},
+            {"minNsPerOp", r.minNsPerOp},
+            {"nsPerItem", r.medianNsPerOp / r.itemsPerOp},
+        });
+    }
+
+    char timestamp[32];
+    time_t now = time(nullptr);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    return {
+        {"schema", 1},
+        {"timestamp", timestamp},
+        {"compiler", __VERSION__},
+        {"repetitions", REPETITIONS},
+        {"results", results},
+    };
+}
+
+// Prints the change against a previous run; returns the number of benchmarks
+// that got slower by more than the tolerance
+int compareWithBaseline(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "Cannot open baseline %s\n", path.c_str());
+        return -1;
+    }
+    json baseline = json::parse(in, nullptr, false);
+    if (baseline.is_discarded() || !baseline.contains("results")) {
+        fprintf(stderr, "Baseline %s is not a benchmark result file\n", path.c_str());
+        return -1;
+    }
+
+    int regressions = 0;
+    fprintf(stderr, "\nChange against %s (median ns/op):\n", path.c_str());
+    for (const Result& r : g_results) {
+        for (const json& old : baseline["results"]) {
+            if (old.value("name", "") != r.name) continue;
+            double before = old.value("medianNsPerOp", 0.0);
+            if (before <= 0.0) break;
+
+            double change = (r.medianNsPerOp - before) / before * 100.0;
+            bool regressed = change > g_options.tolerancePercent;
+            regressions += regressed ? 1 : 0;
+            fprintf(stderr, "  %-40s %+7.1f%%%s\n", r.name.c_str(), change, regressed ? "  REGRESSION" : "");
+            break;
+        }
+    }
+    return regressions;
+}
+
+bool parseArguments(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--json" && hasValue) {
+            g_options.jsonPath = argv[++i];
+        } else if (arg == "--filter" && hasValue) {
+            g_options.filter = argv[++i];
+        } else if (arg == "--compare" && hasValue) {
+            g_options.comparePath = argv[++i];
+        } else if (arg == "--tolerance" && hasValue) {
+            g_options.tolerancePercent = atof(argv[++i]);
+        } else if (arg == "--min-ms" && hasValue) {
+            g_options.minMs = std::max(1.0, atof(argv[++i]));
+        } else if (arg.compare(0, 2, "--") == 0) {
+            fprintf(stderr, "Unknown or incomplete option %s\n", arg.c_str());
+            return false;
+        } else {
+            g_options.plugins.push_back(arg);
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (!parseArguments(argc, argv)) {
+        fprintf(stderr, "Usage: %s [--json out.json] [--filter text] [--min-ms N] "
+                        "[--compare baseline.json] [--tolerance percent] [plugin ...]\n", argv[0]);
+        return 2;
+    }
+
+    // Some benchmarked code traces to stdout; send it to /dev/null so the cost
+    // is still paid but the JSON on stdout stays clean
+    fflush(stdout);
+    int savedStdout = dup(STDOUT_FILENO);
+    int devNull = open("/dev/null", O_WRONLY);
+    if (devNull >= 0) {
+        dup2(devNull, STDOUT_FILENO);
+        close(devNull);
+    }
+
+    fprintf(stderr, "Hot-path benchmarks (median of %d repetitions)\n", REPETITIONS);
+    benchBusSystem();
+    benchDisplay();
+    benchConvertSamples();
+    benchJsonBridges();
+    benchPlugins();
+
+    fflush(stdout);
+    if (savedStdout >= 0) {
+        dup2(savedStdout, STDOUT_FILENO);
+        close(savedStdout);
+    }
+
+    std::string output = resultsToJson().dump(2);
+    if (g_options.jsonPath.empty()) {
+        printf("%s\n", output.c_str());
+    } else {
+        std::ofstream out(g_options.jsonPath);
+        out << output << "\n";
+        fprintf(stderr, "Results written to %s\n", g_options.jsonPath.c_str());
+    }
+
+    if (!g_options.comparePath.empty()) {
+        int regressions = compareWithBaseline(g_options.comparePath);
+        if (regressions != 0) return 1;
+    }
+    return 0;
+}
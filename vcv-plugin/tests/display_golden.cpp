@@ -0,0 +1,483 @@
+/*
+ * Display golden-image tests
+ *
+ * Loads the drawing test plugins headlessly, runs draw() at the points
+ * listed in a script, and compares each captured frame with a stored golden
+ * image. Meant to be run after any change to the raster, font or capture
+ * code: a whole run takes well under a second, and a change that moves a
+ * single pixel fails it.
+ *
+ * Frames go through the same path as the module's display thread
+ * (NTApi::beginScreenFrame, draw(), NTApi::captureScreen). Frames are
+ * compared as packed 4-bit buffers, 16 pixels per 64-bit XOR; only
+ * mismatching frames are unpacked, to write an actual image and a diff
+ * heatmap next to the golden.
+ *
+ * Script lines (see tests/golden/display_golden.txt):
+ *   <case> <plugin> [<param>=<value> ...] [draws=<n>] [tolerance=<pixels>]
+ *          [call=<symbol>]
+ * Parameters are set (and parameterChanged() called) before drawing;
+ * draws=<n> draws n frames and checks the last. call=<symbol> calls an
+ * exported void(void) instead of draw(), for test code that isn't a full
+ * plugin. Goldens are tests/golden/<case>.pgm, 256x64 with 16 levels.
+ *
+ * Build and run with: make -f Makefile.golden run
+ * Regenerate goldens after an intended change: make -f Makefile.golden update
+ *
+ * Usage: display_golden [--script file] [--plugins dir] [--out dir]
+ *                       [--tolerance pixels] [--filter text] [--update]
+ */
+
+#include "../src/api/NTApiContext.hpp"
+#include "../src/plugin/AlgorithmMemory.hpp"
+#include <distingnt/api.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <dlfcn.h>
+#include <sys/stat.h>
+
+extern uint8_t NT_screen[128 * 64];
+
+// Parameter callbacks normally provided by NtEmu.cpp
+extern "C" {
+    void emulatorHandleSetParameterFromUi(uint32_t, uint32_t, int16_t) {}
+    void emulatorHandleSetParameterFromAudio(uint32_t, uint32_t, int16_t) {}
+    void emulatorHandleSetParameterGrayedOut(uint32_t, bool) {}
+    void emulatorHandleUpdateParameterDefinition(uint32_t) {}
+    void emulatorHandleUpdateParameterPages() {}
+}
+
+namespace {
+
+const int WIDTH = 256;
+const int HEIGHT = 64;
+const int ROW_BYTES = NTApiContext::SCREEN_ROW_BYTES;
+const int SCREEN_BYTES = NTApiContext::SCREEN_BYTES;
+const int HEATMAP_SCALE = 4;
+
+struct Options {
+    std::string scriptPath = "tests/golden/display_golden.txt";
+    std::string pluginDir = "tests/golden/plugins";
+    std::string outDir = "tests/golden/out";
+    std::string filter;
+    int tolerance = 0;                   // Differing pixels allowed per frame
+    bool update = false;
+};
+
+struct TestCase {
+    std::string name;
+    std::string plugin;
+    std::vector<std::pair<int, int>> parameters;
+    int draws = 1;
+    int tolerance = -1;                  // -1: use --tolerance
+    std::string call;
+    int line = 0;
+};
+
+struct Diff {
+    int pixels = 0;
+    int maxDelta = 0;
+    int firstRow = -1;
+    int lastRow = -1;
+};
+
+Options g_options;
+
+// --- Packed-buffer diff ----------------------------------------------------
+
+// Differing pixels between two packed frames: XOR a word at a time, fold
+// each nibble onto its low bit and count
+int countDifferentPixels(const uint8_t* a, const uint8_t* b, int bytes) {
+    const uint64_t LOW_BITS = 0x1111111111111111ull;
+    int pixels = 0;
+    for (int i = 0; i < bytes; i += 8) {
+        uint64_t wa, wb;
+        memcpy(&wa, a + i, 8);
+        memcpy(&wb, b + i, 8);
+        uint64_t x = wa ^ wb;
+        if (!x) continue;
+        x |= x >> 1;
+        x |= x >> 2;
+        pixels += __builtin_popcountll(x & LOW_BITS);
+    }
+    return pixels;
+}
+
+inline int pixelAt(const uint8_t* screen, int x, int y) {
+    uint8_t pair = screen[y * ROW_BYTES + x / 2];
+    return (x & 1) ? (pair & 0x0F) : (pair >> 4);
+}
+
+Diff diffFrames(const uint8_t* actual, const uint8_t* expected) {
+    Diff diff;
+    for (int y = 0; y < HEIGHT; y++) {
+        int rowPixels = countDifferentPixels(actual + y * ROW_BYTES, expected + y * ROW_BYTES, ROW_BYTES);
+        if (!rowPixels) continue;
+        diff.pixels += rowPixels;
+        if (diff.firstRow < 0) diff.firstRow = y;
+        diff.lastRow = y;
+        for (int x = 0; x < WIDTH; x++) {
+            diff.maxDelta = std::max(diff.maxDelta, abs(pixelAt(actual, x, y) - pixelAt(expected, x, y)));
+        }
+    }
+    return diff;
+}
+
+// --- Images ----------------------------------------------------------------
+
+bool readPgm(const std::string& path, uint8_t* screen) {
+    std::ifstream in(path, std::ios::binary);
+    std::string magic;
+    int width = 0, height = 0, maxValue = 0;
+    if (!(in >> magic >> width >> height >> maxValue) || magic != "P5" ||
+        width != WIDTH || height != HEIGHT || maxValue != 15) {
+        return false;
+    }
+    in.get();   // Single whitespace before the pixels
+
+    std::vector<char> pixels(WIDTH * HEIGHT);
+    if (!in.read(pixels.data(), pixels.size())) return false;
+    for (int i = 0; i < SCREEN_BYTES; i++) {
+        screen[i] = (uint8_t)((pixels[2 * i] & 0x0F) << 4 | (pixels[2 * i + 1] & 0x0F));
+    }
+    return true;
+}
+
+bool writePgm(const std::string& path, const uint8_t* screen) {
+    std::ofstream out(path, std::ios::binary);
+    out << "P5\n" << WIDTH << " " << HEIGHT << "\n15\n";
+    for (int i = 0; i < SCREEN_BYTES; i++) {
+        out.put((char)(screen[i] >> 4));
+        out.put((char)(screen[i] & 0x0F));
+    }
+    return (bool)out;
+}
+
+// Matching pixels are the golden, dimmed; differing ones run from dark to
+// bright red with the size of the difference
+bool writeHeatmap(const std::string& path, const uint8_t* actual, const uint8_t* expected) {
+    std::ofstream out(path, std::ios::binary);
+    out << "P6\n" << WIDTH * HEATMAP_SCALE << " " << HEIGHT * HEATMAP_SCALE << "\n255\n";
+    std::vector<char> row(WIDTH * HEATMAP_SCALE * 3);
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            int want = pixelAt(expected, x, y);
+            int delta = abs(pixelAt(actual, x, y) - want);
+            char r, g, b;
+            if (delta) {
+                r = (char)(127 + delta * 8);
+                g = b = 0;
+            } else {
+                r = g = b = (char)(want * 4);
+            }
+            for (int s = 0; s < HEATMAP_SCALE; s++) {
+                char* p = &row[(x * HEATMAP_SCALE + s) * 3];
+                p[0] = r;
+                p[1] = g;
+                p[2] = b;
+            }
+        }
+        for (int s = 0; s < HEATMAP_SCALE; s++) {
+            out.write(row.data(), row.size());
+        }
+    }
+    return (bool)out;
+}
+
+// --- Plugins ---------------------------------------------------------------
+
+typedef uintptr_t (*PluginEntryFunc)(_NT_selector, uint32_t);
+typedef void (*DrawFunc)();
+
+struct LoadedPlugin {
+    void* handle = nullptr;
+    _NT_factory* factory = nullptr;
+    _NT_algorithm* algorithm = nullptr;
+    std::vector<int16_t> values;
+    AlgorithmMemory memory;
+    std::vector<void*> allocations;
+
+    void* allocate(size_t bytes) {
+        if (bytes == 0) return nullptr;
+        void* memory = nullptr;
+        if (posix_memalign(&memory, 16, bytes) != 0) return nullptr;
+        memset(memory, 0, bytes);
+        allocations.push_back(memory);
+        return memory;
+    }
+
+    ~LoadedPlugin() {
+        for (void* memory : allocations) free(memory);
+        if (handle) dlclose(handle);
+    }
+};
+
+// Same construction sequence as PluginManager, minus the UI plumbing
+bool constructAlgorithm(LoadedPlugin& plugin, std::string& error) {
+    PluginEntryFunc pluginEntry = (PluginEntryFunc)dlsym(plugin.handle, "pluginEntry");
+    if (!pluginEntry || pluginEntry(kNT_selector_numFactories, 0) < 1) {
+        error = "no pluginEntry or factories";
+        return false;
+    }
+    plugin.factory = (_NT_factory*)pluginEntry(kNT_selector_factoryInfo, 0);
+    _NT_factory* factory = plugin.factory;
+    if (!factory || !factory->calculateRequirements || !factory->construct || !factory->draw) {
+        error = "incomplete factory";
+        return false;
+    }
+
+    std::vector<int32_t> specifications;
+    for (uint32_t i = 0; i < factory->numSpecifications; i++) {
+        specifications.push_back(factory->specifications[i].def);
+    }
+    const int32_t* specs = specifications.empty() ? nullptr : specifications.data();
+
+    if (factory->calculateStaticRequirements) {
+        _NT_staticRequirements staticReqs = {};
+        factory->calculateStaticRequirements(staticReqs);
+        _NT_staticMemoryPtrs staticPtrs = {};
+        staticPtrs.dram = (uint8_t*)plugin.allocate(staticReqs.dram);
+        if (factory->initialise) {
+            factory->initialise(staticPtrs, staticReqs);
+        }
+    }
+
+    _NT_algorithmRequirements reqs = {};
+    factory->calculateRequirements(reqs, specs);
+    if (!plugin.memory.allocate(reqs, error)) {
+        return false;
+    }
+
+    plugin.algorithm = factory->construct(plugin.memory.getPointers(), reqs, specs);
+    if (!plugin.algorithm) {
+        error = "construct failed";
+        return false;
+    }
+
+    plugin.values.assign(reqs.numParameters, 0);
+    for (uint32_t i = 0; i < reqs.numParameters && plugin.algorithm->parameters; i++) {
+        plugin.values[i] = plugin.algorithm->parameters[i].def;
+    }
+    plugin.algorithm->v = plugin.values.data();
+    plugin.algorithm->vIncludingCommon = plugin.values.data();
+
+    if (factory->parameterChanged) {
+        for (uint32_t i = 0; i < reqs.numParameters; i++) {
+            factory->parameterChanged(plugin.algorithm, (int)i);
+        }
+    }
+    return true;
+}
+
+// --- Script ----------------------------------------------------------------
+
+bool parseScript(const std::string& path, std::vector<TestCase>& cases) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "Can't open script %s\n", path.c_str());
+        return false;
+    }
+
+    std::string line;
+    for (int lineNumber = 1; std::getline(in, line); lineNumber++) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        TestCase test;
+        test.line = lineNumber;
+        if (!(words >> test.name)) continue;
+        if (!(words >> test.plugin)) {
+            fprintf(stderr, "%s:%d: missing plugin\n", path.c_str(), lineNumber);
+            return false;
+        }
+
+        std::string word;
+        while (words >> word) {
+            size_t equals = word.find('=');
+            std::string key = word.substr(0, equals);
+            std::string value = equals == std::string::npos ? "" : word.substr(equals + 1);
+            if (value.empty()) {
+                fprintf(stderr, "%s:%d: expected key=value, got '%s'\n", path.c_str(), lineNumber, word.c_str());
+                return false;
+            }
+            if (key == "draws") {
+                test.draws = std::max(1, atoi(value.c_str()));
+            } else if (key == "tolerance") {
+                test.tolerance = std::max(0, atoi(value.c_str()));
+            } else if (key == "call") {
+                test.call = value;
+            } else if (!key.empty() && key.find_first_not_of("0123456789") == std::string::npos) {
+                test.parameters.push_back(std::make_pair(atoi(key.c_str()), atoi(value.c_str())));
+            } else {
+                fprintf(stderr, "%s:%d: unknown key '%s'\n", path.c_str(), lineNumber, key.c_str());
+                return false;
+            }
+        }
+        cases.push_back(test);
+    }
+    return true;
+}
+
+// --- Running ---------------------------------------------------------------
+
+std::string goldenPath(const TestCase& test) {
+    std::string dir = g_options.scriptPath.substr(0, g_options.scriptPath.find_last_of('/') + 1);
+    return dir + test.name + ".pgm";
+}
+
+// Draws the case's frames and leaves the last one in context.screen
+bool renderCase(const TestCase& test, NTApiContext& context, std::string& error) {
+    std::string path = g_options.pluginDir + "/" + test.plugin + ".so";
+    LoadedPlugin plugin;
+    plugin.handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!plugin.handle) {
+        error = dlerror();
+        return false;
+    }
+
+    DrawFunc call = nullptr;
+    if (!test.call.empty()) {
+        call = (DrawFunc)dlsym(plugin.handle, test.call.c_str());
+        if (!call) {
+            error = "no symbol " + test.call;
+            return false;
+        }
+    } else {
+        if (!constructAlgorithm(plugin, error)) return false;
+        for (const std::pair<int, int>& parameter : test.parameters) {
+            if (parameter.first < 0 || parameter.first >= (int)plugin.values.size()) {
+                error = "no parameter " + std::to_string(parameter.first);
+                return false;
+            }
+            plugin.values[parameter.first] = (int16_t)parameter.second;
+            if (plugin.factory->parameterChanged) {
+                plugin.factory->parameterChanged(plugin.algorithm, parameter.first);
+            }
+        }
+    }
+
+    // Start each case from a blank screen, as after a plugin load
+    memset(NT_screen, 0, sizeof(NT_screen));
+    for (int i = 0; i < test.draws; i++) {
+        NTApi::beginScreenFrame();
+        if (call) {
+            call();
+        } else {
+            plugin.factory->draw(plugin.algorithm);
+        }
+        NTApi::captureScreen(&context);
+    }
+    return true;
+}
+
+// 0 pass, 1 fail, 2 error
+int runCase(const TestCase& test) {
+    NTApiContext context;
+    context.globals = NT_globals;
+    NTApi::ScopedContext scope(&context);
+
+    std::string error;
+    if (!renderCase(test, context, error)) {
+        printf("  ERROR %-28s %s: %s\n", test.name.c_str(), test.plugin.c_str(), error.c_str());
+        return 2;
+    }
+
+    std::string golden = goldenPath(test);
+    if (g_options.update) {
+        if (!writePgm(golden, context.screen)) {
+            printf("  ERROR %-28s can't write %s\n", test.name.c_str(), golden.c_str());
+            return 2;
+        }
+        printf("  WROTE %-28s %s\n", test.name.c_str(), golden.c_str());
+        return 0;
+    }
+
+    uint8_t expected[SCREEN_BYTES];
+    if (!readPgm(golden, expected)) {
+        printf("  ERROR %-28s no golden %s (run with --update)\n", test.name.c_str(), golden.c_str());
+        return 2;
+    }
+
+    int tolerance = test.tolerance >= 0 ? test.tolerance : g_options.tolerance;
+    int different = countDifferentPixels(context.screen, expected, SCREEN_BYTES);
+    if (different == 0) {
+        printf("  PASS  %s\n", test.name.c_str());
+        return 0;
+    }
+
+    Diff diff = diffFrames(context.screen, expected);
+    mkdir(g_options.outDir.c_str(), 0755);
+    std::string actualPath = g_options.outDir + "/" + test.name + ".actual.pgm";
+    std::string heatmapPath = g_options.outDir + "/" + test.name + ".diff.ppm";
+    bool written = writePgm(actualPath, context.screen) && writeHeatmap(heatmapPath, context.screen, expected);
+
+    bool pass = diff.pixels <= tolerance;
+    printf("  %s  %-28s %d pixels differ (tolerance %d), max delta %d, rows %d-%d\n",
+           pass ? "PASS" : "FAIL", test.name.c_str(), diff.pixels, tolerance, diff.maxDelta,
+           diff.firstRow, diff.lastRow);
+    if (written) {
+        printf("        %s\n        %s\n", actualPath.c_str(), heatmapPath.c_str());
+    } else {
+        printf("        can't write to %s\n", g_options.outDir.c_str());
+    }
+    return pass ? 0 : 1;
+}
+
+bool parseArguments(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--script" && hasValue) {
+            g_options.scriptPath = argv[++i];
+        } else if (arg == "--plugins" && hasValue) {
+            g_options.pluginDir = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            g_options.outDir = argv[++i];
+        } else if (arg == "--tolerance" && hasValue) {
+            g_options.tolerance = std::max(0, atoi(argv[++i]));
+        } else if (arg == "--filter" && hasValue) {
+            g_options.filter = argv[++i];
+        } else if (arg == "--update") {
+            g_options.update = true;
+        } else {
+            fprintf(stderr, "Unknown or incomplete option %s\n", arg.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (!parseArguments(argc, argv)) {
+        fprintf(stderr, "Usage: %s [--script file] [--plugins dir] [--out dir] "
+                        "[--tolerance pixels] [--filter text] [--update]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<TestCase> cases;
+    if (!parseScript(g_options.scriptPath, cases)) return 2;
+
+    auto start = std::chrono::steady_clock::now();
+    int passed = 0, failed = 0, errors = 0;
+    printf("Display golden images (%s)\n", g_options.scriptPath.c_str());
+    for (const TestCase& test : cases) {
+        if (!g_options.filter.empty() && test.name.find(g_options.filter) == std::string::npos) continue;
+        switch (runCase(test)) {
+            case 0: passed++; break;
+            case 1: failed++; break;
+            default: errors++; break;
+        }
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%d passed, %d failed, %d errors in %.0f ms\n", passed, failed, errors, ms);
+    return failed || errors ? 1 : 0;
+}